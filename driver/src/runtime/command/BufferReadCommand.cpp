@@ -1,6 +1,5 @@
-#include <cstring>
-
 #include "Command.h"
+#include "ParallelCopy.h"
 
 BufferReadCommand::BufferReadCommand(CLMem* buffer,
                                      size_t size,
@@ -15,5 +14,5 @@ BufferReadCommand::~BufferReadCommand() {
 }
 
 void BufferReadCommand::execute() const {
-    memcpy(outputPtr, buffer->address + offset, size);
+    parallelCopy(outputPtr, buffer->address + offset, size);
 }
@@ -0,0 +1,47 @@
+#include <algorithm>
+
+#include "Command.h"
+#include "ParallelCopy.h"
+
+BufferRectCommand::BufferRectCommand(cl_command_type type,
+                                     CLMem* source,
+                                     CLMem* destination,
+                                     std::byte* destinationPtr,
+                                     size_t destinationRowPitch,
+                                     size_t destinationSlicePitch,
+                                     const std::byte* sourcePtr,
+                                     size_t sourceRowPitch,
+                                     size_t sourceSlicePitch,
+                                     const size_t* region)
+    : type(type),
+      source(source),
+      destination(destination),
+      destinationPtr(destinationPtr),
+      destinationRowPitch(destinationRowPitch),
+      destinationSlicePitch(destinationSlicePitch),
+      sourcePtr(sourcePtr),
+      sourceRowPitch(sourceRowPitch),
+      sourceSlicePitch(sourceSlicePitch) {
+    std::copy(region, region + 3, this->region.begin());
+    if (source) {
+        clRetainMemObject(source);
+    }
+    if (destination) {
+        clRetainMemObject(destination);
+    }
+}
+
+BufferRectCommand::~BufferRectCommand() {
+    if (source) {
+        clReleaseMemObject(source);
+    }
+    if (destination) {
+        clReleaseMemObject(destination);
+    }
+}
+
+void BufferRectCommand::execute() const {
+    parallelRectCopy(destinationPtr, destinationRowPitch,
+                     destinationSlicePitch, sourcePtr, sourceRowPitch,
+                     sourceSlicePitch, region.data());
+}
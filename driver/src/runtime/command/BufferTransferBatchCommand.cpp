@@ -0,0 +1,115 @@
+#include <algorithm>
+#include <iterator>
+#include <map>
+
+#include "Command.h"
+#include "ParallelCopy.h"
+
+namespace {
+// disjoint byte ranges [first, second) of a buffer, merged on insertion
+using Intervals = std::map<size_t, size_t>;
+
+bool covers(const Intervals& intervals, size_t start, size_t end) {
+    auto next = intervals.upper_bound(start);
+    return next != intervals.begin() && std::prev(next)->second >= end;
+}
+
+void insert(Intervals& intervals, size_t start, size_t end) {
+    auto it = intervals.upper_bound(start);
+    if (it != intervals.begin() && std::prev(it)->second >= start) {
+        --it;
+        start = it->first;
+        end = std::max(end, it->second);
+        it = intervals.erase(it);
+    }
+    while (it != intervals.end() && it->first <= end) {
+        end = std::max(end, it->second);
+        it = intervals.erase(it);
+    }
+    intervals[start] = end;
+}
+
+void eraseOverlapping(Intervals& intervals, size_t start, size_t end) {
+    auto it = intervals.upper_bound(start);
+    if (it != intervals.begin() && std::prev(it)->second > start) {
+        --it;
+    }
+    while (it != intervals.end() && it->first < end) {
+        it = intervals.erase(it);
+    }
+}
+}  // namespace
+
+BufferTransferBatchCommand::BufferTransferBatchCommand(CLMem* buffer)
+    : buffer(buffer) {
+    clRetainMemObject(buffer);
+}
+
+BufferTransferBatchCommand::~BufferTransferBatchCommand() {
+    clReleaseMemObject(buffer);
+}
+
+void BufferTransferBatchCommand::addRead(const BufferReadCommand& command) {
+    segments.push_back({false, command.offset, command.size,
+                        static_cast<std::byte*>(command.outputPtr)});
+}
+
+void BufferTransferBatchCommand::addWrite(const BufferWriteCommand& command) {
+    // never written through, the pointer is only a copy source
+    segments.push_back(
+        {true, command.offset, command.size,
+         const_cast<std::byte*>(
+             static_cast<const std::byte*>(command.dataPtr))});
+}
+
+void BufferTransferBatchCommand::optimize() {
+    // bytes written later in the batch with no read of them in between,
+    // collected walking the segments backwards
+    Intervals overwritten;
+    std::vector<bool> elided(segments.size());
+
+    for (size_t i = segments.size(); i-- > 0;) {
+        const auto& segment = segments[i];
+        const size_t end = segment.offset + segment.size;
+
+        if (!segment.isWrite) {
+            eraseOverlapping(overwritten, segment.offset, end);
+        } else if (covers(overwritten, segment.offset, end)) {
+            elided[i] = true;
+        } else {
+            insert(overwritten, segment.offset, end);
+        }
+    }
+
+    std::vector<Segment> joined;
+    for (size_t i = 0; i < segments.size(); ++i) {
+        const auto& segment = segments[i];
+        if (elided[i]) {
+            continue;
+        }
+
+        if (!joined.empty()) {
+            auto& last = joined.back();
+            if (last.isWrite == segment.isWrite &&
+                last.offset + last.size == segment.offset &&
+                last.hostPtr + last.size == segment.hostPtr) {
+                last.size += segment.size;
+                continue;
+            }
+        }
+        joined.push_back(segment);
+    }
+    segments = std::move(joined);
+}
+
+void BufferTransferBatchCommand::execute() const {
+    for (const auto& segment : segments) {
+        if (segment.isWrite) {
+            parallelCopy(buffer->address + segment.offset, segment.hostPtr,
+                         segment.size);
+        } else {
+            parallelCopy(segment.hostPtr, buffer->address + segment.offset,
+                         segment.size);
+        }
+    }
+}
@@ -1,6 +1,5 @@
-#include <cstring>
-
 #include "Command.h"
+#include "ParallelCopy.h"
 
 BufferWriteCommand::BufferWriteCommand(CLMem* buffer,
                                        size_t size,
@@ -15,5 +14,5 @@ BufferWriteCommand::~BufferWriteCommand() {
 }
 
 void BufferWriteCommand::execute() const {
-    memcpy(buffer->address + offset, dataPtr, size);
+    parallelCopy(buffer->address + offset, dataPtr, size);
 }
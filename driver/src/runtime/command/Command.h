@@ -1,12 +1,24 @@
 #pragma once
 
+#include <array>
 #include <memory>
+#include <optional>
+#include <vector>
 #include "runtime/icd/CLMem.h"
 
+struct KernelArgumentValues;
+
 class Command {
    public:
     virtual ~Command() = default;
     virtual void execute() const = 0;
+
+    /**
+     * @return type reported by the command's event
+     */
+    virtual cl_command_type getType() const {
+        return CL_COMMAND_MARKER;
+    }
 };
 
 struct BufferReadCommand : public Command {
@@ -19,6 +31,10 @@ struct BufferReadCommand : public Command {
 
     void execute() const override;
 
+    cl_command_type getType() const override {
+        return CL_COMMAND_READ_BUFFER;
+    }
+
     CLMem* const buffer;
     const size_t size;
     const size_t offset;
@@ -35,26 +51,266 @@ struct BufferWriteCommand : public Command {
 
     void execute() const override;
 
+    cl_command_type getType() const override {
+        return CL_COMMAND_WRITE_BUFFER;
+    }
+
     CLMem* const buffer;
     const size_t size;
     const size_t offset;
     const void* const dataPtr;
 };
 
+struct FillBufferCommand : public Command {
+    FillBufferCommand(CLMem* buffer,
+                      const void* pattern,
+                      size_t patternSize,
+                      size_t offset,
+                      size_t size);
+
+    ~FillBufferCommand() override;
+
+    void execute() const override;
+
+    cl_command_type getType() const override {
+        return CL_COMMAND_FILL_BUFFER;
+    }
+
+    CLMem* const buffer;
+    // copied, the caller may reuse its pattern right after the enqueue
+    std::array<std::byte, 128> pattern{};
+    const size_t patternSize;
+    const size_t offset;
+    const size_t size;
+};
+
+struct CopyBufferCommand : public Command {
+    CopyBufferCommand(CLMem* source,
+                      CLMem* destination,
+                      size_t sourceOffset,
+                      size_t destinationOffset,
+                      size_t size);
+
+    ~CopyBufferCommand() override;
+
+    void execute() const override;
+
+    cl_command_type getType() const override {
+        return CL_COMMAND_COPY_BUFFER;
+    }
+
+    CLMem* const source;
+    CLMem* const destination;
+    const size_t sourceOffset;
+    const size_t destinationOffset;
+    const size_t size;
+};
+
+/**
+ * Strided copy of a 3D region for the read, write and copy rect calls.
+ * Pointers are already at the region origins.
+ */
+struct BufferRectCommand : public Command {
+    /**
+     * @param source buffer read from, null for host memory
+     * @param destination buffer written to, null for host memory
+     */
+    BufferRectCommand(cl_command_type type,
+                      CLMem* source,
+                      CLMem* destination,
+                      std::byte* destinationPtr,
+                      size_t destinationRowPitch,
+                      size_t destinationSlicePitch,
+                      const std::byte* sourcePtr,
+                      size_t sourceRowPitch,
+                      size_t sourceSlicePitch,
+                      const size_t* region);
+
+    ~BufferRectCommand() override;
+
+    void execute() const override;
+
+    cl_command_type getType() const override {
+        return type;
+    }
+
+    const cl_command_type type;
+    CLMem* const source;
+    CLMem* const destination;
+    std::byte* const destinationPtr;
+    const size_t destinationRowPitch;
+    const size_t destinationSlicePitch;
+    const std::byte* const sourcePtr;
+    const size_t sourceRowPitch;
+    const size_t sourceSlicePitch;
+    std::array<size_t, 3> region{};
+};
+
+/**
+ * Consecutive reads and writes of one buffer executed as a single vectored
+ * copy. The queue builds it from runs of transfers without wait lists.
+ */
+struct BufferTransferBatchCommand : public Command {
+    struct Segment {
+        bool isWrite;
+        size_t offset;
+        size_t size;
+        // destination of reads, source of writes
+        std::byte* hostPtr;
+    };
+
+    explicit BufferTransferBatchCommand(CLMem* buffer);
+
+    ~BufferTransferBatchCommand() override;
+
+    void addRead(const BufferReadCommand& command);
+
+    void addWrite(const BufferWriteCommand& command);
+
+    /**
+     * Drops writes which are overwritten later in the batch before anything
+     * reads them, then joins neighbouring segments of the same direction
+     * which are contiguous both in the buffer and in host memory.
+     */
+    void optimize();
+
+    void execute() const override;
+
+    CLMem* const buffer;
+    std::vector<Segment> segments;
+};
+
+/**
+ * Copy of a region between an image and linear memory for image reads,
+ * writes and copies to or from buffers. The linear pointer is already at
+ * the region origin.
+ */
+struct ImageTransferCommand : public Command {
+    /**
+     * @param type CL_COMMAND_READ_IMAGE or CL_COMMAND_COPY_IMAGE_TO_BUFFER
+     * copy from the image, other types copy to it
+     * @param buffer linear memory object, null for host memory
+     */
+    ImageTransferCommand(cl_command_type type,
+                         CLMem* image,
+                         CLMem* buffer,
+                         std::byte* linearPtr,
+                         size_t rowPitch,
+                         size_t slicePitch,
+                         const size_t* origin,
+                         const size_t* region);
+
+    ~ImageTransferCommand() override;
+
+    void execute() const override;
+
+    cl_command_type getType() const override {
+        return type;
+    }
+
+    const cl_command_type type;
+    CLMem* const image;
+    CLMem* const buffer;
+    std::byte* const linearPtr;
+    const size_t rowPitch;
+    const size_t slicePitch;
+    std::array<size_t, 3> origin{};
+    std::array<size_t, 3> region{};
+};
+
+struct CopyImageCommand : public Command {
+    CopyImageCommand(CLMem* source,
+                     CLMem* destination,
+                     const size_t* sourceOrigin,
+                     const size_t* destinationOrigin,
+                     const size_t* region);
+
+    ~CopyImageCommand() override;
+
+    void execute() const override;
+
+    cl_command_type getType() const override {
+        return CL_COMMAND_COPY_IMAGE;
+    }
+
+    CLMem* const source;
+    CLMem* const destination;
+    std::array<size_t, 3> sourceOrigin{};
+    std::array<size_t, 3> destinationOrigin{};
+    std::array<size_t, 3> region{};
+};
+
+struct FillImageCommand : public Command {
+    FillImageCommand(CLMem* image,
+                     const void* fillColor,
+                     const size_t* origin,
+                     const size_t* region);
+
+    ~FillImageCommand() override;
+
+    void execute() const override;
+
+    cl_command_type getType() const override {
+        return CL_COMMAND_FILL_IMAGE;
+    }
+
+    CLMem* const image;
+    // the color converted to the image format when enqueued
+    std::array<std::byte, 16> texel{};
+    std::array<size_t, 3> origin{};
+    std::array<size_t, 3> region{};
+};
+
+/**
+ * Map or unmap of a memory object. Memory objects live in host memory, so
+ * there is nothing to copy: the command only orders the mapping with the
+ * rest of the queue.
+ */
+struct MapCommand : public Command {
+    MapCommand(CLMem* memory, cl_command_type type);
+
+    ~MapCommand() override;
+
+    void execute() const override {}
+
+    cl_command_type getType() const override {
+        return type;
+    }
+
+    CLMem* const memory;
+    const cl_command_type type;
+};
+
+/**
+ * Launch of a kernel with its arguments and work sizes as they were when it
+ * was enqueued, so the kernel can be changed and enqueued again meanwhile.
+ */
 struct KernelExecutionCommand : public Command {
-    KernelExecutionCommand(CLKernel* kernel,
-                         cl_uint workDim,
-                         const size_t* globalWorkOffset,
-                         const size_t* globalWorkSize,
-                         const size_t* localWorkSize);
+    /**
+     * @param type CL_COMMAND_NDRANGE_KERNEL or CL_COMMAND_TASK
+     */
+    KernelExecutionCommand(cl_command_type type,
+                           CLKernel* kernel,
+                           cl_uint workDim,
+                           const size_t* globalWorkOffset,
+                           const size_t* globalWorkSize,
+                           const size_t* localWorkSize);
 
     ~KernelExecutionCommand() override;
 
     void execute() const override;
 
+    cl_command_type getType() const override {
+        return type;
+    }
+
+    const cl_command_type type;
     CLKernel* const kernel;
+    const std::shared_ptr<const KernelArgumentValues> arguments;
     const cl_uint workDim;
-    const size_t* const globalWorkOffset;
-    const size_t* const globalWorkSize;
-    const size_t* const localWorkSize;
+    // unused dimensions have an offset of 0 and a size of 1
+    std::array<size_t, 3> globalWorkOffset{};
+    std::array<size_t, 3> globalWorkSize{1, 1, 1};
+    // empty if the work-group size is left to the implementation
+    std::optional<std::array<size_t, 3>> localWorkSize;
 };
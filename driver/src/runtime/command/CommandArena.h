@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Per-queue pool of fixed-size blocks for commands and their bookkeeping.
+ * Blocks are carved from chunks and recycled on deallocation, so a chatty
+ * host doesn't go to the global heap for every enqueue. Larger requests
+ * fall back to operator new.
+ */
+class CommandArena {
+   public:
+    static constexpr size_t kBlockSize = 256;
+
+    CommandArena() = default;
+    CommandArena(const CommandArena&) = delete;
+    CommandArena& operator=(const CommandArena&) = delete;
+
+    void* allocate(size_t size) {
+        if (size > kBlockSize) {
+            return ::operator new(size);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (freeBlocks.empty()) {
+            chunks.push_back(std::make_unique<Block[]>(kChunkSize));
+            for (size_t i = 0; i < kChunkSize; ++i) {
+                freeBlocks.push_back(&chunks.back()[i]);
+            }
+        }
+
+        void* block = freeBlocks.back();
+        freeBlocks.pop_back();
+        return block;
+    }
+
+    void deallocate(void* pointer, size_t size) {
+        if (size > kBlockSize) {
+            ::operator delete(pointer);
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        freeBlocks.push_back(pointer);
+    }
+
+   private:
+    using Block = std::aligned_storage_t<kBlockSize, alignof(std::max_align_t)>;
+    static constexpr size_t kChunkSize = 64;
+
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Block[]>> chunks;
+    std::vector<void*> freeBlocks;
+};
+
+/**
+ * Allocator for std::allocate_shared. Keeps the arena alive while any
+ * object allocated from it is, so commands may outlive their queue.
+ */
+template <typename T>
+class ArenaAllocator {
+   public:
+    using value_type = T;
+
+    explicit ArenaAllocator(std::shared_ptr<CommandArena> arena)
+        : arena(std::move(arena)) {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other)  // NOLINT
+        : arena(other.arena) {}
+
+    T* allocate(size_t count) {
+        static_assert(alignof(T) <= alignof(std::max_align_t),
+                      "Over-aligned types are not supported by the arena");
+        return static_cast<T*>(arena->allocate(count * sizeof(T)));
+    }
+
+    void deallocate(T* pointer, size_t count) {
+        arena->deallocate(pointer, count * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const {
+        return arena == other.arena;
+    }
+
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const {
+        return arena != other.arena;
+    }
+
+   private:
+    template <typename U>
+    friend class ArenaAllocator;
+
+    std::shared_ptr<CommandArena> arena;
+};
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+/**
+ * Bounded lock-free multi-producer single-consumer ring (Vyukov's bounded
+ * queue). Every push gets a ticket that defines the global submission order,
+ * the consumer pops items strictly in ticket order.
+ */
+template <typename T>
+class CommandRing {
+   public:
+    explicit CommandRing(size_t capacity = 1024)
+        : capacity(roundUpToPowerOfTwo(capacity)),
+          cells(std::make_unique<Cell[]>(this->capacity)) {
+        for (size_t i = 0; i < this->capacity; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @return ticket of the pushed item or empty optional if the ring is full
+     */
+    std::optional<uint64_t> tryPush(T value) {
+        uint64_t position = enqueuePosition.load(std::memory_order_relaxed);
+
+        while (true) {
+            Cell& cell = cells[position & (capacity - 1)];
+            const uint64_t sequence =
+                cell.sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<int64_t>(sequence - position);
+
+            if (difference == 0) {
+                if (enqueuePosition.compare_exchange_weak(
+                        position, position + 1, std::memory_order_relaxed)) {
+                    cell.value = std::move(value);
+                    cell.sequence.store(position + 1,
+                                        std::memory_order_release);
+                    return position;
+                }
+            } else if (difference < 0) {
+                return std::nullopt;
+            } else {
+                position = enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * Must only be called by the consumer.
+     * @return next item or empty optional if it is not published yet
+     */
+    std::optional<T> tryPop() {
+        Cell& cell = cells[dequeuePosition & (capacity - 1)];
+        const uint64_t sequence = cell.sequence.load(std::memory_order_acquire);
+
+        if (sequence != dequeuePosition + 1) {
+            return std::nullopt;
+        }
+
+        std::optional<T> result = std::move(cell.value);
+        cell.value = T();
+        cell.sequence.store(dequeuePosition + capacity,
+                            std::memory_order_release);
+        dequeuePosition++;
+        return result;
+    }
+
+    /**
+     * @return number of tickets handed out so far
+     */
+    uint64_t pushedCount() const {
+        return enqueuePosition.load(std::memory_order_acquire);
+    }
+
+   private:
+    struct Cell {
+        std::atomic<uint64_t> sequence;
+        T value;
+    };
+
+    static size_t roundUpToPowerOfTwo(size_t value) {
+        size_t result = 1;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    const size_t capacity;
+    std::unique_ptr<Cell[]> cells;
+    alignas(64) std::atomic<uint64_t> enqueuePosition{0};
+    alignas(64) uint64_t dequeuePosition = 0;
+};
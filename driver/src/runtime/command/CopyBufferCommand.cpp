@@ -0,0 +1,26 @@
+#include "Command.h"
+#include "ParallelCopy.h"
+
+CopyBufferCommand::CopyBufferCommand(CLMem* source,
+                                     CLMem* destination,
+                                     size_t sourceOffset,
+                                     size_t destinationOffset,
+                                     size_t size)
+    : source(source),
+      destination(destination),
+      sourceOffset(sourceOffset),
+      destinationOffset(destinationOffset),
+      size(size) {
+    clRetainMemObject(source);
+    clRetainMemObject(destination);
+}
+
+CopyBufferCommand::~CopyBufferCommand() {
+    clReleaseMemObject(source);
+    clReleaseMemObject(destination);
+}
+
+void CopyBufferCommand::execute() const {
+    parallelCopy(destination->address + destinationOffset,
+                 source->address + sourceOffset, size);
+}
@@ -0,0 +1,29 @@
+#include <algorithm>
+
+#include "Command.h"
+
+CopyImageCommand::CopyImageCommand(CLMem* source,
+                                   CLMem* destination,
+                                   const size_t* sourceOrigin,
+                                   const size_t* destinationOrigin,
+                                   const size_t* region)
+    : source(source), destination(destination) {
+    std::copy(sourceOrigin, sourceOrigin + 3, this->sourceOrigin.begin());
+    std::copy(destinationOrigin, destinationOrigin + 3,
+              this->destinationOrigin.begin());
+    std::copy(region, region + 3, this->region.begin());
+    clRetainMemObject(source);
+    clRetainMemObject(destination);
+}
+
+CopyImageCommand::~CopyImageCommand() {
+    clReleaseMemObject(source);
+    clReleaseMemObject(destination);
+}
+
+void CopyImageCommand::execute() const {
+    ImageLayout::copy(source->image->layout, source->address,
+                      sourceOrigin.data(), destination->image->layout,
+                      destination->address, destinationOrigin.data(),
+                      region.data());
+}
@@ -0,0 +1,22 @@
+#include <cstring>
+
+#include "Command.h"
+#include "ParallelCopy.h"
+
+FillBufferCommand::FillBufferCommand(CLMem* buffer,
+                                     const void* pattern,
+                                     size_t patternSize,
+                                     size_t offset,
+                                     size_t size)
+    : buffer(buffer), patternSize(patternSize), offset(offset), size(size) {
+    memcpy(this->pattern.data(), pattern, patternSize);
+    clRetainMemObject(buffer);
+}
+
+FillBufferCommand::~FillBufferCommand() {
+    clReleaseMemObject(buffer);
+}
+
+void FillBufferCommand::execute() const {
+    parallelFill(buffer->address + offset, size, pattern.data(), patternSize);
+}
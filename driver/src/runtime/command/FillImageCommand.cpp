@@ -0,0 +1,24 @@
+#include <algorithm>
+
+#include "Command.h"
+#include "runtime/memory/ImageFormat.h"
+
+FillImageCommand::FillImageCommand(CLMem* image,
+                                   const void* fillColor,
+                                   const size_t* origin,
+                                   const size_t* region)
+    : image(image) {
+    packImageColor(image->image->format, fillColor, texel.data());
+    std::copy(origin, origin + 3, this->origin.begin());
+    std::copy(region, region + 3, this->region.begin());
+    clRetainMemObject(image);
+}
+
+FillImageCommand::~FillImageCommand() {
+    clReleaseMemObject(image);
+}
+
+void FillImageCommand::execute() const {
+    image->image->layout.fill(image->address, texel.data(), origin.data(),
+                              region.data());
+}
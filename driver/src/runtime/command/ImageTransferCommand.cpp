@@ -0,0 +1,44 @@
+#include <algorithm>
+
+#include "Command.h"
+
+ImageTransferCommand::ImageTransferCommand(cl_command_type type,
+                                           CLMem* image,
+                                           CLMem* buffer,
+                                           std::byte* linearPtr,
+                                           size_t rowPitch,
+                                           size_t slicePitch,
+                                           const size_t* origin,
+                                           const size_t* region)
+    : type(type),
+      image(image),
+      buffer(buffer),
+      linearPtr(linearPtr),
+      rowPitch(rowPitch),
+      slicePitch(slicePitch) {
+    std::copy(origin, origin + 3, this->origin.begin());
+    std::copy(region, region + 3, this->region.begin());
+    clRetainMemObject(image);
+    if (buffer) {
+        clRetainMemObject(buffer);
+    }
+}
+
+ImageTransferCommand::~ImageTransferCommand() {
+    clReleaseMemObject(image);
+    if (buffer) {
+        clReleaseMemObject(buffer);
+    }
+}
+
+void ImageTransferCommand::execute() const {
+    const auto& layout = image->image->layout;
+    if (type == CL_COMMAND_READ_IMAGE ||
+        type == CL_COMMAND_COPY_IMAGE_TO_BUFFER) {
+        layout.copyToLinear(linearPtr, image->address, origin.data(),
+                            region.data(), rowPitch, slicePitch);
+    } else {
+        layout.copyFromLinear(image->address, linearPtr, origin.data(),
+                              region.data(), rowPitch, slicePitch);
+    }
+}
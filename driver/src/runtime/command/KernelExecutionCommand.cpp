@@ -1,35 +1,57 @@
 #include <runtime-commons.h>
+#include <algorithm>
 #include <cstring>
 #include "Command.h"
 #include "runtime/icd/kernel/CLKernel.h"
 
-KernelExecutionCommand::KernelExecutionCommand(CLKernel* kernel,
+KernelExecutionCommand::KernelExecutionCommand(cl_command_type type,
+                                               CLKernel* kernel,
                                                cl_uint workDim,
                                                const size_t* globalWorkOffset,
                                                const size_t* globalWorkSize,
                                                const size_t* localWorkSize)
-    : kernel(kernel),
-      workDim(workDim),
-      globalWorkOffset(globalWorkOffset),
-      globalWorkSize(globalWorkSize),
-      localWorkSize(localWorkSize) {
+    : type(type),
+      kernel(kernel),
+      arguments(kernel->snapshotArguments()),
+      workDim(workDim) {
+    if (globalWorkOffset) {
+        std::copy(globalWorkOffset, globalWorkOffset + workDim,
+                  this->globalWorkOffset.begin());
+    }
+    std::copy(globalWorkSize, globalWorkSize + workDim,
+              this->globalWorkSize.begin());
+    if (localWorkSize) {
+        this->localWorkSize = std::array<size_t, 3>{1, 1, 1};
+        std::copy(localWorkSize, localWorkSize + workDim,
+                  this->localWorkSize->begin());
+    }
+
     clRetainKernel(kernel);
+    // buffers set as arguments stay alive until the launch is done
+    for (const auto& arg : arguments->arguments) {
+        if (arg.memory) {
+            clRetainMemObject(arg.memory);
+        }
+    }
 }
 
 KernelExecutionCommand::~KernelExecutionCommand() {
+    for (const auto& arg : arguments->arguments) {
+        if (arg.memory) {
+            clReleaseMemObject(arg.memory);
+        }
+    }
     clReleaseKernel(kernel);
 }
 
 void KernelExecutionCommand::execute() const {
-    for (const auto& arg : kernel->getArguments()) {
-        if (std::holds_alternative<CLMem*>(arg.value.value().value)) {
-            const auto argInfo =
-                std::dynamic_pointer_cast<PointerKernelArgumentInfo>(arg.info);
-            const auto argValue = std::get<CLMem*>(arg.value.value().value);
-            if (argInfo->accessQualifier == CL_KERNEL_ARG_ACCESS_READ_WRITE ||
-                argInfo->accessQualifier == CL_KERNEL_ARG_ACCESS_WRITE_ONLY) {
-                memset(argValue->address, 0, argValue->size);
-            }
+    for (const auto& arg : arguments->arguments) {
+        const auto* argInfo =
+            dynamic_cast<const PointerKernelArgumentInfo*>(arg.info.get());
+        if (arg.memory && argInfo &&
+            (argInfo->accessQualifier == CL_KERNEL_ARG_ACCESS_READ_WRITE ||
+             argInfo->accessQualifier == CL_KERNEL_ARG_ACCESS_WRITE_ONLY)) {
+            memset(arg.memory->address, 0, arg.memory->size);
         }
     }
 }
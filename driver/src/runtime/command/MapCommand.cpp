@@ -0,0 +1,10 @@
+#include "Command.h"
+
+MapCommand::MapCommand(CLMem* memory, cl_command_type type)
+    : memory(memory), type(type) {
+    clRetainMemObject(memory);
+}
+
+MapCommand::~MapCommand() {
+    clReleaseMemObject(memory);
+}
@@ -0,0 +1,204 @@
+#include "ParallelCopy.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <runtime-commons.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace {
+constexpr size_t kParallelThreshold = 4 * 1024 * 1024;
+constexpr size_t kChunkSize = 1024 * 1024;
+constexpr size_t kMaxHelpers = 4;
+// every supported pattern size divides it
+constexpr size_t kPatternBlockSize = 128;
+
+struct ChunkedTask {
+    size_t size;
+    size_t chunkSize;
+    size_t chunkCount;
+    std::function<void(size_t offset, size_t length)> body;
+
+    std::atomic<size_t> nextChunk{0};
+    std::atomic<size_t> completedChunks{0};
+    std::mutex mutex;
+    std::condition_variable done;
+
+    void runChunks() {
+        size_t chunk;
+        while ((chunk = nextChunk.fetch_add(1)) < chunkCount) {
+            const size_t offset = chunk * chunkSize;
+            body(offset, std::min(chunkSize, size - offset));
+
+            if (completedChunks.fetch_add(1) + 1 == chunkCount) {
+                std::lock_guard<std::mutex> lock(mutex);
+                done.notify_all();
+            }
+        }
+    }
+};
+
+/**
+ * @param block kPatternBlockSize bytes of the pattern repeated from its
+ * first byte
+ * @param streaming use non-temporal stores, so a large fill doesn't evict
+ * the whole cache
+ */
+void fillFromBlock(std::byte* destination,
+                   size_t size,
+                   const std::byte* block,
+                   bool streaming) {
+#ifdef __SSE2__
+    if (streaming) {
+        const size_t misalignment =
+            reinterpret_cast<uintptr_t>(destination) % 16;
+        const size_t head = std::min(size, (16 - misalignment) % 16);
+        memcpy(destination, block, head);
+        destination += head;
+        size -= head;
+
+        // the block is periodic, so rotating it keeps the pattern going
+        // from the aligned address
+        alignas(16) std::byte rotated[kPatternBlockSize];
+        for (size_t i = 0; i < kPatternBlockSize; ++i) {
+            rotated[i] = block[(i + head) % kPatternBlockSize];
+        }
+
+        const auto* source = reinterpret_cast<const __m128i*>(rotated);
+        for (; size >= kPatternBlockSize; size -= kPatternBlockSize) {
+            auto* target = reinterpret_cast<__m128i*>(destination);
+            for (size_t i = 0; i < kPatternBlockSize / 16; ++i) {
+                _mm_stream_si128(target + i, _mm_load_si128(source + i));
+            }
+            destination += kPatternBlockSize;
+        }
+        memcpy(destination, rotated, size);
+        _mm_sfence();
+        return;
+    }
+#endif
+
+    for (; size >= kPatternBlockSize; size -= kPatternBlockSize) {
+        memcpy(destination, block, kPatternBlockSize);
+        destination += kPatternBlockSize;
+    }
+    memcpy(destination, block, size);
+}
+}  // namespace
+
+void runInChunks(size_t size,
+                 size_t chunkSize,
+                 std::function<void(size_t offset, size_t length)> body) {
+    auto task = std::make_shared<ChunkedTask>();
+    task->size = size;
+    task->chunkSize = chunkSize;
+    task->chunkCount = (size + chunkSize - 1) / chunkSize;
+    task->body = std::move(body);
+
+    const size_t helpers = std::min(kMaxHelpers, task->chunkCount - 1);
+    for (size_t i = 0; i < helpers; ++i) {
+        // a helper which starts late finds no chunks left and returns
+        kWorkerPool.submit([task]() { task->runChunks(); });
+    }
+    task->runChunks();
+
+    // only chunks already taken by running helpers are left
+    std::unique_lock<std::mutex> lock(task->mutex);
+    task->done.wait(lock, [&task]() {
+        return task->completedChunks.load() == task->chunkCount;
+    });
+}
+
+void parallelCopy(void* destination, const void* source, size_t size) {
+    if (size < kParallelThreshold) {
+        memcpy(destination, source, size);
+        return;
+    }
+
+    auto* target = static_cast<std::byte*>(destination);
+    const auto* origin = static_cast<const std::byte*>(source);
+    runInChunks(size, kChunkSize,
+                [target, origin](size_t offset, size_t length) {
+                    memcpy(target + offset, origin + offset, length);
+                });
+}
+
+void parallelFill(void* destination,
+                  size_t size,
+                  const void* pattern,
+                  size_t patternSize) {
+    alignas(16) std::byte block[kPatternBlockSize];
+    for (size_t i = 0; i < kPatternBlockSize; ++i) {
+        block[i] = static_cast<const std::byte*>(pattern)[i % patternSize];
+    }
+
+    auto* target = static_cast<std::byte*>(destination);
+    if (size < kParallelThreshold) {
+        fillFromBlock(target, size, block, false);
+        return;
+    }
+
+    // chunks start at multiples of the block size, so each of them starts
+    // with the first byte of the pattern
+    runInChunks(size, kChunkSize,
+                [target, &block](size_t offset, size_t length) {
+                    fillFromBlock(target + offset, length, block, true);
+                });
+}
+
+void parallelRectCopy(void* destination,
+                      size_t destinationRowPitch,
+                      size_t destinationSlicePitch,
+                      const void* source,
+                      size_t sourceRowPitch,
+                      size_t sourceSlicePitch,
+                      const size_t* region) {
+    auto* target = static_cast<std::byte*>(destination);
+    const auto* origin = static_cast<const std::byte*>(source);
+
+    size_t rowSize = region[0];
+    size_t rowCount = region[1];
+    size_t sliceCount = region[2];
+
+    // rows packed on both sides are one long row, packed slices are one
+    // long slice
+    if (sourceRowPitch == rowSize && destinationRowPitch == rowSize) {
+        rowSize *= rowCount;
+        rowCount = 1;
+        if (sourceSlicePitch == rowSize && destinationSlicePitch == rowSize) {
+            rowSize *= sliceCount;
+            sliceCount = 1;
+        }
+    }
+
+    if (rowCount == 1 && sliceCount == 1) {
+        parallelCopy(target, origin, rowSize);
+        return;
+    }
+
+    const auto copyRows = [=](size_t firstRow, size_t count) {
+        for (size_t row = firstRow; row < firstRow + count; ++row) {
+            const size_t y = row % rowCount;
+            const size_t z = row / rowCount;
+            memcpy(target + z * destinationSlicePitch + y * destinationRowPitch,
+                   origin + z * sourceSlicePitch + y * sourceRowPitch, rowSize);
+        }
+    };
+
+    const size_t totalRows = rowCount * sliceCount;
+    if (rowSize * totalRows < kParallelThreshold) {
+        copyRows(0, totalRows);
+        return;
+    }
+
+    runInChunks(totalRows, std::max<size_t>(1, kChunkSize / rowSize),
+                copyRows);
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+/**
+ * Splits the range into chunks processed by the calling thread and up to
+ * four workers of the runtime pool, which take chunks as they finish
+ * previous ones. Returns once every chunk is processed.
+ */
+void runInChunks(size_t size,
+                 size_t chunkSize,
+                 std::function<void(size_t offset, size_t length)> body);
+
+/**
+ * memcpy which splits large copies into chunks shared between the calling
+ * thread and the runtime worker pool. The caller takes part in the copy, so
+ * it is safe to call from a worker thread.
+ */
+void parallelCopy(void* destination, const void* source, size_t size);
+
+/**
+ * Repeats the pattern over the destination, splitting large fills the same
+ * way as parallelCopy. Large fills use non-temporal stores where available.
+ *
+ * @param patternSize power of two up to 128, divides size
+ */
+void parallelFill(void* destination,
+                  size_t size,
+                  const void* pattern,
+                  size_t patternSize);
+
+/**
+ * Copies a 3D region between strided layouts, with pointers already at the
+ * region origins. Rows and slices which are packed on both sides are joined
+ * into longer copies, large regions are split by rows across the worker
+ * pool.
+ *
+ * @param region width in bytes, height in rows and depth in slices
+ */
+void parallelRectCopy(void* destination,
+                      size_t destinationRowPitch,
+                      size_t destinationSlicePitch,
+                      const void* source,
+                      size_t sourceRowPitch,
+                      size_t sourceSlicePitch,
+                      const size_t* region);
@@ -0,0 +1,48 @@
+#include "WorkerPool.h"
+
+#include <algorithm>
+
+WorkerPool::WorkerPool(size_t threadCount)
+    : threadCount(std::max<size_t>(threadCount, 1)) {}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    condition.notify_all();
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+void WorkerPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (threads.empty()) {
+            for (size_t i = 0; i < threadCount; ++i) {
+                threads.emplace_back(&WorkerPool::work, this);
+            }
+        }
+        tasks.push(std::move(task));
+    }
+    condition.notify_one();
+}
+
+void WorkerPool::work() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock,
+                           [this]() { return stopping || !tasks.empty(); });
+            if (tasks.empty()) {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop();
+        }
+        task();
+    }
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+/**
+ * Pool of host threads running runtime tasks: commands of out-of-order
+ * queues and event callbacks. Threads are started on the first submitted
+ * task.
+ */
+class WorkerPool {
+   public:
+    /**
+     * By default there are at least two threads so an independent command,
+     * e.g. a read, can overlap a long kernel even on a single-core host.
+     */
+    explicit WorkerPool(size_t threadCount = std::max(
+                            std::thread::hardware_concurrency(), 2u));
+
+    ~WorkerPool();
+
+    void submit(std::function<void()> task);
+
+   private:
+    const size_t threadCount;
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::queue<std::function<void()>> tasks;
+    std::vector<std::thread> threads;
+    bool stopping = false;
+
+    void work();
+};
@@ -8,6 +8,7 @@
 #include "DeviceConfigurationParser.h"
 #include "common/utils/common.hpp"
 #include "runtime/icd/CLPlatformId.hpp"
+#include "runtime/program/ProgramCache.h"
 #include "runtime/runtime-commons.h"
 
 template <typename T>
@@ -54,12 +55,16 @@ void DeviceConfigurationParser::load(const std::string& configurationFilePath) {
 
     std::unordered_map<cl_device_info, CLObjectInfoParameterValue> parameters;
     std::string line;
+    uint64_t fingerprint = ProgramCache::kHashSeed;
 
     while (getline(configurationFile, line)) {
         if (line.empty() || line[0] == '#' || line[0] == ';') {
             continue;
         }
 
+        line.push_back('\n');
+        fingerprint = ProgramCache::hash(line.data(), line.size(), fingerprint);
+
         const auto [parameterName, parameterValue] = utils::splitTwo(line, '=');
         const auto parsedParameter = parseParameter(
             utils::trim(parameterName), utils::trim(parameterValue));
@@ -107,11 +112,16 @@ void DeviceConfigurationParser::load(const std::string& configurationFilePath) {
                       (void*) false, sizeof(cl_bool));
 
     mConfigurationPath = configurationFilePath;
+    mFingerprint = fingerprint;
     // TODO: memory leak of arrays
     mParameters.clear();
     mParameters = parameters;
 }
 
+uint64_t DeviceConfigurationParser::fingerprint() const {
+    return mFingerprint;
+}
+
 std::optional<CLObjectInfoParameterValue>
 DeviceConfigurationParser::getParameter(cl_device_info parameter) const {
     if (mParameters.find(parameter) != mParameters.end()) {
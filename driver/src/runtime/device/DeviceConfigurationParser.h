@@ -1,6 +1,7 @@
 #pragma once
 
 #include <CL/opencl.h>
+#include <cstdint>
 #include <map>
 #include <optional>
 #include <stdexcept>
@@ -21,6 +22,12 @@ class DeviceConfigurationParser {
     template <class T>
     T requireParameter(cl_device_info parameter) const;
 
+    /**
+     * Hash of the loaded configuration, changes whenever any of its
+     * parameters does.
+     */
+    [[nodiscard]] uint64_t fingerprint() const;
+
    private:
     struct ParsedParameter {
         ParsedParameter(cl_device_info name, CLObjectInfoParameterValue value)
@@ -31,6 +38,7 @@ class DeviceConfigurationParser {
     };
 
     std::string mConfigurationPath;
+    uint64_t mFingerprint = 0;
     std::unordered_map<cl_device_info, CLObjectInfoParameterValue> mParameters;
 
     static ParsedParameter parseParameter(const std::string& parameterName,
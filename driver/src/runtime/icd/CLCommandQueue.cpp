@@ -1,4 +1,6 @@
 #include "CLCommandQueue.h"
+
+#include <algorithm>
 #include <runtime-commons.h>
 
 CLCommandQueue::CLCommandQueue(IcdDispatchTable* dispatchTable,
@@ -6,32 +8,370 @@ CLCommandQueue::CLCommandQueue(IcdDispatchTable* dispatchTable,
                                cl_command_queue_properties properties)
     : dispatchTable(dispatchTable), context(context), properties(properties) {
     clRetainContext(context);
+    executor = std::thread(&CLCommandQueue::executeCommands, this);
 }
 
 CLCommandQueue::~CLCommandQueue() {
+    finish();
+
+    {
+        std::lock_guard<std::mutex> lock(executorMutex);
+        stopping = true;
+    }
+    executorCondition.notify_one();
+    executor.join();
+
     clReleaseContext(context);
 }
 
 void CLCommandQueue::enqueue(const std::shared_ptr<const Command>& command) {
-    commands.emplace(command);
+    enqueue(command, 0, nullptr, nullptr);
+}
+
+void CLCommandQueue::enqueue(const std::shared_ptr<const Command>& command,
+                             cl_uint numEventsInWaitList,
+                             const cl_event* eventWaitList,
+                             cl_event* event) {
+    auto queued = makeCommand<QueuedCommand>();
+    queued->command = command;
+    push(queued, command->getType(), numEventsInWaitList, eventWaitList,
+         event);
+}
+
+cl_int CLCommandQueue::enqueue(const std::shared_ptr<const Command>& command,
+                               bool blocking,
+                               cl_uint numEventsInWaitList,
+                               const cl_event* eventWaitList,
+                               cl_event* event) {
+    if (!blocking) {
+        enqueue(command, numEventsInWaitList, eventWaitList, event);
+        return CL_SUCCESS;
+    }
+
+    cl_event commandEvent;
+    enqueue(command, numEventsInWaitList, eventWaitList, &commandEvent);
+    flush();
+    commandEvent->wait();
+
+    const bool failed = commandEvent->getStatus() < CL_COMPLETE;
+    if (event) {
+        *event = commandEvent;
+    } else {
+        commandEvent->release();
+    }
+
+    return failed ? CL_EXEC_STATUS_ERROR_FOR_EVENTS_IN_WAIT_LIST
+                  : CL_SUCCESS;
+}
+
+cl_int CLCommandQueue::enqueueMap(CLMem* memory,
+                                  cl_command_type type,
+                                  bool blocking,
+                                  cl_uint numEventsInWaitList,
+                                  const cl_event* eventWaitList,
+                                  cl_event* event) {
+    if (numEventsInWaitList == 0 && size() == 0) {
+        if (event) {
+            *event = CLEvent::create(dispatchTable, context, this, type,
+                                     CL_COMPLETE);
+        }
+        return CL_SUCCESS;
+    }
+
+    return enqueue(makeCommand<MapCommand>(memory, type), blocking,
+                   numEventsInWaitList, eventWaitList, event);
+}
+
+void CLCommandQueue::enqueueMarker(cl_uint numEventsInWaitList,
+                                   const cl_event* eventWaitList,
+                                   cl_event* event) {
+    auto queued = makeCommand<QueuedCommand>();
+    queued->waitsForAll = numEventsInWaitList == 0;
+    push(queued, CL_COMMAND_MARKER, numEventsInWaitList, eventWaitList, event);
+}
+
+void CLCommandQueue::enqueueBarrier(cl_uint numEventsInWaitList,
+                                    const cl_event* eventWaitList,
+                                    cl_event* event) {
+    auto queued = makeCommand<QueuedCommand>();
+    queued->waitsForAll = numEventsInWaitList == 0;
+    queued->isBarrier = true;
+    push(queued, CL_COMMAND_BARRIER, numEventsInWaitList, eventWaitList,
+         event);
+}
+
+CLEvent* CLCommandQueue::push(std::shared_ptr<QueuedCommand> queued,
+                              cl_command_type type,
+                              cl_uint numEventsInWaitList,
+                              const cl_event* eventWaitList,
+                              cl_event* event) {
+    queued->event = CLEvent::create(dispatchTable, context, this, type);
+    if (event) {
+        queued->event->retain();
+        *event = queued->event;
+    }
+
+    queued->waitList.reserve(numEventsInWaitList);
+    for (cl_uint i = 0; i < numEventsInWaitList; ++i) {
+        eventWaitList[i]->retain();
+        queued->waitList.push_back(eventWaitList[i]);
+    }
+
+    CLEvent* const result = queued->event;
+    while (!commands.tryPush(queued)) {
+        // ring is full: let the executor drain it, as if clFlush was called
+        flush();
+        std::this_thread::yield();
+    }
+    return result;
 }
 
 void CLCommandQueue::flush() {
-    if (flushInProcess) {
+    {
+        std::lock_guard<std::mutex> lock(executorMutex);
+        flushedCount = std::max(flushedCount, commands.pushedCount());
+    }
+    executorCondition.notify_one();
+}
+
+void CLCommandQueue::finish() {
+    // a command can't wait for the queue it is running on
+    if (std::this_thread::get_id() == executor.get_id()) {
         return;
     }
 
-    flushInProcess = true;
+    cl_event marker;
+    enqueueMarker(0, nullptr, &marker);
+    flush();
 
-    while (!commands.empty()) {
-        const auto command = commands.front();
-        command->execute();
-        commands.pop();
+    marker->wait();
+    marker->release();
+}
+
+size_t CLCommandQueue::size() {
+    return commands.pushedCount() -
+           completedCount.load(std::memory_order_acquire);
+}
+
+void CLCommandQueue::executeCommands() {
+    uint64_t dispatchedCount = 0;
+    Batch batch;
+
+    while (true) {
+        uint64_t target;
+        {
+            std::unique_lock<std::mutex> lock(executorMutex);
+            executorCondition.wait(lock, [this, dispatchedCount]() {
+                return stopping || flushedCount > dispatchedCount;
+            });
+            if (flushedCount == dispatchedCount) {
+                break;
+            }
+            target = flushedCount;
+        }
+
+        while (dispatchedCount < target) {
+            auto queued = commands.tryPop();
+            if (!queued) {
+                // ticket is taken but the producer hasn't published it yet
+                std::this_thread::yield();
+                continue;
+            }
+            batch.push_back(std::move(queued.value()));
+            dispatchedCount++;
+        }
+
+        for (const auto& queued : coalesceTransfers(std::move(batch))) {
+            if (isOutOfOrder()) {
+                dispatchOutOfOrder(queued);
+            } else {
+                dispatchInOrder(queued);
+            }
+        }
+        batch.clear();
     }
 
-    flushInProcess = false;
+    for (auto event : inFlight) {
+        event->release();
+    }
+    if (lastBarrier) {
+        lastBarrier->release();
+    }
 }
 
-size_t CLCommandQueue::size() {
-    return commands.size();
+namespace {
+CLMem* getTransferBuffer(const Command* command) {
+    if (const auto read = dynamic_cast<const BufferReadCommand*>(command)) {
+        return read->buffer;
+    }
+    if (const auto write = dynamic_cast<const BufferWriteCommand*>(command)) {
+        return write->buffer;
+    }
+    return nullptr;
+}
+}  // namespace
+
+CLCommandQueue::Batch CLCommandQueue::coalesceTransfers(Batch batch) {
+    const auto transferBuffer = [](const std::shared_ptr<QueuedCommand>& q) {
+        return q->waitList.empty() ? getTransferBuffer(q->command.get())
+                                   : nullptr;
+    };
+
+    Batch result;
+    result.reserve(batch.size());
+
+    for (size_t start = 0; start < batch.size();) {
+        CLMem* const buffer = transferBuffer(batch[start]);
+        size_t end = start + 1;
+        while (buffer && end < batch.size() &&
+               transferBuffer(batch[end]) == buffer) {
+            end++;
+        }
+
+        if (end - start < 2) {
+            result.push_back(std::move(batch[start]));
+            start = end;
+            continue;
+        }
+
+        auto transfers = makeCommand<BufferTransferBatchCommand>(buffer);
+        // the last command carries the batch, so events still complete in
+        // submission order
+        auto& merged = batch[end - 1];
+        for (size_t i = start; i < end; ++i) {
+            const Command* command = batch[i]->command.get();
+            if (const auto read =
+                    dynamic_cast<const BufferReadCommand*>(command)) {
+                transfers->addRead(*read);
+            } else {
+                transfers->addWrite(
+                    *dynamic_cast<const BufferWriteCommand*>(command));
+            }
+            if (i != end - 1) {
+                merged->coalescedEvents.push_back(batch[i]->event);
+            }
+        }
+        transfers->optimize();
+
+        merged->command = std::move(transfers);
+        result.push_back(std::move(merged));
+        start = end;
+    }
+
+    return result;
+}
+
+void CLCommandQueue::dispatchInOrder(
+    const std::shared_ptr<QueuedCommand>& queued) {
+    // previous commands of the queue are complete already, only events of
+    // other queues and user events can still be pending
+    queued->event->setStatus(CL_SUBMITTED);
+    for (auto coalesced : queued->coalescedEvents) {
+        coalesced->setStatus(CL_SUBMITTED);
+    }
+    for (auto dependency : queued->waitList) {
+        dependency->wait();
+    }
+    run(queued, completedCount);
+}
+
+void CLCommandQueue::dispatchOutOfOrder(
+    const std::shared_ptr<QueuedCommand>& queued) {
+    queued->event->setStatus(CL_SUBMITTED);
+    for (auto coalesced : queued->coalescedEvents) {
+        coalesced->setStatus(CL_SUBMITTED);
+    }
+
+    std::vector<CLEvent*> dependencies = queued->waitList;
+    if (lastBarrier) {
+        dependencies.push_back(lastBarrier);
+    }
+    if (queued->waitsForAll) {
+        dependencies.insert(dependencies.end(), inFlight.begin(),
+                            inFlight.end());
+    }
+
+    queued->event->retain();
+    inFlight.push_back(queued->event);
+    if (queued->isBarrier) {
+        queued->event->retain();
+        if (lastBarrier) {
+            lastBarrier->release();
+        }
+        lastBarrier = queued->event;
+    }
+
+    // one extra count keeps the command from starting before every
+    // continuation is registered
+    auto pending = std::make_shared<std::atomic<size_t>>(
+        dependencies.size() + 1);
+    auto* counter = &completedCount;
+    auto resolve = [queued, pending, counter]() {
+        if (pending->fetch_sub(1, std::memory_order_acq_rel) != 1) {
+            return;
+        }
+        if (queued->command) {
+            kWorkerPool.submit([queued, counter]() { run(queued, *counter); });
+        } else {
+            run(queued, *counter);
+        }
+    };
+
+    for (auto dependency : dependencies) {
+        if (!dependency->whenComplete(resolve)) {
+            resolve();
+        }
+    }
+    resolve();
+
+    if (inFlight.size() >= inFlightPruneThreshold) {
+        const auto completed =
+            std::partition(inFlight.begin(), inFlight.end(),
+                           [](CLEvent* event) { return !event->isComplete(); });
+        std::for_each(completed, inFlight.end(),
+                      [](CLEvent* event) { event->release(); });
+        inFlight.erase(completed, inFlight.end());
+        inFlightPruneThreshold = std::max<size_t>(64, inFlight.size() * 2);
+    }
+}
+
+void CLCommandQueue::run(const std::shared_ptr<QueuedCommand>& queued,
+                         std::atomic<uint64_t>& completedCount) {
+    CLEvent* const event = queued->event;
+    queued->event = nullptr;
+
+    const bool dependencyFailed =
+        std::any_of(queued->waitList.begin(), queued->waitList.end(),
+                    [](CLEvent* dependency) {
+                        return dependency->getStatus() < CL_COMPLETE;
+                    });
+
+    event->setStatus(CL_RUNNING);
+    for (auto coalesced : queued->coalescedEvents) {
+        coalesced->setStatus(CL_RUNNING);
+    }
+
+    if (queued->command && !dependencyFailed) {
+        queued->command->execute();
+    }
+    queued->command.reset();
+
+    for (auto dependency : queued->waitList) {
+        dependency->release();
+    }
+    queued->waitList.clear();
+
+    completedCount.fetch_add(1 + queued->coalescedEvents.size(),
+                             std::memory_order_release);
+    // the command's own event completes last, so a finish() waiting for it
+    // can't return before the coalesced ones are done
+    for (auto coalesced : queued->coalescedEvents) {
+        coalesced->setStatus(CL_COMPLETE);
+        coalesced->release();
+    }
+    queued->coalescedEvents.clear();
+    event->setStatus(dependencyFailed
+                         ? CL_EXEC_STATUS_ERROR_FOR_EVENTS_IN_WAIT_LIST
+                         : CL_COMPLETE);
+    event->release();
 }
@@ -1,12 +1,19 @@
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
 #include <iostream>
 #include <memory>
-#include <queue>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include "IcdDispatchTable.h"
 #include "runtime/command/Command.h"
+#include "runtime/command/CommandArena.h"
+#include "runtime/command/CommandRing.h"
 #include "runtime/icd/CLContext.h"
+#include "runtime/icd/CLEvent.h"
 
 struct CLCommandQueue {
    public:
@@ -22,15 +29,153 @@ struct CLCommandQueue {
 
     unsigned int referenceCount = 1;
 
+    bool isOutOfOrder() const {
+        return properties & CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE;
+    }
+
+    /**
+     * Allocates a command from the queue's arena instead of the global heap.
+     */
+    template <typename T, typename... Args>
+    std::shared_ptr<T> makeCommand(Args&&... args) {
+        return std::allocate_shared<T>(ArenaAllocator<T>(arena),
+                                       std::forward<Args>(args)...);
+    }
+
     void enqueue(const std::shared_ptr<const Command>& command);
 
+    /**
+     * Enqueues the command to run once every event of the wait list is
+     * complete. Out-of-order queues run independent commands concurrently
+     * on the runtime worker pool.
+     *
+     * @param event if not null, receives a new event of the command
+     */
+    void enqueue(const std::shared_ptr<const Command>& command,
+                 cl_uint numEventsInWaitList,
+                 const cl_event* eventWaitList,
+                 cl_event* event);
+
+    /**
+     * Same as enqueue, but a blocking call also flushes the queue and waits
+     * for this command only. Until a non-blocking command's event completes,
+     * the host memory it reads or writes belongs to the runtime.
+     *
+     * @return CL_EXEC_STATUS_ERROR_FOR_EVENTS_IN_WAIT_LIST if a blocking
+     * command failed because of its wait list
+     */
+    cl_int enqueue(const std::shared_ptr<const Command>& command,
+                   bool blocking,
+                   cl_uint numEventsInWaitList,
+                   const cl_event* eventWaitList,
+                   cl_event* event);
+
+    /**
+     * Enqueues a map or unmap of the memory object. If nothing is pending in
+     * the queue and the wait list is empty, the memory is already up to
+     * date and the command completes right away without going through the
+     * executor.
+     */
+    cl_int enqueueMap(CLMem* memory,
+                      cl_command_type type,
+                      bool blocking,
+                      cl_uint numEventsInWaitList,
+                      const cl_event* eventWaitList,
+                      cl_event* event);
+
+    /**
+     * Enqueues a marker which completes after the events of the wait list,
+     * or after every previously enqueued command if the list is empty.
+     */
+    void enqueueMarker(cl_uint numEventsInWaitList,
+                       const cl_event* eventWaitList,
+                       cl_event* event);
+
+    /**
+     * Same as marker, but commands enqueued after the barrier don't start
+     * until it is complete.
+     */
+    void enqueueBarrier(cl_uint numEventsInWaitList,
+                        const cl_event* eventWaitList,
+                        cl_event* event);
+
+    /**
+     * Hands every enqueued command to the executor thread without waiting
+     * for them to complete.
+     */
     void flush();
 
+    /**
+     * Flushes the queue and blocks until every command enqueued before the
+     * call has completed.
+     */
+    void finish();
+
+    /**
+     * @return number of enqueued commands which have not completed yet
+     */
     size_t size();
 
    private:
-    std::queue<std::shared_ptr<const Command>> commands =
-        std::queue<std::shared_ptr<const Command>>();
+    struct QueuedCommand {
+        // null for markers and barriers
+        std::shared_ptr<const Command> command;
+        // the queue holds one reference until the command completes
+        CLEvent* event = nullptr;
+        // retained until the command completes
+        std::vector<CLEvent*> waitList;
+        // depend on every previously enqueued command
+        bool waitsForAll = false;
+        bool isBarrier = false;
+        // events of transfers merged into this command, each holding the
+        // queue's reference
+        std::vector<CLEvent*> coalescedEvents;
+    };
+
+    using Batch = std::vector<std::shared_ptr<QueuedCommand>>;
+
+    std::shared_ptr<CommandArena> arena = std::make_shared<CommandArena>();
+
+    CommandRing<std::shared_ptr<QueuedCommand>> commands;
+
+    std::mutex executorMutex;
+    std::condition_variable executorCondition;
+    uint64_t flushedCount = 0;
+    std::atomic<uint64_t> completedCount{0};
+    bool stopping = false;
+
+    std::thread executor;
+
+    // owned by the executor thread, only used by out-of-order queues:
+    // events of dispatched commands which may not have completed yet
+    std::vector<CLEvent*> inFlight;
+    size_t inFlightPruneThreshold = 64;
+    CLEvent* lastBarrier = nullptr;
+
+    CLEvent* push(std::shared_ptr<QueuedCommand> queued,
+                  cl_command_type type,
+                  cl_uint numEventsInWaitList,
+                  const cl_event* eventWaitList,
+                  cl_event* event);
+
+    void executeCommands();
+
+    /**
+     * Replaces every run of at least two consecutive reads and writes of the
+     * same buffer without wait lists by a single BufferTransferBatchCommand.
+     */
+    Batch coalesceTransfers(Batch batch);
+    void dispatchInOrder(const std::shared_ptr<QueuedCommand>& queued);
+    void dispatchOutOfOrder(const std::shared_ptr<QueuedCommand>& queued);
 
-    bool flushInProcess = false;
+    /**
+     * Runs the command and completes its event. A command whose wait list
+     * contains a failed event is not executed and fails as well, which
+     * propagates the error through the dependency graph.
+     *
+     * The queue must not be touched once the event is complete: a finish()
+     * waiting for it may return and the queue may be deleted.
+     */
+    static void run(const std::shared_ptr<QueuedCommand>& queued,
+                    std::atomic<uint64_t>& completedCount);
 };
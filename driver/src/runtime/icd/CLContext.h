@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <optional>
 
 #include "icd.h"
@@ -18,5 +19,6 @@ struct CLContext {
 
     std::optional<CLContextCallback> callback = std::nullopt;
     void* callbackUserData = nullptr;
-    unsigned int referenceCount = 1;
+    // memory objects released by commands release it on executor threads
+    std::atomic<unsigned int> referenceCount = 1;
 };
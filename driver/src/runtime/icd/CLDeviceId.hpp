@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+
 #include "icd.h"
 
 // TODO: encapsulate parser in device
@@ -9,12 +11,14 @@ struct CLDeviceId {
                cl_device_type deviceType,
                size_t globalMemorySize,
                size_t constantMemorySize,
-               size_t localMemorySize)
+               size_t localMemorySize,
+               size_t memoryBaseAddressAlignment)
         : dispatchTable(dispatchTable),
           deviceType(deviceType),
           globalMemorySize(globalMemorySize),
           constantMemorySize(constantMemorySize),
-          localMemorySize(localMemorySize) {}
+          localMemorySize(localMemorySize),
+          memoryBaseAddressAlignment(memoryBaseAddressAlignment) {}
 
     IcdDispatchTable* const dispatchTable;
     const cl_device_type deviceType;
@@ -22,8 +26,11 @@ struct CLDeviceId {
     const size_t globalMemorySize;
     const size_t constantMemorySize;
     const size_t localMemorySize;
+    // in bytes, CL_DEVICE_MEM_BASE_ADDR_ALIGN is in bits
+    const size_t memoryBaseAddressAlignment;
 
-    size_t usedGlobalMemory = 0;
+    // also freed on executor threads, when commands release memory objects
+    std::atomic<size_t> usedGlobalMemory = 0;
     size_t usedLocalMemory = 0;
 
     [[nodiscard]] bool matchesType(cl_device_type type) const {
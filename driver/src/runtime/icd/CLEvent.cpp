@@ -0,0 +1,252 @@
+#include "CLEvent.h"
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <memory>
+#include <new>
+#include <runtime-commons.h>
+#include <type_traits>
+
+#include "CLCommandQueue.h"
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+/**
+ * Free list of event-sized storage blocks. Blocks are allocated in chunks
+ * and never returned to the system, so a released event may be reused by
+ * the very next enqueue.
+ */
+class EventPool {
+   public:
+    void* acquire() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (freeBlocks.empty()) {
+            chunks.push_back(std::make_unique<Block[]>(kChunkSize));
+            for (size_t i = 0; i < kChunkSize; ++i) {
+                freeBlocks.push_back(&chunks.back()[i]);
+            }
+        }
+
+        void* block = freeBlocks.back();
+        freeBlocks.pop_back();
+        return block;
+    }
+
+    void recycle(void* block) {
+        std::lock_guard<std::mutex> lock(mutex);
+        freeBlocks.push_back(block);
+    }
+
+   private:
+    using Block = std::aligned_storage_t<sizeof(CLEvent), alignof(CLEvent)>;
+    static constexpr size_t kChunkSize = 64;
+
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Block[]>> chunks;
+    std::vector<void*> freeBlocks;
+};
+
+EventPool& eventPool() {
+    // leaked on purpose: events may still be released during static
+    // destruction
+    static auto* pool = new EventPool();
+    return *pool;
+}
+
+#ifdef __linux__
+static_assert(sizeof(std::atomic<cl_int>) == sizeof(int) &&
+                  std::atomic<cl_int>::is_always_lock_free,
+              "Event status can't be used as a futex word");
+
+void futexWait(std::atomic<cl_int>* word, cl_int expected) {
+    syscall(SYS_futex, reinterpret_cast<int*>(word), FUTEX_WAIT_PRIVATE,
+            expected, nullptr, nullptr, 0);
+}
+
+void futexWakeAll(std::atomic<cl_int>* word) {
+    syscall(SYS_futex, reinterpret_cast<int*>(word), FUTEX_WAKE_PRIVATE,
+            INT_MAX, nullptr, nullptr, 0);
+}
+#endif
+
+cl_ulong monotonicNanoseconds() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+}  // namespace
+
+CLEvent* CLEvent::create(IcdDispatchTable* dispatchTable,
+                         CLContext* context,
+                         CLCommandQueue* queue,
+                         cl_command_type commandType,
+                         cl_int status) {
+    const bool profiled =
+        queue && (queue->properties & CL_QUEUE_PROFILING_ENABLE);
+    return new (eventPool().acquire()) CLEvent(
+        dispatchTable, context, queue, commandType, status, profiled);
+}
+
+CLEvent::CLEvent(IcdDispatchTable* dispatchTable,
+                 CLContext* context,
+                 CLCommandQueue* queue,
+                 cl_command_type commandType,
+                 cl_int status,
+                 bool profiled)
+    : dispatchTable(dispatchTable),
+      context(context),
+      queue(queue),
+      commandType(commandType),
+      profiled(profiled),
+      status(status) {
+    if (profiled) {
+        // an event created complete reached every status at once
+        const cl_ulong now = monotonicNanoseconds();
+        for (cl_int reached = status; reached <= CL_QUEUED; ++reached) {
+            profilingTimes[reached] = now;
+        }
+    }
+}
+
+bool CLEvent::setStatus(cl_int newStatus) {
+    cl_int current = getStatus();
+    if (profiled && current > CL_COMPLETE && newStatus < current) {
+        // skipped statuses get the same timestamp
+        const cl_ulong now = monotonicNanoseconds();
+        for (cl_int skipped = std::max(newStatus, CL_COMPLETE);
+             skipped < current; ++skipped) {
+            profilingTimes[skipped] = now;
+        }
+    }
+
+    do {
+        if (current <= CL_COMPLETE || newStatus >= current) {
+            return false;
+        }
+    } while (!status.compare_exchange_weak(current, newStatus,
+                                           std::memory_order_acq_rel));
+
+    const bool completed = newStatus <= CL_COMPLETE;
+    std::vector<std::function<void()>> readyContinuations;
+    std::vector<Callback> readyCallbacks;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (completed) {
+            readyContinuations.swap(continuations);
+        }
+
+        auto pending = callbacks.begin();
+        for (const auto& callback : callbacks) {
+            if (newStatus <= callback.type) {
+                readyCallbacks.push_back(callback);
+            } else {
+                *pending++ = callback;
+            }
+        }
+        callbacks.erase(pending, callbacks.end());
+    }
+
+    if (completed) {
+        wakeWaiters();
+    }
+
+    for (const auto& callback : readyCallbacks) {
+        dispatchCallback(callback, newStatus);
+    }
+    for (const auto& continuation : readyContinuations) {
+        continuation();
+    }
+    return true;
+}
+
+bool CLEvent::whenComplete(std::function<void()> continuation) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (isComplete()) {
+        return false;
+    }
+    continuations.push_back(std::move(continuation));
+    return true;
+}
+
+void CLEvent::addCallback(cl_int callbackType,
+                          CLEventCallback callback,
+                          void* userData) {
+    retain();
+
+    cl_int current;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        current = getStatus();
+        if (current > callbackType) {
+            callbacks.push_back({callbackType, callback, userData});
+            return;
+        }
+    }
+    dispatchCallback({callbackType, callback, userData}, current);
+}
+
+void CLEvent::dispatchCallback(const Callback& callback, cl_int eventStatus) {
+    // a completion callback gets the error code if the command failed
+    const cl_int reportedStatus =
+        eventStatus < CL_COMPLETE ? eventStatus : callback.type;
+
+    kEventCallbackPool.submit([this, callback, reportedStatus]() {
+        callback.function(this, reportedStatus, callback.userData);
+        release();
+    });
+}
+
+void CLEvent::wait() {
+    cl_int current = getStatus();
+    if (current <= CL_COMPLETE) {
+        return;
+    }
+
+    waiters.fetch_add(1, std::memory_order_seq_cst);
+#ifdef __linux__
+    while ((current = status.load(std::memory_order_seq_cst)) >
+           CL_COMPLETE) {
+        futexWait(&status, current);
+    }
+#else
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        completion.wait(lock, [this]() { return isComplete(); });
+    }
+#endif
+    waiters.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void CLEvent::wakeWaiters() {
+    // pairs with the seq_cst increment in wait(): either the waiter sees the
+    // new status or we see the waiter
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+#ifdef __linux__
+    futexWakeAll(&status);
+#else
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+    }
+    completion.notify_all();
+#endif
+}
+
+void CLEvent::retain() {
+    referenceCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+void CLEvent::release() {
+    if (referenceCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        this->~CLEvent();
+        eventPool().recycle(this);
+    }
+}
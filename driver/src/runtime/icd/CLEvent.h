@@ -0,0 +1,135 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "icd.h"
+
+using CLEventCallback = void(CL_CALLBACK*)(cl_event event,
+                                           cl_int event_command_status,
+                                           void* user_data);
+
+struct CLEvent {
+    /**
+     * Takes an event from the runtime-wide pool, so enqueueing a command
+     * doesn't allocate in the steady state.
+     */
+    static CLEvent* create(IcdDispatchTable* dispatchTable,
+                           CLContext* context,
+                           CLCommandQueue* queue,
+                           cl_command_type commandType,
+                           cl_int status = CL_QUEUED);
+
+    CLEvent(const CLEvent&) = delete;
+    CLEvent& operator=(const CLEvent&) = delete;
+
+    IcdDispatchTable* const dispatchTable;
+    CLContext* const context;
+    // null for user events
+    CLCommandQueue* const queue;
+    const cl_command_type commandType;
+
+    std::atomic<unsigned int> referenceCount = 1;
+
+    /**
+     * Timestamps are only recorded for commands of queues created with
+     * CL_QUEUE_PROFILING_ENABLE.
+     */
+    bool isProfiled() const {
+        return profiled;
+    }
+
+    /**
+     * @param status CL_QUEUED, CL_SUBMITTED, CL_RUNNING or CL_COMPLETE
+     * @return monotonic time in nanoseconds at which the event reached the
+     * status. Only valid for a complete profiled event.
+     */
+    cl_ulong getProfilingTime(cl_int status) const {
+        return profilingTimes[status];
+    }
+
+    cl_int getStatus() const {
+        return status.load(std::memory_order_acquire);
+    }
+
+    bool isComplete() const {
+        return getStatus() <= CL_COMPLETE;
+    }
+
+    /**
+     * Moves the event to the given execution status. Status only goes down
+     * from CL_QUEUED to CL_COMPLETE or an error code, other transitions are
+     * ignored. The caller must hold a reference, waiters may release theirs
+     * as soon as the event completes.
+     *
+     * @return false if the transition was ignored
+     */
+    bool setStatus(cl_int newStatus);
+
+    /**
+     * Registers an internal continuation run on the thread which completes
+     * the event.
+     * @return false if the event is already complete, continuation is not
+     * registered then
+     */
+    bool whenComplete(std::function<void()> continuation);
+
+    /**
+     * Registers a user callback called on the runtime callback thread once
+     * the status reaches callbackType, or immediately if it already has.
+     * The event is retained until the callback is called.
+     */
+    void addCallback(cl_int callbackType,
+                     CLEventCallback callback,
+                     void* userData);
+
+    /**
+     * Blocks until the event is complete, sleeping on a futex where
+     * available and on a condition variable otherwise.
+     */
+    void wait();
+
+    void retain();
+
+    /**
+     * Returns the event to the pool once the last reference is gone.
+     */
+    void release();
+
+   private:
+    struct Callback {
+        cl_int type;
+        CLEventCallback function;
+        void* userData;
+    };
+
+    CLEvent(IcdDispatchTable* dispatchTable,
+            CLContext* context,
+            CLCommandQueue* queue,
+            cl_command_type commandType,
+            cl_int status,
+            bool profiled);
+
+    ~CLEvent() = default;
+
+    const bool profiled;
+    // indexed by status, written by the thread driving the transitions
+    // before the status is published
+    std::array<cl_ulong, CL_QUEUED + 1> profilingTimes{};
+
+    // futex word, must stay a plain 32-bit integer
+    std::atomic<cl_int> status;
+    std::atomic<unsigned int> waiters{0};
+
+    std::mutex mutex;
+    std::condition_variable completion;
+    std::vector<std::function<void()>> continuations;
+    std::vector<Callback> callbacks;
+
+    void dispatchCallback(const Callback& callback, cl_int eventStatus);
+    void wakeWaiters();
+};
@@ -1,5 +1,7 @@
 #include "CLMem.h"
 
+#include <algorithm>
+
 CLMem::CLMem(IcdDispatchTable* dispatchTable, CLContext* context)
     : dispatchTable(dispatchTable), context(context) {
     clRetainContext(context);
@@ -19,3 +21,64 @@ void CLMem::registerCallback(
     const std::shared_ptr<CLMemDestructorCallback>& callback) {
     destructorCallbacks.push(callback);
 }
+
+void CLMem::addMapping(const CLMemMapping& mapping) {
+    std::lock_guard<std::mutex> lock(mappingsMutex);
+    mappings.push_back(mapping);
+}
+
+bool CLMem::removeMapping(void* pointer) {
+    std::lock_guard<std::mutex> lock(mappingsMutex);
+    const auto mapping = std::find_if(
+        mappings.begin(), mappings.end(),
+        [pointer](const auto& mapping) { return mapping.pointer == pointer; });
+    if (mapping == mappings.end()) {
+        return false;
+    }
+    mappings.erase(mapping);
+    return true;
+}
+
+cl_uint CLMem::getMapCount() {
+    std::lock_guard<std::mutex> lock(mappingsMutex);
+    return mappings.size();
+}
+
+bool CLMem::overlaps(CLMem* other) {
+    if (getRoot() != other->getRoot()) {
+        return false;
+    }
+    return origin < other->origin + other->size &&
+           other->origin < origin + size;
+}
+
+void CLMem::addSubBuffer(CLMem* subBuffer) {
+    std::lock_guard<std::mutex> lock(subBuffersMutex);
+    const auto position = std::upper_bound(
+        subBuffers.begin(), subBuffers.end(), subBuffer,
+        [](CLMem* left, CLMem* right) { return left->origin < right->origin; });
+    subBuffers.insert(position, subBuffer);
+}
+
+void CLMem::removeSubBuffer(CLMem* subBuffer) {
+    std::lock_guard<std::mutex> lock(subBuffersMutex);
+    subBuffers.erase(
+        std::remove(subBuffers.begin(), subBuffers.end(), subBuffer),
+        subBuffers.end());
+}
+
+std::vector<CLMem*> CLMem::getSubBuffersOverlapping(size_t offset,
+                                                    size_t size) {
+    std::lock_guard<std::mutex> lock(subBuffersMutex);
+    std::vector<CLMem*> result;
+    // sorted by origin, so nothing after the range's end can intersect it
+    for (auto subBuffer : subBuffers) {
+        if (subBuffer->origin >= offset + size) {
+            break;
+        }
+        if (offset < subBuffer->origin + subBuffer->size) {
+            result.push_back(subBuffer);
+        }
+    }
+    return result;
+}
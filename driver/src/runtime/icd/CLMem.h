@@ -1,10 +1,15 @@
 #pragma once
 
+#include <atomic>
 #include <cstddef>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <stack>
+#include <vector>
 
 #include "icd.h"
+#include "runtime/memory/ImageLayout.h"
 
 using CLMemDestructorCallbackFunction = void (*)(cl_mem mem_obj,
                                                  void* user_data);
@@ -18,6 +23,22 @@ struct CLMemDestructorCallback {
     void* userData;
 };
 
+struct CLMemMapping {
+    std::byte* pointer;
+    size_t size;
+    cl_map_flags flags;
+};
+
+struct CLImageProperties {
+    cl_image_format format;
+    cl_image_desc desc;
+    // texels in each dimension of the layout, array layers included
+    size_t width;
+    size_t height;
+    size_t depth;
+    ImageLayout layout;
+};
+
 struct CLMem {
    public:
     explicit CLMem(IcdDispatchTable* dispatchTable, CLContext* context);
@@ -27,8 +48,18 @@ struct CLMem {
     IcdDispatchTable* const dispatchTable;
     CLContext* const context;
 
+    cl_mem_object_type type = CL_MEM_OBJECT_BUFFER;
     std::byte* address = nullptr;
     size_t size = 0;
+    // set for sub-buffers, which are views into the parent's memory
+    CLMem* parent = nullptr;
+    size_t origin = 0;
+    cl_mem_flags flags = 0;
+    // pointer passed with CL_MEM_USE_HOST_PTR
+    void* hostPtr = nullptr;
+
+    // set for images, which are stored in the tiled layout
+    std::optional<CLImageProperties> image;
 
     bool kernelCanRead = false;
     bool kernelCanWrite = false;
@@ -36,11 +67,56 @@ struct CLMem {
     bool hostCanRead = false;
     bool hostCanWrite = false;
 
-    unsigned int referenceCount = 1;
+    // commands release the objects they use on the queue's executor thread
+    std::atomic<unsigned int> referenceCount = 1;
 
     void registerCallback(
         const std::shared_ptr<CLMemDestructorCallback>& callback);
 
+    /**
+     * Mappings point straight into the memory object, nothing is copied on
+     * map or unmap. They are only tracked to validate unmaps and report the
+     * map count.
+     */
+    void addMapping(const CLMemMapping& mapping);
+
+    /**
+     * @return false if the pointer is not mapped
+     */
+    bool removeMapping(void* pointer);
+
+    cl_uint getMapCount();
+
+    /**
+     * @return buffer which owns the memory, the object itself if it is not a
+     * sub-buffer
+     */
+    CLMem* getRoot() {
+        return parent ? parent : this;
+    }
+
+    /**
+     * @return true if both objects view intersecting bytes of the same
+     * memory, so commands using them may conflict
+     */
+    bool overlaps(CLMem* other);
+
+    void addSubBuffer(CLMem* subBuffer);
+
+    void removeSubBuffer(CLMem* subBuffer);
+
+    /**
+     * Overlap index of the buffer's sub-buffers, sorted by origin.
+     * @return live sub-buffers intersecting the byte range
+     */
+    std::vector<CLMem*> getSubBuffersOverlapping(size_t offset, size_t size);
+
    private:
     std::stack<std::shared_ptr<CLMemDestructorCallback>> destructorCallbacks{};
+
+    std::mutex mappingsMutex;
+    std::vector<CLMemMapping> mappings;
+
+    std::mutex subBuffersMutex;
+    std::vector<CLMem*> subBuffers;
 };
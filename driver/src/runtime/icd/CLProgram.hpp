@@ -1,5 +1,10 @@
 #pragma once
 
+#include <atomic>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
 #include "runtime/program/BinaryDisassembler.h"
 #include "icd.h"
 
@@ -10,13 +15,35 @@ struct CLProgram {
     }
 
     ~CLProgram() {
-        for (auto kernel : disassembledBinary->kernels) {
-            clReleaseKernel(kernel);
-        }
         delete[] binary;
         clReleaseContext(context);
     }
 
+    /**
+     * Indexes kernels of the disassembled binary, once it is set. A name
+     * which appears twice refers to its first kernel.
+     */
+    void indexKernels() {
+        kernelsByName.clear();
+        kernelNames.clear();
+
+        for (const auto& kernel : disassembledBinary->kernels) {
+            kernelsByName.emplace(kernel->name, kernel.get());
+            if (!kernelNames.empty()) {
+                kernelNames += ';';
+            }
+            kernelNames += kernel->name;
+        }
+    }
+
+    /**
+     * @return nullptr if there is no kernel with the name
+     */
+    [[nodiscard]] LazyKernel* findKernel(std::string_view name) const {
+        const auto kernel = kernelsByName.find(name);
+        return kernel == kernelsByName.end() ? nullptr : kernel->second;
+    }
+
     IcdDispatchTable* const dispatchTable;
     CLContext* context;
 
@@ -26,6 +53,11 @@ struct CLProgram {
     cl_build_status buildStatus = CL_BUILD_NONE;
     std::string buildLog;
     std::unique_ptr<BinaryDisassemblingResult> disassembledBinary;
+    // keys view the names owned by the kernels
+    std::unordered_map<std::string_view, LazyKernel*> kernelsByName;
+    // separated by semicolons, as CL_PROGRAM_KERNEL_NAMES returns them
+    std::string kernelNames;
 
-    unsigned int referenceCount = 1;
+    // kernels released by their launches release it on executor threads
+    std::atomic<unsigned int> referenceCount = 1;
 };
@@ -3,8 +3,23 @@
 #include "icd.h"
 
 struct CLSampler {
-    explicit CLSampler(IcdDispatchTable* dispatchTable)
-        : dispatchTable(dispatchTable) {}
+    CLSampler(IcdDispatchTable* dispatchTable,
+              CLContext* context,
+              bool normalizedCoords,
+              cl_addressing_mode addressingMode,
+              cl_filter_mode filterMode)
+        : dispatchTable(dispatchTable),
+          context(context),
+          normalizedCoords(normalizedCoords),
+          addressingMode(addressingMode),
+          filterMode(filterMode) {}
 
     IcdDispatchTable* const dispatchTable;
+    CLContext* const context;
+
+    const bool normalizedCoords;
+    const cl_addressing_mode addressingMode;
+    const cl_filter_mode filterMode;
+
+    unsigned int referenceCount = 1;
 };
@@ -1,5 +1,6 @@
 #include <common/utils/common.hpp>
 #include <cstddef>
+#include <cstring>
 #include <string>
 #include <utility>
 
@@ -7,15 +8,13 @@
 #include "runtime-commons.h"
 
 CLKernel::CLKernel(IcdDispatchTable* const dispatchTable,
-                   std::string name,
-                   std::vector<std::string> config,
-                   std::vector<std::string> instructions,
-                   std::vector<KernelArgument> arguments)
+                   std::shared_ptr<const KernelDefinition> definition)
     : dispatchTable(dispatchTable),
-      name(std::move(name)),
-      config(std::move(config)),
-      instructions(std::move(instructions)),
-      arguments(std::move(arguments)) {}
+      definition(std::move(definition)),
+      name(this->definition->name),
+      values(std::make_shared<KernelArgumentValues>(KernelArgumentValues{
+          this->definition->arguments,
+          std::vector<std::byte>(this->definition->kernargSize)})) {}
 
 CLKernel::~CLKernel() {
     if (program) {
@@ -24,54 +23,121 @@ CLKernel::~CLKernel() {
 }
 
 void CLKernel::setArgument(cl_uint index, size_t size, const void* value) {
-    if (index >= arguments.size()) {
+    if (index >= values->arguments.size()) {
         throw KernelArgumentOutOfBoundsError(
             "Attempt to set argument at index " + std::to_string(index) +
-            " of kernel with " + std::to_string(arguments.size()) +
+            " of kernel with " + std::to_string(values->arguments.size()) +
             " arguments");
     }
 
-    const auto argInfo = arguments[index].info;
+    // values given to a launch are never written again, even once it is
+    // done, so nothing has to be ordered against the executor's reads
+    if (valuesShared.exchange(false, std::memory_order_acq_rel)) {
+        values = std::make_shared<KernelArgumentValues>(*values);
+    }
+
+    auto& argument = values->arguments[index];
+    const auto* info = argument.info.get();
+    std::byte* const slot = values->kernarg.data() + argument.offset;
+    const auto* pointerInfo =
+        dynamic_cast<const PointerKernelArgumentInfo*>(info);
+
+    if (pointerInfo &&
+        pointerInfo->addressQualifier == CL_KERNEL_ARG_ADDRESS_LOCAL) {
+        if (value) {
+            throw KernelArgumentValueError(
+                "Value of local memory argument " + std::to_string(index) +
+                " should be null");
+        }
+        if (!size) {
+            throw KernelArgumentSizeError(
+                "Size of local memory argument " + std::to_string(index) +
+                " should not be 0");
+        }
+        argument.localMemorySize = size;
+
+    } else if (pointerInfo ||
+               dynamic_cast<const ImageKernelArgumentInfo*>(info)) {
+        if (value && size != sizeof(cl_mem)) {
+            throw KernelArgumentSizeError(
+                "Memory object argument " + std::to_string(index) +
+                " has size " + std::to_string(sizeof(cl_mem)) + ", got " +
+                std::to_string(size));
+        }
+        const auto memory =
+            value ? *static_cast<const cl_mem*>(value) : nullptr;
+        const void* address = memory ? memory->address : nullptr;
+        memcpy(slot, &address, sizeof(address));
+        argument.memory = memory;
+
+    } else if (dynamic_cast<const SamplerKernelArgumentInfo*>(info)) {
+        if (!value) {
+            throw KernelArgumentValueError("Sampler argument " +
+                                           std::to_string(index) +
+                                           " is null");
+        }
+        memcpy(slot, value, sizeof(cl_sampler));
 
-    KernelArgumentValueType data;
-    if (!value) {
-        data = nullptr;
-    } else if (std::dynamic_pointer_cast<PointerKernelArgumentInfo>(argInfo)) {
-        data = *const_cast<cl_mem*>(static_cast<const cl_mem*>(value));
     } else {
-        auto* temp = new std::byte[size];
-        memcpy(temp, value, size);
-        data = temp;
+        if (!value) {
+            throw KernelArgumentValueError("Value of argument " +
+                                           std::to_string(index) +
+                                           " is null");
+        }
+        if (size != info->kernargSize()) {
+            throw KernelArgumentSizeError(
+                "Argument " + std::to_string(index) + " has size " +
+                std::to_string(info->kernargSize()) + ", got " +
+                std::to_string(size));
+        }
+        memcpy(slot, value, size);
     }
 
-    arguments[index].value = KernelArgumentValue(index, size, data);
+    argument.isSet = true;
 }
 
 KernelArgument CLKernel::getArgument(cl_uint index) const {
-    if (index >= arguments.size()) {
+    if (index >= values->arguments.size()) {
         throw KernelArgumentOutOfBoundsError(
             "Attempt to get argument at index " + std::to_string(index) +
-            " of kernel with " + std::to_string(arguments.size()) +
+            " of kernel with " + std::to_string(values->arguments.size()) +
             " arguments");
     }
 
-    return arguments[index];
+    return values->arguments[index];
 }
 
 const std::vector<KernelArgument>& CLKernel::getArguments() const {
-    return arguments;
+    return values->arguments;
 }
 
 int CLKernel::argumentCount() const {
-    return arguments.size();
+    return values->arguments.size();
 }
 
-CLKernel* CLKernelBuilder::build() const {
+const std::vector<std::byte>& CLKernel::getKernargBlock() const {
+    return values->kernarg;
+}
+
+std::shared_ptr<const KernelArgumentValues> CLKernel::snapshotArguments() {
+    valuesShared.store(true, std::memory_order_release);
+    return values;
+}
+
+std::shared_ptr<const KernelDefinition> CLKernelBuilder::build() const {
+    const auto alignUp = [](size_t value, size_t alignment) {
+        return (value + alignment - 1) / alignment * alignment;
+    };
+
     std::vector<KernelArgument> args;
-    std::transform(argumentInfo.begin(), argumentInfo.end(),
-                   std::back_inserter(args), [](auto& info) {
-                       return KernelArgument(info);
-                   });
+    size_t offset = hiddenArgumentsSize;
+    for (const auto& info : argumentInfo) {
+        offset = alignUp(offset, info->kernargAlignment());
+        args.emplace_back(info, offset);
+        offset += info->kernargSize();
+    }
 
-    return new CLKernel(kDispatchTable, name, config, instructions, args);
+    return std::make_shared<const KernelDefinition>(
+        KernelDefinition{name, config, instructions, std::move(args),
+                         alignUp(offset, sizeof(uint64_t))});
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
 #include <optional>
 #include <stdexcept>
 #include <string>
@@ -10,16 +12,40 @@
 #include "KernelArgument.hpp"
 #include "runtime/icd/icd.h"
 
+/**
+ * Kernel of a program as it is parsed: code and argument layout. Every
+ * CLKernel created for the kernel shares it.
+ */
+struct KernelDefinition {
+    std::string name;
+    std::vector<std::string> config;
+    std::vector<std::string> instructions;
+    // unset, at their slots of the kernarg block
+    std::vector<KernelArgument> arguments;
+    size_t kernargSize;
+};
+
+/**
+ * Values of a kernel's arguments. Launches keep the values current when
+ * they were enqueued, so shared values are copied before being changed.
+ */
+struct KernelArgumentValues {
+    std::vector<KernelArgument> arguments;
+    // laid out as the kernarg segment, hidden arguments are left zero
+    std::vector<std::byte> kernarg;
+};
+
 struct CLKernel {
    public:
     CLKernel(IcdDispatchTable* dispatchTable,
-             std::string name,
-             std::vector<std::string> config,
-             std::vector<std::string> instructions,
-             std::vector<KernelArgument> arguments);
+             std::shared_ptr<const KernelDefinition> definition);
 
     ~CLKernel();
 
+    /**
+     * Writes the value to the argument's slot of the kernarg block. Memory
+     * objects are written as their address and kept in the argument.
+     */
     void setArgument(cl_uint index, size_t size, const void* value);
 
     [[nodiscard]] KernelArgument getArgument(cl_uint index) const;
@@ -28,26 +54,44 @@ struct CLKernel {
 
     [[nodiscard]] int argumentCount() const;
 
+    [[nodiscard]] const std::vector<std::byte>& getKernargBlock() const;
+
+    /**
+     * @return current values, which stay unchanged by later setArgument
+     * calls
+     */
+    [[nodiscard]] std::shared_ptr<const KernelArgumentValues>
+    snapshotArguments();
+
     IcdDispatchTable* const dispatchTable;
-    const std::string name;
-    const std::vector<std::string> config{};
-    const std::vector<std::string> instructions{};
+    const std::shared_ptr<const KernelDefinition> definition;
+    const std::string& name;
 
     CLProgram* program{};
 
-    unsigned int referenceCount = 0;
+    // launches release it on the queue's executor thread
+    std::atomic<unsigned int> referenceCount = 1;
 
    private:
-    std::vector<KernelArgument> arguments;
+    std::shared_ptr<KernelArgumentValues> values;
+    // set once values are snapshotted, they are copied before the next
+    // change; kernels may be enqueued from several threads at once, only
+    // clSetKernelArg calls on one kernel must not run concurrently
+    std::atomic<bool> valuesShared{false};
 };
 
 struct CLKernelBuilder {
-    [[nodiscard]] CLKernel* build() const;
+    /**
+     * Lays out the arguments in the kernarg block.
+     */
+    [[nodiscard]] std::shared_ptr<const KernelDefinition> build() const;
 
     std::string name;
     std::vector<std::string> config{};
     std::vector<std::string> instructions{};
     std::vector<std::shared_ptr<KernelArgumentInfo>> argumentInfo{};
+    // arguments added by the compiler, which precede the others
+    size_t hiddenArgumentsSize = 0;
 };
 
 class KernelArgumentOutOfBoundsError : public std::runtime_error {
@@ -57,3 +101,15 @@ class KernelArgumentOutOfBoundsError : public std::runtime_error {
     explicit KernelArgumentOutOfBoundsError(const char* message)
         : std::runtime_error(message){};
 };
+
+class KernelArgumentSizeError : public std::runtime_error {
+   public:
+    explicit KernelArgumentSizeError(const std::string& message)
+        : std::runtime_error(message){};
+};
+
+class KernelArgumentValueError : public std::runtime_error {
+   public:
+    explicit KernelArgumentValueError(const std::string& message)
+        : std::runtime_error(message){};
+};
@@ -1,16 +1,23 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
-#include <optional>
 #include <utility>
 
 #include "KernelArgumentInfo.h"
-#include "KernelArgumentValue.hpp"
+#include "runtime/icd/CLMem.h"
 
 struct KernelArgument {
-    explicit KernelArgument(std::shared_ptr<KernelArgumentInfo> info)
-        : info(std::move(info)) {}
+    KernelArgument(std::shared_ptr<KernelArgumentInfo> info, size_t offset)
+        : info(std::move(info)), offset(offset) {}
 
     const std::shared_ptr<KernelArgumentInfo> info;
-    std::optional<KernelArgumentValue> value{};
+    // of the argument's slot in the kernel's kernarg block
+    const size_t offset;
+
+    bool isSet = false;
+    // buffer or image of a memory object argument, null otherwise
+    CLMem* memory = nullptr;
+    // of a local pointer argument, the slot is assigned at launch
+    size_t localMemorySize = 0;
 };
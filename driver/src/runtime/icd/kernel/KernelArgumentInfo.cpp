@@ -1,5 +1,8 @@
 #include "KernelArgumentInfo.h"
 
+#include <algorithm>
+#include <map>
+
 std::set<std::string> cartesianProduct(const std::set<std::string>& first,
                                        const std::set<std::string>& second) {
     std::set<std::string> result;
@@ -50,3 +53,48 @@ const std::set<std::string>
 const std::set<std::string>
     EventKernelArgumentInfo::typeNameVariants =  // NOLINT(cert-err58-cpp)
     std::set<std::string>{"event_t"};
+
+namespace {
+size_t scalarSize(const std::string& type) {
+    static const std::map<std::string, size_t> sizes{
+        {"char", 1},     {"uchar", 1},    {"bool", 1},      {"short", 2},
+        {"ushort", 2},   {"half", 2},     {"int", 4},       {"uint", 4},
+        {"float", 4},    {"long", 8},     {"ulong", 8},     {"double", 8},
+        {"size_t", 8},   {"ptrdiff_t", 8}, {"intptr_t", 8}, {"uintptr_t", 8},
+        {"void", 0}};
+
+    const auto size = sizes.find(type);
+    return size == sizes.end() ? 0 : size->second;
+}
+}  // namespace
+
+size_t KernelArgumentInfo::kernargSize() const {
+    return sizeof(uint64_t);
+}
+
+size_t KernelArgumentInfo::kernargAlignment() const {
+    return std::max<size_t>(kernargSize(), 1);
+}
+
+size_t ScalarKernelArgumentInfo::kernargSize() const {
+    return scalarSize(type);
+}
+
+size_t VectorKernelArgumentInfo::kernargSize() const {
+    const auto countBegin = type.find_first_of("0123456789");
+    const auto count = std::stoul(type.substr(countBegin));
+    return scalarSize(type.substr(0, countBegin)) * (count == 3 ? 4 : count);
+}
+
+size_t StructureKernelArgumentInfo::kernargSize() const {
+    return structSize;
+}
+
+size_t StructureKernelArgumentInfo::kernargAlignment() const {
+    return sizeof(uint64_t);
+}
+
+size_t PointerKernelArgumentInfo::kernargSize() const {
+    return addressQualifier == CL_KERNEL_ARG_ADDRESS_LOCAL ? sizeof(uint32_t)
+                                                          : sizeof(uint64_t);
+}
@@ -9,6 +9,14 @@
 struct KernelArgumentInfo {
     virtual ~KernelArgumentInfo() = default;
 
+    /**
+     * Size of the argument in the kernarg segment, a pointer for memory
+     * objects and other opaque types.
+     */
+    [[nodiscard]] virtual size_t kernargSize() const;
+
+    [[nodiscard]] virtual size_t kernargAlignment() const;
+
     cl_uint index;
     std::string typeName;
     std::string type;
@@ -17,11 +25,16 @@ struct KernelArgumentInfo {
 };
 
 struct ScalarKernelArgumentInfo : public KernelArgumentInfo {
+    [[nodiscard]] size_t kernargSize() const override;
+
     static const std::set<std::string> typeNameVariants;
 };
 
 struct VectorKernelArgumentInfo : public KernelArgumentInfo {
    public:
+    // 3-component vectors take the space of 4-component ones
+    [[nodiscard]] size_t kernargSize() const override;
+
     static const std::set<std::string> typeNameVariants;
 
    private:
@@ -30,6 +43,9 @@ struct VectorKernelArgumentInfo : public KernelArgumentInfo {
 };
 
 struct StructureKernelArgumentInfo : public KernelArgumentInfo {
+    [[nodiscard]] size_t kernargSize() const override;
+    [[nodiscard]] size_t kernargAlignment() const override;
+
     size_t structSize = 0;
 
     static const std::set<std::string> typeNameVariants;
@@ -54,6 +70,9 @@ struct EventKernelArgumentInfo : public KernelArgumentInfo {
 };
 
 struct PointerKernelArgumentInfo : public KernelArgumentInfo {
+    // local pointers are 32-bit offsets into the local memory
+    [[nodiscard]] size_t kernargSize() const override;
+
     cl_kernel_arg_address_qualifier addressQualifier =
         CL_KERNEL_ARG_ADDRESS_GLOBAL;
     cl_kernel_arg_access_qualifier accessQualifier =
@@ -0,0 +1,236 @@
+#include "DeviceMemoryAllocator.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <runtime-commons.h>
+#include <string>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace {
+size_t roundUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+DeviceMemoryAllocator::HugePages hugePagesFromEnvironment() {
+    const char* value = std::getenv("RED_O_LATOR_HUGE_PAGES");
+    if (!value) {
+        return DeviceMemoryAllocator::HugePages::kTransparent;
+    }
+
+    const std::string mode = value;
+    if (mode == "none") {
+        return DeviceMemoryAllocator::HugePages::kNone;
+    }
+    if (mode == "explicit") {
+        return DeviceMemoryAllocator::HugePages::kExplicit;
+    }
+    return DeviceMemoryAllocator::HugePages::kTransparent;
+}
+}  // namespace
+
+DeviceMemoryAllocator::DeviceMemoryAllocator()
+    : DeviceMemoryAllocator(hugePagesFromEnvironment()) {}
+
+DeviceMemoryAllocator::DeviceMemoryAllocator(HugePages hugePages)
+    : hugePages(hugePages) {}
+
+DeviceMemoryAllocator::~DeviceMemoryAllocator() {
+    std::lock_guard<std::mutex> lock(mutex);
+    trimTo(0);
+}
+
+std::byte* DeviceMemoryAllocator::allocate(size_t size) {
+    if (size > kMaxPooledSize) {
+        return allocateFromSystem(size);
+    }
+
+    const size_t sizeClass = sizeClassOf(size);
+    std::byte* block = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        statistics.allocations++;
+
+        auto& blocks = freeBlocks[sizeClass];
+        if (!blocks.empty()) {
+            block = blocks.back();
+            blocks.pop_back();
+            statistics.reuses++;
+            statistics.cachedBlocks--;
+            statistics.cachedBytes -= sizeOfClass(sizeClass);
+        }
+    }
+
+    if (block) {
+        // the rest of the block is never visible to the new owner
+        std::memset(block, 0, size);
+        return block;
+    }
+
+    return allocateFromSystem(sizeOfClass(sizeClass));
+}
+
+void DeviceMemoryAllocator::free(std::byte* address, size_t size) {
+    if (!address) {
+        return;
+    }
+
+    if (size > kMaxPooledSize) {
+        freeToSystem(address, size);
+        return;
+    }
+
+    const size_t sizeClass = sizeClassOf(size);
+    std::lock_guard<std::mutex> lock(mutex);
+    freeBlocks[sizeClass].push_back(address);
+    statistics.cachedBlocks++;
+    statistics.cachedBytes += sizeOfClass(sizeClass);
+
+    if (statistics.cachedBytes > kMaxCachedBytes) {
+        // trim well below the limit, so a steady stream of releases
+        // doesn't trim on every call
+        trimTo(kMaxCachedBytes / 2);
+        logStatistics("cache limit exceeded");
+    }
+}
+
+void DeviceMemoryAllocator::trim() {
+    std::lock_guard<std::mutex> lock(mutex);
+    trimTo(0);
+    logStatistics("trimmed");
+}
+
+DeviceMemoryAllocator::Statistics DeviceMemoryAllocator::getStatistics() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return statistics;
+}
+
+void DeviceMemoryAllocator::trimTo(size_t maxCachedBytes) {
+    for (size_t sizeClass = kSizeClassCount; sizeClass-- > 0;) {
+        auto& blocks = freeBlocks[sizeClass];
+        while (!blocks.empty() && statistics.cachedBytes > maxCachedBytes) {
+            freeToSystem(blocks.back(), sizeOfClass(sizeClass));
+            blocks.pop_back();
+            statistics.trimmedBlocks++;
+            statistics.cachedBlocks--;
+            statistics.cachedBytes -= sizeOfClass(sizeClass);
+        }
+    }
+}
+
+void DeviceMemoryAllocator::logStatistics(const char* reason) {
+    kLogger.debug(
+        std::string("Device memory pool ") + reason + ": " +
+        std::to_string(statistics.allocations) + " allocations, " +
+        std::to_string(statistics.reuses) + " reused, " +
+        std::to_string(statistics.trimmedBlocks) + " blocks trimmed, " +
+        std::to_string(statistics.cachedBlocks) + " blocks (" +
+        std::to_string(statistics.cachedBytes) + " bytes) cached.");
+}
+
+size_t DeviceMemoryAllocator::sizeClassOf(size_t size) {
+    if (size <= kMappingThreshold) {
+        return (std::max<size_t>(size, 1) - 1) / kPageSize;
+    }
+
+    size_t octave = 0;
+    size_t base = kMappingThreshold;
+    while (size > base * 2) {
+        base *= 2;
+        octave++;
+    }
+    return kMappingThreshold / kPageSize + octave * 4 +
+           (size - base - 1) / (base / 4);
+}
+
+size_t DeviceMemoryAllocator::sizeOfClass(size_t sizeClass) {
+    const size_t pageClasses = kMappingThreshold / kPageSize;
+    if (sizeClass < pageClasses) {
+        return (sizeClass + 1) * kPageSize;
+    }
+
+    const size_t octave = (sizeClass - pageClasses) / 4;
+    const size_t step = (sizeClass - pageClasses) % 4;
+    return (kMappingThreshold << octave) / 4 * (5 + step);
+}
+
+std::byte* DeviceMemoryAllocator::allocateFromSystem(size_t size) {
+#ifdef __linux__
+    if (size > kMappingThreshold) {
+        return map(size);
+    }
+#endif
+
+    const size_t allocationSize = roundUp(size, kPageSize);
+    auto* address =
+        static_cast<std::byte*>(std::aligned_alloc(kPageSize, allocationSize));
+    if (address) {
+        std::memset(address, 0, allocationSize);
+    }
+    return address;
+}
+
+void DeviceMemoryAllocator::freeToSystem(std::byte* address, size_t size) {
+#ifdef __linux__
+    if (size > kMappingThreshold) {
+        munmap(address, mappingSize(size));
+        return;
+    }
+#endif
+
+    std::free(address);
+}
+
+size_t DeviceMemoryAllocator::mappingSize(size_t size) {
+    // huge mappings are whole huge pages, so an explicit huge page mapping
+    // and its regular fallback are released the same way
+    return roundUp(size, size >= kHugePageSize ? kHugePageSize : kPageSize);
+}
+
+std::byte* DeviceMemoryAllocator::map(size_t size) {
+#ifdef __linux__
+    const size_t length = mappingSize(size);
+    const bool huge = size >= kHugePageSize;
+
+#ifdef MAP_HUGETLB
+    if (huge && hugePages == HugePages::kExplicit) {
+        void* address = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (address != MAP_FAILED) {
+            return static_cast<std::byte*>(address);
+        }
+    }
+#endif
+
+    // over-map and trim both ends to get the alignment
+    const size_t alignment = huge ? kHugePageSize : kMappingThreshold;
+    void* mapped = mmap(nullptr, length + alignment, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapped == MAP_FAILED) {
+        return nullptr;
+    }
+
+    const auto start = reinterpret_cast<uintptr_t>(mapped);
+    const auto aligned = roundUp(start, alignment);
+    if (aligned > start) {
+        munmap(mapped, aligned - start);
+    }
+    if (const size_t tail = start + alignment - aligned) {
+        munmap(reinterpret_cast<void*>(aligned + length), tail);
+    }
+
+    auto* address = reinterpret_cast<std::byte*>(aligned);
+#ifdef MADV_HUGEPAGE
+    if (huge && hugePages != HugePages::kNone) {
+        madvise(address, length, MADV_HUGEPAGE);
+    }
+#endif
+    return address;
+#else
+    return nullptr;
+#endif
+}
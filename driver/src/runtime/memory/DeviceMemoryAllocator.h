@@ -0,0 +1,92 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+/**
+ * Allocates backing storage of memory objects. Every allocation is zeroed.
+ *
+ * Small allocations come from the heap aligned to 4KB. Large ones are
+ * anonymous mappings aligned to 64KB (2MB for huge ones), which the OS
+ * zeroes lazily on the first touch, so creating a buffer costs nothing per
+ * byte.
+ *
+ * Allocations up to kMaxPooledSize are rounded up to a size class and
+ * recycled: a freed block is kept for the next allocation of its class
+ * instead of going back to the system. Cached blocks are trimmed, largest
+ * classes first, once they exceed kMaxCachedBytes.
+ *
+ * Huge pages for large mappings are selected by the RED_O_LATOR_HUGE_PAGES
+ * environment variable: "transparent" (default) advises transparent huge
+ * pages, "explicit" asks for hugetlbfs pages and falls back to regular ones
+ * if none are reserved, "none" disables them.
+ */
+class DeviceMemoryAllocator {
+   public:
+    enum class HugePages { kNone, kTransparent, kExplicit };
+
+    struct Statistics {
+        size_t allocations = 0;
+        // allocations served from a cached block
+        size_t reuses = 0;
+        size_t trimmedBlocks = 0;
+        size_t cachedBlocks = 0;
+        size_t cachedBytes = 0;
+    };
+
+    static constexpr size_t kPageSize = 4 * 1024;
+    static constexpr size_t kMappingThreshold = 64 * 1024;
+    static constexpr size_t kHugePageSize = 2 * 1024 * 1024;
+    static constexpr size_t kMaxPooledSize = 1024 * 1024;
+    static constexpr size_t kMaxCachedBytes = 64 * 1024 * 1024;
+
+    DeviceMemoryAllocator();
+
+    explicit DeviceMemoryAllocator(HugePages hugePages);
+
+    ~DeviceMemoryAllocator();
+
+    DeviceMemoryAllocator(const DeviceMemoryAllocator&) = delete;
+    DeviceMemoryAllocator& operator=(const DeviceMemoryAllocator&) = delete;
+
+    /**
+     * @return zeroed memory of at least the given size or nullptr
+     */
+    std::byte* allocate(size_t size);
+
+    /**
+     * @param size size passed to allocate
+     */
+    void free(std::byte* address, size_t size);
+
+    /**
+     * Returns every cached block to the system and logs the statistics.
+     */
+    void trim();
+
+    Statistics getStatistics();
+
+   private:
+    // 4KB steps up to the mapping threshold, then four steps per power of two
+    static constexpr size_t kSizeClassCount = 16 + 4 * 4;
+
+    const HugePages hugePages;
+
+    std::mutex mutex;
+    std::array<std::vector<std::byte*>, kSizeClassCount> freeBlocks;
+    Statistics statistics;
+
+    static size_t sizeClassOf(size_t size);
+    static size_t sizeOfClass(size_t sizeClass);
+    static size_t mappingSize(size_t size);
+
+    std::byte* allocateFromSystem(size_t size);
+    void freeToSystem(std::byte* address, size_t size);
+    std::byte* map(size_t size);
+
+    // must be called with the mutex held
+    void trimTo(size_t maxCachedBytes);
+    void logStatistics(const char* reason);
+};
@@ -0,0 +1,305 @@
+#include "ImageFormat.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace {
+// components of a fill color stored by each channel, in memory order
+const std::vector<size_t>* getChannelComponents(cl_channel_order order) {
+    static const std::vector<size_t> r{0};
+    static const std::vector<size_t> a{3};
+    static const std::vector<size_t> rg{0, 1};
+    static const std::vector<size_t> ra{0, 3};
+    static const std::vector<size_t> rgba{0, 1, 2, 3};
+    static const std::vector<size_t> bgra{2, 1, 0, 3};
+    static const std::vector<size_t> argb{3, 0, 1, 2};
+
+    switch (order) {
+        case CL_R: return &r;
+        case CL_A: return &a;
+        case CL_RG: return &rg;
+        case CL_RA: return &ra;
+        case CL_RGBA: return &rgba;
+        case CL_BGRA: return &bgra;
+        case CL_ARGB: return &argb;
+        default: return nullptr;
+    }
+}
+
+size_t getChannelSize(cl_channel_type type) {
+    switch (type) {
+        case CL_SNORM_INT8:
+        case CL_UNORM_INT8:
+        case CL_SIGNED_INT8:
+        case CL_UNSIGNED_INT8: return 1;
+        case CL_SNORM_INT16:
+        case CL_UNORM_INT16:
+        case CL_SIGNED_INT16:
+        case CL_UNSIGNED_INT16:
+        case CL_HALF_FLOAT: return 2;
+        case CL_SIGNED_INT32:
+        case CL_UNSIGNED_INT32:
+        case CL_FLOAT: return 4;
+        default: return 0;
+    }
+}
+
+template <typename T>
+void store(std::byte* destination, T value) {
+    memcpy(destination, &value, sizeof(T));
+}
+
+template <typename T>
+T load(const std::byte* source) {
+    T value;
+    memcpy(&value, source, sizeof(T));
+    return value;
+}
+
+template <typename T>
+T normalize(float value, float scale) {
+    const float low = std::numeric_limits<T>::is_signed ? -1.0f : 0.0f;
+    return static_cast<T>(
+        std::lround(std::clamp(std::isnan(value) ? 0.0f : value, low, 1.0f) *
+                    scale));
+}
+
+template <typename T, typename Source>
+T saturate(Source value) {
+    return static_cast<T>(
+        std::clamp<Source>(value, std::numeric_limits<T>::min(),
+                           std::numeric_limits<T>::max()));
+}
+
+// round to nearest even, overflow to infinity
+uint16_t toHalf(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    const uint16_t sign = (bits >> 16) & 0x8000;
+    const int32_t exponent = static_cast<int32_t>((bits >> 23) & 0xFF) - 127;
+    uint32_t mantissa = bits & 0x7FFFFF;
+
+    if (exponent == 128) {
+        return sign | 0x7C00 | (mantissa ? 0x200 : 0);
+    }
+    if (exponent > 15) {
+        return sign | 0x7C00;
+    }
+    if (exponent < -25) {
+        return sign;
+    }
+
+    uint32_t shift;
+    uint32_t result;
+    if (exponent < -14) {
+        // subnormal half, the implicit bit becomes explicit
+        mantissa |= 0x800000;
+        shift = static_cast<uint32_t>(-exponent - 1);
+        result = 0;
+    } else {
+        shift = 13;
+        result = static_cast<uint32_t>(exponent + 15) << 10;
+    }
+
+    const uint32_t halfway = 1u << (shift - 1);
+    const uint32_t remainder = mantissa & ((1u << shift) - 1);
+    result += mantissa >> shift;
+    if (remainder > halfway || (remainder == halfway && (result & 1))) {
+        // may carry into the exponent, which is still the right result
+        result++;
+    }
+    return sign | static_cast<uint16_t>(result);
+}
+
+float fromHalf(uint16_t half) {
+    const uint32_t sign = static_cast<uint32_t>(half & 0x8000) << 16;
+    const uint32_t exponent = (half >> 10) & 0x1F;
+    const uint32_t mantissa = half & 0x3FF;
+
+    uint32_t bits;
+    if (exponent == 0x1F) {
+        bits = sign | 0x7F800000 | (mantissa << 13);
+    } else if (exponent != 0) {
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    } else {
+        // zero or subnormal, exact in single precision
+        const float magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign ? -magnitude : magnitude;
+    }
+
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+uint32_t floatBits(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+// the word of a channel with value 1
+uint32_t oneBits(const cl_image_format& format) {
+    return isIntegerImageFormat(format) ? 1 : floatBits(1.0f);
+}
+}  // namespace
+
+size_t getImageElementSize(const cl_image_format& format) {
+    const auto components = getChannelComponents(format.image_channel_order);
+    const size_t channelSize = getChannelSize(format.image_channel_data_type);
+    if (!components || !channelSize) {
+        return 0;
+    }
+
+    // channel orders with packed alpha only exist for 8-bit channels
+    if ((format.image_channel_order == CL_BGRA ||
+         format.image_channel_order == CL_ARGB) &&
+        channelSize != 1) {
+        return 0;
+    }
+
+    return components->size() * channelSize;
+}
+
+const std::vector<cl_image_format>& getSupportedImageFormats() {
+    static const std::vector<cl_image_format> formats = []() {
+        std::vector<cl_image_format> result;
+        for (const cl_channel_order order :
+             {CL_R, CL_A, CL_RG, CL_RA, CL_RGBA, CL_BGRA, CL_ARGB}) {
+            for (const cl_channel_type type :
+                 {CL_SNORM_INT8, CL_SNORM_INT16, CL_UNORM_INT8, CL_UNORM_INT16,
+                  CL_SIGNED_INT8, CL_SIGNED_INT16, CL_SIGNED_INT32,
+                  CL_UNSIGNED_INT8, CL_UNSIGNED_INT16, CL_UNSIGNED_INT32,
+                  CL_HALF_FLOAT, CL_FLOAT}) {
+                const cl_image_format format{order, type};
+                if (getImageElementSize(format)) {
+                    result.push_back(format);
+                }
+            }
+        }
+        return result;
+    }();
+    return formats;
+}
+
+void packImageColor(const cl_image_format& format,
+                    const void* color,
+                    std::byte* texel) {
+    const auto& components = *getChannelComponents(format.image_channel_order);
+    const size_t channelSize = getChannelSize(format.image_channel_data_type);
+    const auto floats = static_cast<const float*>(color);
+    const auto ints = static_cast<const int32_t*>(color);
+    const auto uints = static_cast<const uint32_t*>(color);
+
+    for (size_t channel = 0; channel < components.size(); ++channel) {
+        const size_t component = components[channel];
+        std::byte* destination = texel + channel * channelSize;
+
+        switch (format.image_channel_data_type) {
+            case CL_SNORM_INT8:
+                store(destination, normalize<int8_t>(floats[component], 127));
+                break;
+            case CL_SNORM_INT16:
+                store(destination,
+                      normalize<int16_t>(floats[component], 32767));
+                break;
+            case CL_UNORM_INT8:
+                store(destination, normalize<uint8_t>(floats[component], 255));
+                break;
+            case CL_UNORM_INT16:
+                store(destination,
+                      normalize<uint16_t>(floats[component], 65535));
+                break;
+            case CL_SIGNED_INT8:
+                store(destination, saturate<int8_t>(ints[component]));
+                break;
+            case CL_SIGNED_INT16:
+                store(destination, saturate<int16_t>(ints[component]));
+                break;
+            case CL_SIGNED_INT32: store(destination, ints[component]); break;
+            case CL_UNSIGNED_INT8:
+                store(destination, saturate<uint8_t>(uints[component]));
+                break;
+            case CL_UNSIGNED_INT16:
+                store(destination, saturate<uint16_t>(uints[component]));
+                break;
+            case CL_UNSIGNED_INT32: store(destination, uints[component]); break;
+            case CL_HALF_FLOAT:
+                store(destination, toHalf(floats[component]));
+                break;
+            case CL_FLOAT: store(destination, floats[component]); break;
+            default: break;
+        }
+    }
+}
+
+bool isIntegerImageFormat(const cl_image_format& format) {
+    switch (format.image_channel_data_type) {
+        case CL_SIGNED_INT8:
+        case CL_SIGNED_INT16:
+        case CL_SIGNED_INT32:
+        case CL_UNSIGNED_INT8:
+        case CL_UNSIGNED_INT16:
+        case CL_UNSIGNED_INT32: return true;
+        default: return false;
+    }
+}
+
+void unpackImageTexel(const cl_image_format& format,
+                      const std::byte* texel,
+                      uint32_t* channels) {
+    const auto& components = *getChannelComponents(format.image_channel_order);
+    const size_t channelSize = getChannelSize(format.image_channel_data_type);
+
+    channels[0] = channels[1] = channels[2] = 0;
+    channels[3] = oneBits(format);
+
+    for (size_t channel = 0; channel < components.size(); ++channel) {
+        const std::byte* source = texel + channel * channelSize;
+        uint32_t& destination = channels[components[channel]];
+
+        switch (format.image_channel_data_type) {
+            case CL_SNORM_INT8:
+                destination = floatBits(
+                    std::max(load<int8_t>(source) / 127.0f, -1.0f));
+                break;
+            case CL_SNORM_INT16:
+                destination = floatBits(
+                    std::max(load<int16_t>(source) / 32767.0f, -1.0f));
+                break;
+            case CL_UNORM_INT8:
+                destination = floatBits(load<uint8_t>(source) / 255.0f);
+                break;
+            case CL_UNORM_INT16:
+                destination = floatBits(load<uint16_t>(source) / 65535.0f);
+                break;
+            case CL_SIGNED_INT8:
+                destination = static_cast<uint32_t>(
+                    static_cast<int32_t>(load<int8_t>(source)));
+                break;
+            case CL_SIGNED_INT16:
+                destination = static_cast<uint32_t>(
+                    static_cast<int32_t>(load<int16_t>(source)));
+                break;
+            case CL_UNSIGNED_INT8: destination = load<uint8_t>(source); break;
+            case CL_UNSIGNED_INT16: destination = load<uint16_t>(source); break;
+            case CL_SIGNED_INT32:
+            case CL_UNSIGNED_INT32:
+            case CL_FLOAT: destination = load<uint32_t>(source); break;
+            case CL_HALF_FLOAT:
+                destination = floatBits(fromHalf(load<uint16_t>(source)));
+                break;
+            default: break;
+        }
+    }
+}
+
+void getImageBorderColor(const cl_image_format& format, uint32_t* channels) {
+    channels[0] = channels[1] = channels[2] = 0;
+    const auto order = format.image_channel_order;
+    channels[3] = order == CL_R || order == CL_RG ? oneBits(format) : 0;
+}
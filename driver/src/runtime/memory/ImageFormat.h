@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "runtime/icd/icd.h"
+
+/**
+ * @return size of one texel in bytes or 0 if the format is not supported
+ */
+size_t getImageElementSize(const cl_image_format& format);
+
+/**
+ * Every supported channel order combined with every data type it can hold.
+ */
+const std::vector<cl_image_format>& getSupportedImageFormats();
+
+/**
+ * Converts a fill color to a texel of the format: float4 for normalized and
+ * floating point data types, int4 or uint4 for integer ones.
+ *
+ * @param texel getImageElementSize(format) bytes
+ */
+void packImageColor(const cl_image_format& format,
+                    const void* color,
+                    std::byte* texel);
+
+/**
+ * @return true for formats read as int4 or uint4, which can't be filtered
+ */
+bool isIntegerImageFormat(const cl_image_format& format);
+
+/**
+ * Converts a texel to the four channels a kernel reads: floats for
+ * normalized and floating point data types, integers for integer ones.
+ * Missing color channels read as 0 and missing alpha as 1.
+ *
+ * @param channels four words receiving the channel bits
+ */
+void unpackImageTexel(const cl_image_format& format,
+                      const std::byte* texel,
+                      uint32_t* channels);
+
+/**
+ * Color of texels outside the image with CL_ADDRESS_CLAMP: transparent
+ * black, or opaque black for formats without alpha.
+ */
+void getImageBorderColor(const cl_image_format& format, uint32_t* channels);
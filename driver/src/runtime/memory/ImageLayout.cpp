@@ -0,0 +1,201 @@
+#include "ImageLayout.h"
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+namespace {
+// x and y bits of a Morton index within an 8x8 tile
+constexpr uint8_t kMortonX[8] = {0, 1, 4, 5, 16, 17, 20, 21};
+constexpr uint8_t kMortonY[8] = {0, 2, 8, 10, 32, 34, 40, 42};
+
+constexpr auto kLinearX = []() {
+    struct Table {
+        uint8_t values[ImageLayout::kTileTexels];
+    } table{};
+    for (size_t i = 0; i < ImageLayout::kTileTexels; ++i) {
+        table.values[i] = static_cast<uint8_t>(i);
+    }
+    return table;
+}();
+constexpr uint8_t kLinearY[1] = {0};
+
+size_t divideRoundingUp(size_t value, size_t divisor) {
+    return (value + divisor - 1) / divisor;
+}
+
+/**
+ * Calls the function with the element size as a compile-time constant, so
+ * texel copies compile to single vector moves.
+ */
+template <typename Function>
+void dispatchElementSize(size_t elementSize, Function&& function) {
+    switch (elementSize) {
+        case 1: function(std::integral_constant<size_t, 1>()); break;
+        case 2: function(std::integral_constant<size_t, 2>()); break;
+        case 4: function(std::integral_constant<size_t, 4>()); break;
+        case 8: function(std::integral_constant<size_t, 8>()); break;
+        case 16: function(std::integral_constant<size_t, 16>()); break;
+        default: break;
+    }
+}
+}  // namespace
+
+ImageLayout::ImageLayout(size_t elementSize,
+                         size_t width,
+                         size_t height,
+                         size_t depth,
+                         bool tiled2D)
+    : elementSize(elementSize), depth(depth) {
+    if (tiled2D) {
+        xShift = yShift = 3;
+        xMask = yMask = 7;
+        xBits = kMortonX;
+        yBits = kMortonY;
+    } else {
+        xShift = 6;
+        xMask = kTileTexels - 1;
+        yShift = 0;
+        yMask = 0;
+        xBits = kLinearX.values;
+        yBits = kLinearY;
+    }
+
+    tilesPerRow = divideRoundingUp(width, xMask + 1);
+    tilesPerColumn = divideRoundingUp(height, yMask + 1);
+}
+
+size_t ImageLayout::getSize() const {
+    return depth * tilesPerColumn * tilesPerRow * kTileTexels * elementSize;
+}
+
+template <size_t ElementSize, bool ToImage>
+void ImageLayout::copyLinearRows(std::byte* image,
+                                 std::byte* linear,
+                                 const size_t* origin,
+                                 const size_t* region,
+                                 size_t rowPitch,
+                                 size_t slicePitch) const {
+    const bool linearTiles = yMask == 0;
+
+    for (size_t z = 0; z < region[2]; ++z) {
+        for (size_t y = 0; y < region[1]; ++y) {
+            const size_t imageY = origin[1] + y;
+            const size_t imageZ = origin[2] + z;
+            std::byte* linearRow = linear + z * slicePitch + y * rowPitch;
+
+            // row by row of each tile the row crosses
+            for (size_t x = 0; x < region[0];) {
+                const size_t imageX = origin[0] + x;
+                const size_t span =
+                    std::min(region[0] - x, xMask + 1 - (imageX & xMask));
+                const size_t tileRowOffset =
+                    tileOffset(imageX, imageY, imageZ) + yBits[imageY & yMask];
+                std::byte* tileRow = image + tileRowOffset * ElementSize;
+                std::byte* linearTexel = linearRow + x * ElementSize;
+
+                if (linearTiles) {
+                    std::byte* imageTexel =
+                        tileRow + xBits[imageX & xMask] * ElementSize;
+                    if constexpr (ToImage) {
+                        memcpy(imageTexel, linearTexel, span * ElementSize);
+                    } else {
+                        memcpy(linearTexel, imageTexel, span * ElementSize);
+                    }
+                } else {
+                    for (size_t i = 0; i < span; ++i) {
+                        std::byte* imageTexel =
+                            tileRow +
+                            xBits[(imageX + i) & xMask] * ElementSize;
+                        if constexpr (ToImage) {
+                            memcpy(imageTexel, linearTexel, ElementSize);
+                        } else {
+                            memcpy(linearTexel, imageTexel, ElementSize);
+                        }
+                        linearTexel += ElementSize;
+                    }
+                }
+                x += span;
+            }
+        }
+    }
+}
+
+template <bool ToImage>
+void ImageLayout::copyLinear(std::byte* image,
+                             std::byte* linear,
+                             const size_t* origin,
+                             const size_t* region,
+                             size_t rowPitch,
+                             size_t slicePitch) const {
+    dispatchElementSize(elementSize, [&](auto size) {
+        copyLinearRows<decltype(size)::value, ToImage>(
+            image, linear, origin, region, rowPitch, slicePitch);
+    });
+}
+
+void ImageLayout::copyFromLinear(std::byte* image,
+                                 const std::byte* linear,
+                                 const size_t* origin,
+                                 const size_t* region,
+                                 size_t rowPitch,
+                                 size_t slicePitch) const {
+    // the linear side is only read when copying to the image
+    copyLinear<true>(image, const_cast<std::byte*>(linear), origin, region,
+                     rowPitch, slicePitch);
+}
+
+void ImageLayout::copyToLinear(std::byte* linear,
+                               const std::byte* image,
+                               const size_t* origin,
+                               const size_t* region,
+                               size_t rowPitch,
+                               size_t slicePitch) const {
+    // the image side is only read when copying to linear memory
+    copyLinear<false>(const_cast<std::byte*>(image), linear, origin, region,
+                      rowPitch, slicePitch);
+}
+
+void ImageLayout::copy(const ImageLayout& sourceLayout,
+                       const std::byte* source,
+                       const size_t* sourceOrigin,
+                       const ImageLayout& destinationLayout,
+                       std::byte* destination,
+                       const size_t* destinationOrigin,
+                       const size_t* region) {
+    dispatchElementSize(sourceLayout.elementSize, [&](auto size) {
+        constexpr size_t elementSize = decltype(size)::value;
+        for (size_t z = 0; z < region[2]; ++z) {
+            for (size_t y = 0; y < region[1]; ++y) {
+                for (size_t x = 0; x < region[0]; ++x) {
+                    memcpy(destination + destinationLayout.offsetOf(
+                                             destinationOrigin[0] + x,
+                                             destinationOrigin[1] + y,
+                                             destinationOrigin[2] + z),
+                           source + sourceLayout.offsetOf(sourceOrigin[0] + x,
+                                                          sourceOrigin[1] + y,
+                                                          sourceOrigin[2] + z),
+                           elementSize);
+                }
+            }
+        }
+    });
+}
+
+void ImageLayout::fill(std::byte* image,
+                       const std::byte* texel,
+                       const size_t* origin,
+                       const size_t* region) const {
+    dispatchElementSize(elementSize, [&](auto size) {
+        constexpr size_t elementSize = decltype(size)::value;
+        for (size_t z = 0; z < region[2]; ++z) {
+            for (size_t y = 0; y < region[1]; ++y) {
+                for (size_t x = 0; x < region[0]; ++x) {
+                    memcpy(image + offsetOf(origin[0] + x, origin[1] + y,
+                                            origin[2] + z),
+                           texel, elementSize);
+                }
+            }
+        }
+    });
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Storage layout of image texels. Images are split into tiles of 64 texels
+ * stored one after another, row by row of tiles and then slice by slice.
+ *
+ * Tiles of 2D and 3D images are 8x8 texels in Morton order, so texels close
+ * in both dimensions are close in memory. 1D images and arrays of them use
+ * linear tiles of 64x1 texels.
+ */
+class ImageLayout {
+   public:
+    static constexpr size_t kTileTexels = 64;
+
+    ImageLayout() = default;
+
+    /**
+     * @param height rows, or layers of a 1D image array
+     * @param depth slices, or layers of a 2D image array
+     * @param tiled2D false for 1D images and arrays of them
+     */
+    ImageLayout(size_t elementSize,
+                size_t width,
+                size_t height,
+                size_t depth,
+                bool tiled2D);
+
+    size_t getElementSize() const {
+        return elementSize;
+    }
+
+    /**
+     * @return bytes of storage, padded to whole tiles
+     */
+    size_t getSize() const;
+
+    size_t offsetOf(size_t x, size_t y, size_t z) const {
+        return (tileOffset(x, y, z) + xBits[x & xMask] + yBits[y & yMask]) *
+               elementSize;
+    }
+
+    /**
+     * Copies a region between a linear layout and the image, with pointers
+     * at the origin of the region in linear memory and at the image start.
+     *
+     * @param region width, height and depth in texels
+     */
+    void copyFromLinear(std::byte* image,
+                        const std::byte* linear,
+                        const size_t* origin,
+                        const size_t* region,
+                        size_t rowPitch,
+                        size_t slicePitch) const;
+
+    void copyToLinear(std::byte* linear,
+                      const std::byte* image,
+                      const size_t* origin,
+                      const size_t* region,
+                      size_t rowPitch,
+                      size_t slicePitch) const;
+
+    /**
+     * Copies a region between images of the same element size.
+     */
+    static void copy(const ImageLayout& sourceLayout,
+                     const std::byte* source,
+                     const size_t* sourceOrigin,
+                     const ImageLayout& destinationLayout,
+                     std::byte* destination,
+                     const size_t* destinationOrigin,
+                     const size_t* region);
+
+    void fill(std::byte* image,
+              const std::byte* texel,
+              const size_t* origin,
+              const size_t* region) const;
+
+   private:
+    size_t elementSize = 0;
+    size_t depth = 0;
+    size_t tilesPerRow = 0;
+    size_t tilesPerColumn = 0;
+    size_t xShift = 0;
+    size_t xMask = 0;
+    size_t yShift = 0;
+    size_t yMask = 0;
+    // position of a texel in its tile is xBits[x] + yBits[y]
+    const uint8_t* xBits = nullptr;
+    const uint8_t* yBits = nullptr;
+
+    size_t tileOffset(size_t x, size_t y, size_t z) const {
+        return ((z * tilesPerColumn + (y >> yShift)) * tilesPerRow +
+                (x >> xShift)) *
+               kTileTexels;
+    }
+
+    template <size_t ElementSize, bool ToImage>
+    void copyLinearRows(std::byte* image,
+                        std::byte* linear,
+                        const size_t* origin,
+                        const size_t* region,
+                        size_t rowPitch,
+                        size_t slicePitch) const;
+
+    template <bool ToImage>
+    void copyLinear(std::byte* image,
+                    std::byte* linear,
+                    const size_t* origin,
+                    const size_t* region,
+                    size_t rowPitch,
+                    size_t slicePitch) const;
+};
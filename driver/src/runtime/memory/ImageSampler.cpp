@@ -0,0 +1,260 @@
+#include "ImageSampler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+
+#include "ImageFormat.h"
+
+ImageSampler::ImageSampler(const CLMem& image, const CLSampler& sampler)
+    : image(*image.image),
+      address(image.address),
+      normalizedCoords(sampler.normalizedCoords),
+      addressingMode(sampler.addressingMode),
+      linear(sampler.filterMode == CL_FILTER_LINEAR &&
+             !isIntegerImageFormat(this->image.format)) {
+    sizes = {static_cast<int32_t>(this->image.width),
+             static_cast<int32_t>(this->image.height),
+             static_cast<int32_t>(this->image.depth)};
+
+    constexpr auto filtered = AxisKind::Filtered;
+    constexpr auto layer = AxisKind::Layer;
+    constexpr auto unused = AxisKind::Unused;
+    switch (this->image.desc.image_type) {
+        case CL_MEM_OBJECT_IMAGE1D:
+            axisKinds = {filtered, unused, unused};
+            break;
+        case CL_MEM_OBJECT_IMAGE1D_ARRAY:
+            axisKinds = {filtered, layer, unused};
+            break;
+        case CL_MEM_OBJECT_IMAGE2D:
+            axisKinds = {filtered, filtered, unused};
+            break;
+        case CL_MEM_OBJECT_IMAGE2D_ARRAY:
+            axisKinds = {filtered, filtered, layer};
+            break;
+        default: axisKinds = {filtered, filtered, filtered}; break;
+    }
+
+    getImageBorderColor(this->image.format, borderColor.data());
+}
+
+template <cl_addressing_mode Mode, bool Linear>
+void ImageSampler::addressLanes(size_t axis,
+                                const float* coordinates,
+                                Axis& result) const {
+    const int32_t size = sizes[axis];
+    const float scale = normalizedCoords ? static_cast<float>(size) : 1.0f;
+    // keeps the conversion to int defined, texels this far out are clamped
+    // or replaced by the border anyway
+    const float low = -2.0f;
+    const float high = static_cast<float>(size) + 2.0f;
+
+    for (size_t lane = 0; lane < kLanes; ++lane) {
+        const float s = coordinates[lane];
+        float u;
+        if constexpr (Mode == CL_ADDRESS_REPEAT) {
+            u = (s - std::floor(s)) * scale;
+        } else if constexpr (Mode == CL_ADDRESS_MIRRORED_REPEAT) {
+            u = std::fabs(s - 2.0f * std::rint(0.5f * s)) * scale;
+        } else {
+            u = s * scale;
+        }
+        u = std::fmin(std::fmax(u, low), high);
+
+        int32_t first;
+        int32_t second;
+        if constexpr (Linear) {
+            const float t = u - 0.5f;
+            const float whole = std::floor(t);
+            first = static_cast<int32_t>(whole);
+            second = first + 1;
+            result.weight[lane] = t - whole;
+        } else {
+            first = static_cast<int32_t>(std::floor(u));
+            second = first;
+            result.weight[lane] = 0.0f;
+        }
+
+        if constexpr (Mode == CL_ADDRESS_REPEAT) {
+            if constexpr (Linear) {
+                first += first < 0 ? size : 0;
+                second -= second > size - 1 ? size : 0;
+            } else {
+                first = first > size - 1 ? 0 : first;
+                second = first;
+            }
+        } else if constexpr (Mode == CL_ADDRESS_MIRRORED_REPEAT) {
+            first = std::clamp(first, 0, size - 1);
+            second = std::clamp(second, 0, size - 1);
+        } else if constexpr (Mode != CL_ADDRESS_CLAMP) {
+            // CL_ADDRESS_NONE leaves the result undefined, so it is
+            // clamped to the edge as well to stay in bounds
+            first = std::clamp(first, 0, size - 1);
+            second = std::clamp(second, 0, size - 1);
+        }
+
+        result.first[lane] = first;
+        result.second[lane] = second;
+    }
+}
+
+void ImageSampler::addressAxis(size_t axis,
+                               const float* coordinates,
+                               Axis& result) const {
+    if (axisKinds[axis] == AxisKind::Unused) {
+        result.first.fill(0);
+        result.second.fill(0);
+        result.weight.fill(0.0f);
+        return;
+    }
+
+    if (axisKinds[axis] == AxisKind::Layer) {
+        // layers are never filtered and always clamped
+        const float last = static_cast<float>(sizes[axis] - 1);
+        for (size_t lane = 0; lane < kLanes; ++lane) {
+            const float layer =
+                std::fmin(std::fmax(std::rint(coordinates[lane]), 0.0f), last);
+            result.first[lane] = static_cast<int32_t>(layer);
+            result.second[lane] = result.first[lane];
+            result.weight[lane] = 0.0f;
+        }
+        return;
+    }
+
+    const auto dispatch = [&](auto linear) {
+        constexpr bool Linear = decltype(linear)::value;
+        switch (addressingMode) {
+            case CL_ADDRESS_CLAMP:
+                addressLanes<CL_ADDRESS_CLAMP, Linear>(axis, coordinates,
+                                                       result);
+                break;
+            case CL_ADDRESS_REPEAT:
+                addressLanes<CL_ADDRESS_REPEAT, Linear>(axis, coordinates,
+                                                        result);
+                break;
+            case CL_ADDRESS_MIRRORED_REPEAT:
+                addressLanes<CL_ADDRESS_MIRRORED_REPEAT, Linear>(
+                    axis, coordinates, result);
+                break;
+            default:
+                addressLanes<CL_ADDRESS_CLAMP_TO_EDGE, Linear>(
+                    axis, coordinates, result);
+                break;
+        }
+    };
+
+    if (linear) {
+        dispatch(std::true_type());
+    } else {
+        dispatch(std::false_type());
+    }
+}
+
+void ImageSampler::fetch(int32_t x,
+                         int32_t y,
+                         int32_t z,
+                         uint32_t* channels) const {
+    if (x < 0 || x >= sizes[0] || y < 0 || y >= sizes[1] || z < 0 ||
+        z >= sizes[2]) {
+        std::copy(borderColor.begin(), borderColor.end(), channels);
+        return;
+    }
+
+    unpackImageTexel(image.format, address + image.layout.offsetOf(x, y, z),
+                     channels);
+}
+
+void ImageSampler::sample(const Coordinates& coordinates,
+                          uint64_t execMask,
+                          Result& result) const {
+    std::array<Axis, 3> axes;
+    for (size_t axis = 0; axis < 3; ++axis) {
+        addressAxis(axis, coordinates[axis].data(), axes[axis]);
+    }
+
+    const auto isActive = [execMask](size_t lane) {
+        return (execMask >> lane) & 1;
+    };
+
+    if (!linear) {
+        for (size_t lane = 0; lane < kLanes; ++lane) {
+            if (!isActive(lane)) {
+                continue;
+            }
+
+            uint32_t channels[4];
+            fetch(axes[0].first[lane], axes[1].first[lane],
+                  axes[2].first[lane], channels);
+            for (size_t channel = 0; channel < 4; ++channel) {
+                result[channel][lane] = channels[channel];
+            }
+        }
+        return;
+    }
+
+    std::array<std::array<float, kLanes>, 4> sums{};
+    std::array<std::array<float, kLanes>, 4> texels;
+    std::array<float, kLanes> weights;
+
+    // corners of the 2, 4 or 8 texel footprint, bit i selects the second
+    // texel along axis i
+    for (size_t corner = 0; corner < 8; ++corner) {
+        bool used = true;
+        for (size_t axis = 0; axis < 3; ++axis) {
+            used = used && (!((corner >> axis) & 1) ||
+                            axisKinds[axis] == AxisKind::Filtered);
+        }
+        if (!used) {
+            continue;
+        }
+
+        for (size_t lane = 0; lane < kLanes; ++lane) {
+            uint32_t channels[4] = {};
+            if (isActive(lane)) {
+                const auto index = [&](size_t axis) {
+                    return (corner >> axis) & 1 ? axes[axis].second[lane]
+                                                : axes[axis].first[lane];
+                };
+                fetch(index(0), index(1), index(2), channels);
+            }
+            for (size_t channel = 0; channel < 4; ++channel) {
+                memcpy(&texels[channel][lane], &channels[channel],
+                       sizeof(float));
+            }
+        }
+
+        weights.fill(1.0f);
+        for (size_t axis = 0; axis < 3; ++axis) {
+            if (axisKinds[axis] != AxisKind::Filtered) {
+                continue;
+            }
+            const auto& weight = axes[axis].weight;
+            if ((corner >> axis) & 1) {
+                for (size_t lane = 0; lane < kLanes; ++lane) {
+                    weights[lane] *= weight[lane];
+                }
+            } else {
+                for (size_t lane = 0; lane < kLanes; ++lane) {
+                    weights[lane] *= 1.0f - weight[lane];
+                }
+            }
+        }
+
+        for (size_t channel = 0; channel < 4; ++channel) {
+            for (size_t lane = 0; lane < kLanes; ++lane) {
+                sums[channel][lane] += weights[lane] * texels[channel][lane];
+            }
+        }
+    }
+
+    for (size_t lane = 0; lane < kLanes; ++lane) {
+        if (isActive(lane)) {
+            for (size_t channel = 0; channel < 4; ++channel) {
+                memcpy(&result[channel][lane], &sums[channel][lane],
+                       sizeof(float));
+            }
+        }
+    }
+}
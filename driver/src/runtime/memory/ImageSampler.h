@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "runtime/icd/CLMem.h"
+#include "runtime/icd/CLSampler.hpp"
+
+/**
+ * Reads of an image through a sampler for a whole wavefront at once, as
+ * done by an image sample instruction.
+ *
+ * Each stage runs over all lanes before the next one starts: coordinates
+ * are addressed per axis, then texels are fetched one filter footprint
+ * corner at a time and blended. The per-lane loops of the addressing and
+ * blending stages have no branches on the lane, so they vectorize.
+ */
+class ImageSampler {
+   public:
+    static constexpr size_t kLanes = 64;
+
+    // x, y and z of every lane; layers of arrays come after the filtered
+    // axes, as in OpenCL image coordinates
+    using Coordinates = std::array<std::array<float, kLanes>, 3>;
+    // bits of the four channels of every lane: floats for normalized and
+    // floating point formats, integers for integer ones
+    using Result = std::array<std::array<uint32_t, kLanes>, 4>;
+
+    ImageSampler(const CLMem& image, const CLSampler& sampler);
+
+    /**
+     * @param execMask lanes to sample, others are left unchanged
+     */
+    void sample(const Coordinates& coordinates,
+                uint64_t execMask,
+                Result& result) const;
+
+   private:
+    enum class AxisKind { Filtered, Layer, Unused };
+
+    // texel indices around the sample point and the weight of the second
+    struct Axis {
+        std::array<int32_t, kLanes> first;
+        std::array<int32_t, kLanes> second;
+        std::array<float, kLanes> weight;
+    };
+
+    const CLImageProperties& image;
+    const std::byte* const address;
+    const bool normalizedCoords;
+    const cl_addressing_mode addressingMode;
+    // integer formats are never filtered
+    const bool linear;
+    std::array<AxisKind, 3> axisKinds{};
+    std::array<int32_t, 3> sizes{};
+    std::array<uint32_t, 4> borderColor{};
+
+    void addressAxis(size_t axis, const float* coordinates, Axis& result) const;
+
+    template <cl_addressing_mode Mode, bool Linear>
+    void addressLanes(size_t axis,
+                      const float* coordinates,
+                      Axis& result) const;
+
+    void fetch(int32_t x, int32_t y, int32_t z, uint32_t* channels) const;
+};
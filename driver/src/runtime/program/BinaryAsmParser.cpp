@@ -1,153 +1,237 @@
 #include <runtime-commons.h>
-#include <cassert>
-#include <common/utils/common.hpp>
-#include <iostream>
+#include <algorithm>
+#include <cctype>
+#include <exception>
 #include <string>
+#include <vector>
 
 #include "BinaryAsmParser.h"
 #include "KernelArgumentInfoParser.h"
-
-std::unique_ptr<BinaryDisassemblingResult> BinaryAsmParser::parseAsm() {
-    if (alreadyParsed) {
-        return std::make_unique<BinaryDisassemblingResult>(parsingResult);
+#include "command/ParallelCopy.h"
+
+namespace {
+std::string_view trim(std::string_view line) {
+    const auto isSpace = [](char ch) {
+        return std::isspace(static_cast<unsigned char>(ch));
+    };
+
+    size_t begin = 0;
+    size_t end = line.size();
+    while (begin < end && isSpace(line[begin])) {
+        ++begin;
     }
+    while (end > begin && isSpace(line[end - 1])) {
+        --end;
+    }
+    return line.substr(begin, end - begin);
+}
 
-    auto lines = utils::splitMap<std::string>(*input, '\n', -1, [](auto line) {
-        utils::trimInplace(line);
-        return line;
-    });
-
-    std::string parameters;
+bool startsWith(std::string_view line, std::string_view prefix) {
+    return line.substr(0, prefix.size()) == prefix;
+}
 
-    for (const auto& line : lines) {
-        if (line.empty()) {
-            continue;
-        }
+// first word of a line and the rest after the space following it
+struct SplitLine {
+    std::string_view name;
+    std::string_view value;
+    bool hasValue;
+};
+
+SplitLine splitLine(std::string_view line) {
+    const auto space = line.find(' ');
+    if (space == std::string_view::npos) {
+        return {line, {}, false};
+    }
+    return {line.substr(0, space), line.substr(space + 1), true};
+}
 
-        std::vector<std::string> splitLine;
-        if (parsingState == KernelInstructions &&
-            utils::startsWith(line, "/*")) {
-            splitLine = utils::split(line, ' ', 2);
+bool isKernelStart(const SplitLine& line) {
+    return line.hasValue && startsWith(line.name, ".kernel");
+}
 
-        } else {
-            splitLine = utils::split(line, ' ', 1);
+/**
+ * Calls body with every non-empty trimmed line of text, the offset where
+ * the line begins and the offset just past it.
+ */
+template <typename Body>
+void forEachLine(std::string_view text, Body body) {
+    size_t begin = 0;
+    while (begin < text.size()) {
+        auto end = text.find('\n', begin);
+        if (end == std::string_view::npos) {
+            end = text.size();
         }
 
-        if (splitLine.size() == 1) {
-            parseSingleInstruction(splitLine[0]);
-
-        } else if (splitLine.size() == 2) {
-            parseParameter(line, splitLine[0], splitLine[1]);
-
-        } else {
-            parseKernelInstruction(line, splitLine[0], splitLine[1],
-                                   splitLine[2]);
+        const auto line = trim(text.substr(begin, end - begin));
+        if (!line.empty()) {
+            body(line, begin, std::min(end + 1, text.size()));
         }
+        begin = end + 1;
     }
-
-    if (currentKernelBuilder) {
-        parsingResult.kernels.push_back(currentKernelBuilder->build());
+}
+}  // namespace
+
+LazyKernel::LazyKernel(std::string name,
+                       std::shared_ptr<const std::string> disassembly,
+                       size_t begin,
+                       size_t end,
+                       bool startsInConfig)
+    : name(std::move(name)),
+      disassembly(std::move(disassembly)),
+      begin(begin),
+      end(end),
+      startsInConfig(startsInConfig) {}
+
+std::shared_ptr<const KernelDefinition> LazyKernel::get() {
+    if (!parsed.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(parseMutex);
+        if (!parsed.load(std::memory_order_relaxed)) {
+            definition = parse();
+            parsed.store(true, std::memory_order_release);
+        }
     }
+    return definition;
+}
 
-    alreadyParsed = true;
-
-    return std::make_unique<BinaryDisassemblingResult>(parsingResult);
+bool LazyKernel::isParsed() const {
+    return parsed.load(std::memory_order_acquire);
 }
 
-void BinaryAsmParser::parseSingleInstruction(const std::string& instruction) {
-    if (instruction == ".config") {
-        parsingState = KernelConfig;
+void LazyKernel::parseAll(
+    const std::vector<std::shared_ptr<LazyKernel>>& kernels) {
+    if (kernels.empty()) {
         return;
     }
 
-    if (instruction == ".text") {
-        parsingState = KernelInstructions;
-        return;
+    std::vector<std::exception_ptr> errors(kernels.size());
+    runInChunks(kernels.size(), 1, [&](size_t offset, size_t length) {
+        for (size_t i = offset; i < offset + length; ++i) {
+            try {
+                kernels[i]->get();
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        }
+    });
+
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
     }
+}
 
-    switch (parsingState) {
-        case BinaryParameters: {
-            assert(currentKernelBuilder == nullptr);
-            parseBinaryParameter(instruction, instruction, "");
-            break;
+std::shared_ptr<const KernelDefinition> LazyKernel::parse() const {
+    CLKernelBuilder builder;
+    builder.name = name;
+    bool inConfig = startsInConfig;
+
+    const std::string_view text = *disassembly;
+    const auto section = begin < end ? text.substr(begin, end - begin)
+                                     : std::string_view();
+
+    forEachLine(section, [&](std::string_view line, size_t, size_t) {
+        if (line == ".config") {
+            inConfig = true;
+            return;
         }
 
-        case KernelConfig: {
-            assert(currentKernelBuilder != nullptr);
-            parseKernelConfigParameter(instruction, instruction, "");
-            break;
+        if (line == ".text") {
+            inConfig = false;
+            return;
         }
 
-        case KernelInstructions: {
-            assert(currentKernelBuilder != nullptr);
-            parseKernelInstruction(instruction, "", instruction, "");
-            break;
+        const auto split = splitLine(line);
+
+        if (inConfig) {
+            if (split.hasValue && split.name == ".arg") {
+                if (startsWith(split.value, "_")) {
+                    // global offsets and runtime pointers, all 64-bit
+                    builder.hiddenArgumentsSize += sizeof(uint64_t);
+                } else {
+                    auto parser = KernelArgumentInfoParser(
+                        builder.argumentInfo.size(), std::string(split.value));
+                    builder.argumentInfo.push_back(parser.parse());
+                }
+            }
+            builder.config.emplace_back(line);
+            return;
         }
-    }
-}
 
-void BinaryAsmParser::parseParameter(const std::string& line,
-                                     const std::string& parameterName,
-                                     const std::string& parameterValue) {
-    if (utils::startsWith(parameterName, ".kernel")) {
-        if (currentKernelBuilder) {
-            parsingResult.kernels.push_back(currentKernelBuilder->build());
+        if (split.hasValue && !startsWith(line, "/*")) {
+            kLogger.warn(
+                "Got instruction without address while parsing kernel "
+                "instructions: " +
+                std::string(line));
         }
+        // TODO: labels are kept as instructions
+        builder.instructions.emplace_back(line);
+    });
 
-        currentKernelBuilder = std::make_unique<CLKernelBuilder>();
-        currentKernelBuilder->name = parameterValue;
-        return;
+    return builder.build();
+}
+
+std::unique_ptr<BinaryDisassemblingResult> BinaryAsmParser::parseAsm() {
+    if (alreadyParsed) {
+        return std::make_unique<BinaryDisassemblingResult>(parsingResult);
     }
 
-    switch (parsingState) {
-        case BinaryParameters: {
-            assert(currentKernelBuilder == nullptr);
-            parseBinaryParameter(line, parameterName, parameterValue);
-            break;
+    const std::string_view text = *input;
+    ParsingState state = BinaryParameters;
+
+    // binary parameters are parsed here, kernels are only delimited: a
+    // kernel's lines start once it leaves the binary parameters state
+    struct Section {
+        std::string_view name;
+        ParsingState initialState;
+        size_t begin;
+        size_t end;
+    };
+    std::vector<Section> sections;
+
+    forEachLine(text, [&](std::string_view line, size_t begin, size_t next) {
+        const auto split = splitLine(line);
+
+        if (isKernelStart(split)) {
+            if (!sections.empty()) {
+                sections.back().end = begin;
+            }
+            const auto sectionBegin =
+                state == BinaryParameters ? text.size() : next;
+            sections.push_back({split.value, state, sectionBegin, text.size()});
+            return;
         }
 
-        case KernelConfig: {
-            assert(currentKernelBuilder != nullptr);
-            parseKernelConfigParameter(line, parameterName, parameterValue);
-            break;
+        const auto previousState = state;
+        if (line == ".config") {
+            state = KernelConfig;
+        } else if (line == ".text") {
+            state = KernelInstructions;
+        } else if (state == BinaryParameters) {
+            parseBinaryParameter(line, split.name, split.value);
         }
 
-        case KernelInstructions: {
-            assert(currentKernelBuilder != nullptr);
-            if (utils::startsWith(line, "/*")) {
-                parseKernelInstruction(line, parameterName, parameterValue, "");
-            } else {
-                kLogger.warn(
-                    "Got instruction without address while parsing kernel "
-                    "instructions: " +
-                    line);
-                parseKernelInstruction(line, "/*unknown*/", parameterName,
-                                       parameterValue);
-            }
+        if (previousState == BinaryParameters && state != BinaryParameters &&
+            !sections.empty()) {
+            sections.back().initialState = state;
+            sections.back().begin = begin;
         }
-    }
-}
+    });
 
-void BinaryAsmParser::parseKernelInstruction(const std::string& line,
-                                             const std::string& address,
-                                             const std::string& instruction,
-                                             const std::string& values) {
-    if (instruction[0] == '.') {
-        // TODO: this is label
-        currentKernelBuilder->instructions.push_back(line);
-        return;
+    for (const auto& section : sections) {
+        parsingResult.kernels.push_back(std::make_shared<LazyKernel>(
+            std::string(section.name), input, section.begin, section.end,
+            section.initialState == KernelConfig));
     }
 
-    assert(utils::startsWith(address, "/*"));
-    assert(utils::endsWith(address, "*/"));
-    const auto addressValue = address.substr(2, address.size() - 4);
-    currentKernelBuilder->instructions.push_back(line);
-}
+    alreadyParsed = true;
 
-void BinaryAsmParser::parseBinaryParameter(const std::string& line,
-                                           const std::string& parameterName,
-                                           const std::string& parameterValue) {
+    return std::make_unique<BinaryDisassemblingResult>(parsingResult);
+}
 
+void BinaryAsmParser::parseBinaryParameter(std::string_view line,
+                                           std::string_view parameterName,
+                                           std::string_view parameterValue) {
     if (parameterName == ".gpu") {
         parsingResult.gpuName = parameterValue;
 
@@ -155,24 +239,6 @@ void BinaryAsmParser::parseBinaryParameter(const std::string& line,
         parsingResult.compileOptions = parameterValue;
 
     } else {
-        parsingResult.parameters.push_back(line);
-    }
-}
-
-void BinaryAsmParser::parseKernelConfigParameter(
-    const std::string& line,
-    const std::string& parameterName,
-    const std::string& parameterValue) {
-    if (parameterName == ".arg" && !utils::startsWith(parameterValue, "_")) {
-        parseKernelArgument(parameterValue);
+        parsingResult.parameters.emplace_back(line);
     }
-
-    currentKernelBuilder->config.push_back(line);
-}
-
-void BinaryAsmParser::parseKernelArgument(
-    const std::string& argumentConfigLine) {
-    auto parser = KernelArgumentInfoParser(
-        currentKernelBuilder->argumentInfo.size(), argumentConfigLine);
-    currentKernelBuilder->argumentInfo.push_back(parser.parse());
 }
@@ -1,18 +1,79 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <utility>
+#include <vector>
 
 #include "runtime/icd/kernel/CLKernel.h"
 
+/**
+ * Kernel of a program, parsed from its part of the disassembly on first
+ * use. Parsing is thread-safe and happens once; if it fails, the error is
+ * thrown to the caller and the next call tries again. Kernel objects are
+ * created from the parsed definition, so each has its own arguments.
+ */
+class LazyKernel {
+   public:
+    /**
+     * @param begin offset of the kernel's first line after its .kernel line
+     * @param end offset just past its last line
+     * @param startsInConfig whether its first lines are config ones rather
+     * than instructions
+     */
+    LazyKernel(std::string name,
+               std::shared_ptr<const std::string> disassembly,
+               size_t begin,
+               size_t end,
+               bool startsInConfig);
+
+    /**
+     * @throws KernelArgumentInfoParseError if an argument is malformed
+     */
+    std::shared_ptr<const KernelDefinition> get();
+
+    [[nodiscard]] bool isParsed() const;
+
+    /**
+     * Parses kernels not parsed yet in parallel on the worker pool.
+     *
+     * @throws KernelArgumentInfoParseError if an argument is malformed
+     */
+    static void parseAll(
+        const std::vector<std::shared_ptr<LazyKernel>>& kernels);
+
+    const std::string name;
+    const std::shared_ptr<const std::string> disassembly;
+    const size_t begin;
+    const size_t end;
+    const bool startsInConfig;
+
+   private:
+    // not std::call_once, which may never run again after the first call
+    // throws with some libstdc++ and sanitizer builds
+    std::mutex parseMutex;
+    std::atomic<bool> parsed{false};
+    // written once under parseMutex
+    std::shared_ptr<const KernelDefinition> definition;
+
+    [[nodiscard]] std::shared_ptr<const KernelDefinition> parse() const;
+};
+
 struct BinaryDisassemblingResult {
     std::string gpuName;
     std::string compileOptions;
     std::vector<std::string> parameters{};
-    std::vector<CLKernel*> kernels = std::vector<CLKernel*>();
+    // in the order of the binary, copies of a result share them
+    std::vector<std::shared_ptr<LazyKernel>> kernels{};
 };
 
+/**
+ * Parses CLRX disassembly. The input is scanned once for binary parameters
+ * and kernel boundaries, kernels themselves are parsed on first use.
+ */
 class BinaryAsmParser {
    public:
     explicit BinaryAsmParser(std::shared_ptr<std::string> input)
@@ -23,33 +84,13 @@ class BinaryAsmParser {
    private:
     enum ParsingState { BinaryParameters, KernelConfig, KernelInstructions };
 
-    void parseSingleInstruction(const std::string& instruction);
-
-    void parseParameter(const std::string& line,
-                        const std::string& parameterName,
-                        const std::string& parameterValue);
-
-    void parseBinaryParameter(const std::string& line,
-                              const std::string& parameterName,
-                              const std::string& parameterValue);
-
-    void parseKernelConfigParameter(const std::string& line,
-                                    const std::string& parameterName,
-                                    const std::string& parameterValue);
-
-    void parseKernelArgument(const std::string& argumentConfigLine);
-
-    void parseKernelInstruction(const std::string& line,
-                                const std::string& address,
-                                const std::string& instruction,
-                                const std::string& values);
+    void parseBinaryParameter(std::string_view line,
+                              std::string_view parameterName,
+                              std::string_view parameterValue);
 
     const std::shared_ptr<std::string> input;
 
     bool alreadyParsed = false;
 
     BinaryDisassemblingResult parsingResult{};
-    ParsingState parsingState = BinaryParameters;
-
-    std::unique_ptr<CLKernelBuilder> currentKernelBuilder = nullptr;
 };
@@ -0,0 +1,345 @@
+#include "ProgramCache.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "BinaryAsmParser.h"
+#include "runtime/runtime-commons.h"
+
+namespace {
+constexpr char kMagic[8] = {'R', 'O', 'L', 'P', 'R', 'O', 'G', '\0'};
+
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t key;
+    uint64_t binarySize;
+    uint64_t payloadSize;
+    uint64_t checksum;
+};
+
+std::string directoryFromEnvironment() {
+    const char* mode = std::getenv("RED_O_LATOR_PROGRAM_CACHE");
+    if (mode && std::string(mode) == "off") {
+        return "";
+    }
+
+    const char* cacheHome = std::getenv("XDG_CACHE_HOME");
+    if (cacheHome && cacheHome[0] == '/') {
+        return std::string(cacheHome) + "/red-o-lator/programs";
+    }
+
+    const char* home = std::getenv("HOME");
+    if (home && home[0] == '/') {
+        return std::string(home) + "/.cache/red-o-lator/programs";
+    }
+
+    return "";
+}
+
+void writeU32(std::string& out, uint32_t value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void writeU64(std::string& out, uint64_t value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void writeString(std::string& out, const std::string& value) {
+    writeU32(out, static_cast<uint32_t>(value.size()));
+    out.append(value);
+}
+
+void writeStrings(std::string& out, const std::vector<std::string>& values) {
+    writeU32(out, static_cast<uint32_t>(values.size()));
+    for (const auto& value : values) {
+        writeString(out, value);
+    }
+}
+
+// every read checks the bounds, so a truncated or corrupted payload that
+// slipped past the checksum fails instead of reading out of the mapping
+class PayloadReader {
+   public:
+    PayloadReader(const std::byte* begin, size_t size)
+        : position(begin), end(begin + size) {}
+
+    bool readU32(uint32_t& value) {
+        if (static_cast<size_t>(end - position) < sizeof(value)) {
+            return false;
+        }
+        memcpy(&value, position, sizeof(value));
+        position += sizeof(value);
+        return true;
+    }
+
+    bool readU64(uint64_t& value) {
+        if (static_cast<size_t>(end - position) < sizeof(value)) {
+            return false;
+        }
+        memcpy(&value, position, sizeof(value));
+        position += sizeof(value);
+        return true;
+    }
+
+    bool readString(std::string& value) {
+        uint32_t size;
+        if (!readU32(size) || static_cast<size_t>(end - position) < size) {
+            return false;
+        }
+        value.assign(reinterpret_cast<const char*>(position), size);
+        position += size;
+        return true;
+    }
+
+    bool readStrings(std::vector<std::string>& values) {
+        uint32_t count;
+        if (!readU32(count)) {
+            return false;
+        }
+        values.clear();
+        for (uint32_t i = 0; i < count; ++i) {
+            std::string value;
+            if (!readString(value)) {
+                return false;
+            }
+            values.push_back(std::move(value));
+        }
+        return true;
+    }
+
+    [[nodiscard]] bool atEnd() const { return position == end; }
+
+   private:
+    const std::byte* position;
+    const std::byte* const end;
+};
+
+class MappedFile {
+   public:
+    explicit MappedFile(const std::string& path) {
+        const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return;
+        }
+
+        struct stat status {};
+        if (fstat(fd, &status) == 0 && status.st_size > 0) {
+            void* mapping = mmap(nullptr, status.st_size, PROT_READ,
+                                 MAP_PRIVATE, fd, 0);
+            if (mapping != MAP_FAILED) {
+                data = static_cast<const std::byte*>(mapping);
+                size = status.st_size;
+            }
+        }
+        close(fd);
+    }
+
+    ~MappedFile() {
+        if (data) {
+            munmap(const_cast<std::byte*>(data), size);
+        }
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const std::byte* data = nullptr;
+    size_t size = 0;
+};
+
+std::shared_ptr<LazyKernel> readKernel(
+    PayloadReader& reader,
+    const std::shared_ptr<const std::string>& disassembly) {
+    std::string name;
+    uint64_t begin;
+    uint64_t end;
+    uint32_t startsInConfig;
+    if (!reader.readString(name) || !reader.readU64(begin) ||
+        !reader.readU64(end) || !reader.readU32(startsInConfig) ||
+        begin > disassembly->size() || end > disassembly->size()) {
+        return nullptr;
+    }
+
+    return std::make_shared<LazyKernel>(std::move(name), disassembly, begin,
+                                        end, startsInConfig != 0);
+}
+}  // namespace
+
+uint64_t ProgramCache::hash(const void* data, size_t size, uint64_t seed) {
+    const auto bytes = static_cast<const unsigned char*>(data);
+    uint64_t result = seed;
+    for (size_t i = 0; i < size; ++i) {
+        result ^= bytes[i];
+        result *= 0x100000001b3ull;
+    }
+    return result;
+}
+
+ProgramCache::ProgramCache() : ProgramCache(directoryFromEnvironment()) {}
+
+ProgramCache::ProgramCache(std::string directory)
+    : directory(std::move(directory)) {}
+
+bool ProgramCache::isEnabled() const {
+    return !directory.empty();
+}
+
+uint64_t ProgramCache::keyOf(size_t binarySize,
+                             const std::byte* binary) const {
+    const auto deviceFingerprint = kDeviceConfigurationParser.fingerprint();
+    const auto seed = hash(&deviceFingerprint, sizeof(deviceFingerprint));
+    return hash(binary, binarySize, seed);
+}
+
+std::string ProgramCache::pathOf(uint64_t key) const {
+    std::stringstream name;
+    name << std::hex;
+    name.width(16);
+    name.fill('0');
+    name << key;
+    return directory + "/" + name.str() + ".bin";
+}
+
+std::unique_ptr<BinaryDisassemblingResult> ProgramCache::load(
+    uint64_t key, size_t binarySize, const std::byte* binary) const {
+    if (!isEnabled()) {
+        return nullptr;
+    }
+
+    const MappedFile file(pathOf(key));
+    if (!file.data || file.size < sizeof(Header)) {
+        return nullptr;
+    }
+
+    Header header{};
+    memcpy(&header, file.data, sizeof(header));
+    const auto payload = file.data + sizeof(header);
+    if (memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+        header.version != kFormatVersion || header.key != key ||
+        header.payloadSize != file.size - sizeof(header) ||
+        header.binarySize > header.payloadSize ||
+        header.checksum != hash(payload, header.payloadSize)) {
+        kLogger.warn("Ignoring invalid program cache entry " + pathOf(key));
+        return nullptr;
+    }
+
+    if (header.binarySize != binarySize ||
+        (binarySize && memcmp(payload, binary, binarySize) != 0)) {
+        kLogger.warn("Ignoring program cache entry of another binary " +
+                     pathOf(key));
+        return nullptr;
+    }
+
+    auto result = std::make_unique<BinaryDisassemblingResult>();
+    auto disassembly = std::make_shared<std::string>();
+    PayloadReader reader(payload + binarySize,
+                         header.payloadSize - binarySize);
+    uint32_t kernelCount = 0;
+
+    bool valid = reader.readString(result->gpuName) &&
+                 reader.readString(result->compileOptions) &&
+                 reader.readStrings(result->parameters) &&
+                 reader.readString(*disassembly) &&
+                 reader.readU32(kernelCount);
+    for (uint32_t i = 0; valid && i < kernelCount; ++i) {
+        auto kernel = readKernel(reader, disassembly);
+        valid = kernel != nullptr;
+        result->kernels.push_back(std::move(kernel));
+    }
+
+    if (!valid || !reader.atEnd()) {
+        kLogger.warn("Ignoring malformed program cache entry " + pathOf(key));
+        return nullptr;
+    }
+
+    return result;
+}
+
+void ProgramCache::store(uint64_t key,
+                         size_t binarySize,
+                         const std::byte* binary,
+                         const BinaryDisassemblingResult& result) const {
+    if (!isEnabled()) {
+        return;
+    }
+
+    // kernels of a result always share one disassembly
+    static const std::string kEmpty;
+    const auto& disassembly = result.kernels.empty()
+                                  ? kEmpty
+                                  : *result.kernels.front()->disassembly;
+    if (disassembly.size() > UINT32_MAX) {
+        return;
+    }
+
+    std::string payload(reinterpret_cast<const char*>(binary), binarySize);
+    writeString(payload, result.gpuName);
+    writeString(payload, result.compileOptions);
+    writeStrings(payload, result.parameters);
+    writeString(payload, disassembly);
+    writeU32(payload, static_cast<uint32_t>(result.kernels.size()));
+    for (const auto& kernel : result.kernels) {
+        writeString(payload, kernel->name);
+        writeU64(payload, kernel->begin);
+        writeU64(payload, kernel->end);
+        writeU32(payload, kernel->startsInConfig);
+    }
+
+    Header header{};
+    memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kFormatVersion;
+    header.key = key;
+    header.binarySize = binarySize;
+    header.payloadSize = payload.size();
+    header.checksum = hash(payload.data(), payload.size());
+
+    const auto path = pathOf(key);
+    // written aside and renamed, so concurrent readers and writers of the
+    // same entry only ever see a complete file
+    const auto threadId =
+        std::hash<std::thread::id>()(std::this_thread::get_id());
+    const auto temporaryPath = path + "." + std::to_string(getpid()) + "." +
+                               std::to_string(threadId);
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+        kLogger.warn("Failed to create program cache directory " + directory +
+                     ": " + error.message());
+        return;
+    }
+
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(payload.data(), payload.size());
+        if (!file) {
+            kLogger.warn("Failed to write program cache entry " +
+                         temporaryPath);
+            file.close();
+            std::filesystem::remove(temporaryPath, error);
+            return;
+        }
+    }
+
+    std::filesystem::rename(temporaryPath, path, error);
+    if (error) {
+        kLogger.warn("Failed to store program cache entry " + path + ": " +
+                     error.message());
+        std::filesystem::remove(temporaryPath, error);
+    }
+}
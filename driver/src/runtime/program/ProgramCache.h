@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+struct BinaryDisassemblingResult;
+
+/**
+ * Persistent cache of disassembled program binaries, so creating the same
+ * program again skips CLRX and the assembly parser.
+ *
+ * Entries are files named by a hash of the binary and of the device
+ * configuration. An entry is a fixed header (magic, format version, key,
+ * binary size, payload size and checksum) followed by the payload: the
+ * binary itself, binary parameters, the disassembly and, for every kernel,
+ * its name and where its lines are in the disassembly, in host byte order.
+ * The hash only finds an entry, which is used only for the binary stored
+ * in it, so colliding binaries never get each other's kernels. Kernels are
+ * parsed on first use as usual. Entries are mapped read-only and rejected
+ * on any mismatch, in which case the binary is disassembled again and the
+ * entry rewritten.
+ *
+ * Entries live in $XDG_CACHE_HOME/red-o-lator/programs, or
+ * ~/.cache/red-o-lator/programs when it is not set. Setting the
+ * RED_O_LATOR_PROGRAM_CACHE environment variable to "off" disables the
+ * cache.
+ */
+class ProgramCache {
+   public:
+    static constexpr uint32_t kFormatVersion = 3;
+    static constexpr uint64_t kHashSeed = 0xcbf29ce484222325ull;
+
+    /**
+     * 64-bit FNV-1a of data, continuing from seed.
+     */
+    static uint64_t hash(const void* data,
+                         size_t size,
+                         uint64_t seed = kHashSeed);
+
+    ProgramCache();
+
+    /**
+     * @param directory where entries are kept, empty disables the cache
+     */
+    explicit ProgramCache(std::string directory);
+
+    [[nodiscard]] bool isEnabled() const;
+
+    [[nodiscard]] uint64_t keyOf(size_t binarySize,
+                                 const std::byte* binary) const;
+
+    /**
+     * @return nullptr if there is no valid entry of the binary for the key
+     */
+    [[nodiscard]] std::unique_ptr<BinaryDisassemblingResult> load(
+        uint64_t key, size_t binarySize, const std::byte* binary) const;
+
+    /**
+     * Failures are logged and otherwise ignored, the cache is best effort.
+     */
+    void store(uint64_t key,
+               size_t binarySize,
+               const std::byte* binary,
+               const BinaryDisassemblingResult& result) const;
+
+   private:
+    const std::string directory;
+
+    [[nodiscard]] std::string pathOf(uint64_t key) const;
+};
@@ -17,19 +17,6 @@ clCreateCommandQueue(cl_context context,
         SET_ERROR_AND_RETURN(CL_INVALID_DEVICE, "Device is null or not valid.");
     }
 
-    if (properties & CL_QUEUE_PROFILING_ENABLE) {
-        // TODO(clCreateCommandQueue): profiling support
-        SET_ERROR_AND_RETURN(CL_INVALID_QUEUE_PROPERTIES,
-                             "Profiling is not supported yet.");
-    }
-
-    if (properties & CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE) {
-        // TODO(clCreateCommandQueue): out-of-order exec support
-        SET_ERROR_AND_RETURN(
-            CL_INVALID_QUEUE_PROPERTIES,
-            "Out-of-order execution mode is not supported yet.");
-    }
-
     const auto commandQueue =
         new CLCommandQueue(kDispatchTable, context, properties);
 
@@ -43,13 +30,19 @@ CL_API_ENTRY cl_int CL_API_CALL clFinish(cl_command_queue command_queue) {
         RETURN_ERROR(CL_INVALID_COMMAND_QUEUE, "Command queue is null.");
     }
 
-    command_queue->flush();
+    command_queue->finish();
 
     return CL_SUCCESS;
 }
 
 CL_API_ENTRY cl_int CL_API_CALL clFlush(cl_command_queue command_queue) {
-    return clFinish(command_queue);
+    if (!command_queue) {
+        RETURN_ERROR(CL_INVALID_COMMAND_QUEUE, "Command queue is null.");
+    }
+
+    command_queue->flush();
+
+    return CL_SUCCESS;
 }
 
 CL_API_ENTRY cl_int CL_API_CALL
@@ -1,15 +1,25 @@
-#include <iostream>
-
-#include "icd/icd.h"
+#include "icd/CLCommandQueue.h"
+#include "runtime-commons.h"
 
 CL_API_ENTRY cl_int CL_API_CALL
 clEnqueueMarkerWithWaitList(cl_command_queue command_queue,
                             cl_uint num_events_in_wait_list,
                             const cl_event* event_wait_list,
                             cl_event* event) {
-    std::cerr << "Unimplemented OpenCL API call: clEnqueueMarkerWithWaitList"
-              << std::endl;
-    return CL_INVALID_PLATFORM;
+    if (!command_queue) {
+        RETURN_ERROR(CL_INVALID_COMMAND_QUEUE, "Command queue is null.");
+    }
+
+    const auto waitListError = checkEventWaitList(
+        command_queue->context, num_events_in_wait_list, event_wait_list);
+    if (waitListError != CL_SUCCESS) {
+        return waitListError;
+    }
+
+    command_queue->enqueueMarker(num_events_in_wait_list, event_wait_list,
+                                 event);
+
+    return CL_SUCCESS;
 }
 
 CL_API_ENTRY cl_int CL_API_CALL
@@ -17,29 +27,44 @@ clEnqueueBarrierWithWaitList(cl_command_queue command_queue,
                              cl_uint num_events_in_wait_list,
                              const cl_event* event_wait_list,
                              cl_event* event) {
-    std::cerr << "Unimplemented OpenCL API call: clEnqueueBarrierWithWaitList"
-              << std::endl;
-    return CL_INVALID_PLATFORM;
-}
+    if (!command_queue) {
+        RETURN_ERROR(CL_INVALID_COMMAND_QUEUE, "Command queue is null.");
+    }
 
+    const auto waitListError = checkEventWaitList(
+        command_queue->context, num_events_in_wait_list, event_wait_list);
+    if (waitListError != CL_SUCCESS) {
+        return waitListError;
+    }
+
+    command_queue->enqueueBarrier(num_events_in_wait_list, event_wait_list,
+                                  event);
+
+    return CL_SUCCESS;
+}
 
 CL_API_ENTRY cl_int CL_API_CALL
 clEnqueueMarker(cl_command_queue command_queue, cl_event* event) {
-    std::cerr << "Unimplemented OpenCL API call: clEnqueueMarker" << std::endl;
-    return CL_INVALID_PLATFORM;
+    if (!event) {
+        RETURN_ERROR(CL_INVALID_VALUE, "Event is null.");
+    }
+
+    return clEnqueueMarkerWithWaitList(command_queue, 0, nullptr, event);
 }
 
 CL_API_ENTRY cl_int CL_API_CALL
 clEnqueueWaitForEvents(cl_command_queue command_queue,
                        cl_uint num_events,
                        const cl_event* event_list) {
-    std::cerr << "Unimplemented OpenCL API call: clEnqueueWaitForEvents"
-              << std::endl;
-    return CL_INVALID_PLATFORM;
+    if (num_events == 0 || !event_list) {
+        RETURN_ERROR(CL_INVALID_VALUE, "Event list is empty.");
+    }
+
+    return clEnqueueBarrierWithWaitList(command_queue, num_events, event_list,
+                                        nullptr);
 }
 
 CL_API_ENTRY cl_int CL_API_CALL
 clEnqueueBarrier(cl_command_queue command_queue) {
-    std::cerr << "Unimplemented OpenCL API call: clEnqueueBarrier" << std::endl;
-    return CL_INVALID_PLATFORM;
+    return clEnqueueBarrierWithWaitList(command_queue, 0, nullptr, nullptr);
 }
@@ -1,5 +1,7 @@
 #include "runtime-commons.h"
 
+#include "icd/CLEvent.h"
+
 Logger kLogger = Logger("[red-o-lator driver]");  // NOLINT(cert-err58-cpp)
 
 IcdDispatchTable* kDispatchTable =  // NOLINT(cert-err58-cpp)
@@ -11,6 +13,14 @@ DeviceConfigurationParser kDeviceConfigurationParser =
 CLPlatformId* kPlatform = nullptr;
 CLDeviceId* kDevice = nullptr;
 
+WorkerPool kWorkerPool = WorkerPool();  // NOLINT(cert-err58-cpp)
+WorkerPool kEventCallbackPool = WorkerPool(1);  // NOLINT(cert-err58-cpp)
+
+DeviceMemoryAllocator kDeviceMemoryAllocator =  // NOLINT(cert-err58-cpp)
+    DeviceMemoryAllocator();
+
+ProgramCache kProgramCache = ProgramCache();  // NOLINT(cert-err58-cpp)
+
 cl_int getParamInfo(
     cl_uint param_name,
     size_t param_value_size,
@@ -60,6 +70,31 @@ cl_int getParamInfo(
     return CL_SUCCESS;
 }
 
+cl_int checkEventWaitList(cl_context context,
+                          cl_uint num_events_in_wait_list,
+                          const cl_event* event_wait_list) {
+    if ((num_events_in_wait_list == 0) != (event_wait_list == nullptr)) {
+        RETURN_ERROR(CL_INVALID_EVENT_WAIT_LIST,
+                     "Event wait list does not match its size.");
+    }
+
+    for (cl_uint i = 0; i < num_events_in_wait_list; ++i) {
+        if (!event_wait_list[i]) {
+            RETURN_ERROR(CL_INVALID_EVENT_WAIT_LIST,
+                         "Event " + std::to_string(i) +
+                             " of wait list is null.");
+        }
+
+        if (event_wait_list[i]->context != context) {
+            RETURN_ERROR(CL_INVALID_CONTEXT,
+                         "Event " + std::to_string(i) +
+                             " of wait list belongs to another context.");
+        }
+    }
+
+    return CL_SUCCESS;
+}
+
 bool utils::hasMutuallyExclusiveFlags(
     cl_bitfield flags, std::initializer_list<cl_int> checkFlags) {
     bool foundFlag = false;
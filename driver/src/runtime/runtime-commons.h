@@ -8,14 +8,22 @@
 
 #include "icd/CLPlatformId.hpp"
 #include "CLObjectInfoParameterValue.hpp"
+#include "command/WorkerPool.h"
 #include "device/DeviceConfigurationParser.h"
 #include "icd/IcdDispatchTable.h"
+#include "memory/DeviceMemoryAllocator.h"
+#include "program/ProgramCache.h"
 
 extern Logger kLogger;
 extern IcdDispatchTable* kDispatchTable;
 extern DeviceConfigurationParser kDeviceConfigurationParser;
 extern CLPlatformId* kPlatform;
 extern CLDeviceId* kDevice;
+extern WorkerPool kWorkerPool;
+// single thread, so user callbacks never run concurrently
+extern WorkerPool kEventCallbackPool;
+extern DeviceMemoryAllocator kDeviceMemoryAllocator;
+extern ProgramCache kProgramCache;
 
 #define RETURN_ERROR(errorCode, message)                              \
     do {                                                              \
@@ -47,6 +55,14 @@ extern cl_int getParamInfo(
     const std::function<std::optional<CLObjectInfoParameterValue>()>&
         parameterValueGetter);
 
+/**
+ * Checks that every event of the wait list is valid and belongs to the
+ * given context.
+ */
+extern cl_int checkEventWaitList(cl_context context,
+                                 cl_uint num_events_in_wait_list,
+                                 const cl_event* event_wait_list);
+
 namespace utils {
 extern bool hasMutuallyExclusiveFlags(cl_bitfield flags,
                                 std::initializer_list<cl_int> checkFlags);
@@ -79,7 +79,7 @@ CL_API_ENTRY cl_int CL_API_CALL clRetainContext(cl_context context) {
         RETURN_ERROR(CL_INVALID_CONTEXT, "Context is null.");
     }
 
-    context->referenceCount++;
+    context->referenceCount.fetch_add(1, std::memory_order_relaxed);
 
     return CL_SUCCESS;
 }
@@ -89,10 +89,11 @@ CL_API_ENTRY cl_int CL_API_CALL clReleaseContext(cl_context context) {
         RETURN_ERROR(CL_INVALID_CONTEXT, "Context is null.");
     }
 
-    context->referenceCount--;
-
-    if (context->referenceCount == 0) {
+    if (context->referenceCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
         delete context;
+        // memory objects can't outlive their context, give cached device
+        // memory back to the system
+        kDeviceMemoryAllocator.trim();
     }
 
     return CL_SUCCESS;
@@ -115,7 +116,8 @@ CL_API_ENTRY cl_int CL_API_CALL clGetContextInfo(cl_context context,
             switch (param_name) {
                 case CL_CONTEXT_REFERENCE_COUNT: {
                     resultSize = sizeof(cl_uint);
-                    result = reinterpret_cast<void*>(context->referenceCount);
+                    result = reinterpret_cast<void*>(
+                        context->referenceCount.load());
                     break;
                 }
 
@@ -45,7 +45,10 @@ CL_API_ENTRY cl_int CL_API_CALL clGetDeviceIDs(cl_platform_id platform,
             kDeviceConfigurationParser.requireParameter<size_t>(
                 CL_DEVICE_MAX_CONSTANT_BUFFER_SIZE),
             kDeviceConfigurationParser.requireParameter<size_t>(
-                CL_DEVICE_LOCAL_MEM_SIZE));
+                CL_DEVICE_LOCAL_MEM_SIZE),
+            kDeviceConfigurationParser.requireParameter<size_t>(
+                CL_DEVICE_MEM_BASE_ADDR_ALIGN) /
+                8);
     }
 
     if (!kDevice->matchesType(device_type)) {
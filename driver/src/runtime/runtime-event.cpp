@@ -1,11 +1,45 @@
-#include <iostream>
-#include "icd/icd.h"
+#include <common/utils/common.hpp>
+
+#include "icd/CLCommandQueue.h"
+#include "icd/CLEvent.h"
+#include "runtime-commons.h"
 
 CL_API_ENTRY cl_int CL_API_CALL clWaitForEvents(cl_uint num_events,
                                                 const cl_event* event_list) {
-    // TODO(clWaitForEvents): flush queue
-    std::cerr << "Unimplemented OpenCL API call: clWaitForEvents" << std::endl;
-    return CL_INVALID_PLATFORM;
+    if (!num_events || !event_list) {
+        RETURN_ERROR(CL_INVALID_VALUE, "Event list is empty.");
+    }
+
+    if (!event_list[0]) {
+        RETURN_ERROR(CL_INVALID_EVENT, "Event 0 is null.");
+    }
+
+    const auto waitListError =
+        checkEventWaitList(event_list[0]->context, num_events, event_list);
+    if (waitListError != CL_SUCCESS) {
+        return waitListError == CL_INVALID_EVENT_WAIT_LIST ? CL_INVALID_EVENT
+                                                           : waitListError;
+    }
+
+    // commands of the events must be submitted before we can wait for them
+    for (cl_uint i = 0; i < num_events; ++i) {
+        if (event_list[i]->queue) {
+            event_list[i]->queue->flush();
+        }
+    }
+
+    bool failed = false;
+    for (cl_uint i = 0; i < num_events; ++i) {
+        event_list[i]->wait();
+        failed = failed || event_list[i]->getStatus() < CL_COMPLETE;
+    }
+
+    if (failed) {
+        RETURN_ERROR(CL_EXEC_STATUS_ERROR_FOR_EVENTS_IN_WAIT_LIST,
+                     "Some of the events terminated abnormally.");
+    }
+
+    return CL_SUCCESS;
 }
 
 CL_API_ENTRY cl_int CL_API_CALL clGetEventInfo(cl_event event,
@@ -13,32 +47,105 @@ CL_API_ENTRY cl_int CL_API_CALL clGetEventInfo(cl_event event,
                                                size_t param_value_size,
                                                void* param_value,
                                                size_t* param_value_size_ret) {
-    std::cerr << "Unimplemented OpenCL API call: clGetEventInfo" << std::endl;
-    return CL_INVALID_PLATFORM;
+    if (!event) {
+        RETURN_ERROR(CL_INVALID_EVENT, "Event is null.");
+    }
+
+    return getParamInfo(
+        param_name, param_value_size, param_value, param_value_size_ret, [&]() {
+            CLObjectInfoParameterValueType result;
+            size_t resultSize;
+            switch (param_name) {
+                case CL_EVENT_COMMAND_QUEUE: {
+                    resultSize = sizeof(cl_command_queue);
+                    result = reinterpret_cast<void*>(event->queue);
+                    break;
+                }
+
+                case CL_EVENT_CONTEXT: {
+                    resultSize = sizeof(cl_context);
+                    result = reinterpret_cast<void*>(event->context);
+                    break;
+                }
+
+                case CL_EVENT_COMMAND_TYPE: {
+                    resultSize = sizeof(cl_command_type);
+                    result = reinterpret_cast<void*>(event->commandType);
+                    break;
+                }
+
+                case CL_EVENT_COMMAND_EXECUTION_STATUS: {
+                    resultSize = sizeof(cl_int);
+                    result = reinterpret_cast<void*>(event->getStatus());
+                    break;
+                }
+
+                case CL_EVENT_REFERENCE_COUNT: {
+                    resultSize = sizeof(cl_uint);
+                    result = reinterpret_cast<void*>(
+                        event->referenceCount.load());
+                    break;
+                }
+
+                default: return utils::optionalOf<CLObjectInfoParameterValue>();
+            }
+
+            return utils::optionalOf(
+                CLObjectInfoParameterValue(result, resultSize));
+        });
 }
 
 CL_API_ENTRY cl_event CL_API_CALL clCreateUserEvent(cl_context context,
                                                     cl_int* errcode_ret) {
-    std::cerr << "Unimplemented OpenCL API call: clCreateUserEvent"
-              << std::endl;
-    return nullptr;
+    if (!context) {
+        SET_ERROR_AND_RETURN(CL_INVALID_CONTEXT, "Context is null.");
+    }
+
+    const auto event = CLEvent::create(kDispatchTable, context, nullptr,
+                                       CL_COMMAND_USER, CL_SUBMITTED);
+
+    SET_SUCCESS();
+
+    return event;
 }
 
 CL_API_ENTRY cl_int CL_API_CALL clRetainEvent(cl_event event) {
-    std::cerr << "Unimplemented OpenCL API call: clRetainEvent" << std::endl;
-    return CL_INVALID_PLATFORM;
+    if (!event) {
+        RETURN_ERROR(CL_INVALID_EVENT, "Event is null.");
+    }
+
+    event->retain();
+
+    return CL_SUCCESS;
 }
 
 CL_API_ENTRY cl_int CL_API_CALL clReleaseEvent(cl_event event) {
-    std::cerr << "Unimplemented OpenCL API call: clReleaseEvent" << std::endl;
-    return CL_INVALID_PLATFORM;
+    if (!event) {
+        RETURN_ERROR(CL_INVALID_EVENT, "Event is null.");
+    }
+
+    event->release();
+
+    return CL_SUCCESS;
 }
 
 CL_API_ENTRY cl_int CL_API_CALL clSetUserEventStatus(cl_event event,
                                                      cl_int execution_status) {
-    std::cerr << "Unimplemented OpenCL API call: clSetUserEventStatus"
-              << std::endl;
-    return CL_INVALID_PLATFORM;
+    if (!event || event->commandType != CL_COMMAND_USER) {
+        RETURN_ERROR(CL_INVALID_EVENT, "Event is null or not a user event.");
+    }
+
+    if (execution_status > CL_COMPLETE) {
+        RETURN_ERROR(CL_INVALID_VALUE,
+                     "User event status should be CL_COMPLETE or negative.");
+    }
+
+    if (!event->setStatus(execution_status)) {
+        RETURN_ERROR(CL_INVALID_OPERATION,
+                     "User event status is already set.");
+    }
+
+    return CL_SUCCESS;
 }
 
 CL_API_ENTRY cl_int CL_API_CALL
@@ -48,9 +155,25 @@ clSetEventCallback(cl_event event,
                                                  cl_int event_command_status,
                                                  void* user_data),
                    void* user_data) {
-    std::cerr << "Unimplemented OpenCL API call: clSetEventCallback"
-              << std::endl;
-    return CL_INVALID_PLATFORM;
+    if (!event) {
+        RETURN_ERROR(CL_INVALID_EVENT, "Event is null.");
+    }
+
+    if (!pfn_notify) {
+        RETURN_ERROR(CL_INVALID_VALUE, "Callback is null.");
+    }
+
+    if (command_exec_callback_type != CL_SUBMITTED &&
+        command_exec_callback_type != CL_RUNNING &&
+        command_exec_callback_type != CL_COMPLETE) {
+        RETURN_ERROR(CL_INVALID_VALUE,
+                     "Callback type should be CL_SUBMITTED, CL_RUNNING or "
+                     "CL_COMPLETE.");
+    }
+
+    event->addCallback(command_exec_callback_type, pfn_notify, user_data);
+
+    return CL_SUCCESS;
 }
 
 CL_API_ENTRY cl_int CL_API_CALL
@@ -59,7 +182,28 @@ clGetEventProfilingInfo(cl_event event,
                         size_t param_value_size,
                         void* param_value,
                         size_t* param_value_size_ret) {
-    std::cerr << "Unimplemented OpenCL API call: clGetEventProfilingInfo"
-              << std::endl;
-    return CL_INVALID_PLATFORM;
+    if (!event) {
+        RETURN_ERROR(CL_INVALID_EVENT, "Event is null.");
+    }
+
+    if (!event->isProfiled() || event->getStatus() != CL_COMPLETE) {
+        RETURN_ERROR(CL_PROFILING_INFO_NOT_AVAILABLE,
+                     "Event is not complete or its queue is not profiled.");
+    }
+
+    return getParamInfo(
+        param_name, param_value_size, param_value, param_value_size_ret, [&]() {
+            cl_int status;
+            switch (param_name) {
+                case CL_PROFILING_COMMAND_QUEUED: status = CL_QUEUED; break;
+                case CL_PROFILING_COMMAND_SUBMIT: status = CL_SUBMITTED; break;
+                case CL_PROFILING_COMMAND_START: status = CL_RUNNING; break;
+                case CL_PROFILING_COMMAND_END: status = CL_COMPLETE; break;
+                default: return utils::optionalOf<CLObjectInfoParameterValue>();
+            }
+
+            return utils::optionalOf(CLObjectInfoParameterValue(
+                reinterpret_cast<void*>(event->getProfilingTime(status)),
+                sizeof(cl_ulong)));
+        });
 }
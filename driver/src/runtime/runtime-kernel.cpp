@@ -17,21 +17,27 @@ CL_API_ENTRY cl_kernel CL_API_CALL clCreateKernel(cl_program program,
         SET_ERROR_AND_RETURN(CL_INVALID_VALUE, "Kernel name is null.");
     }
 
-    for (auto* kernel : program->disassembledBinary->kernels) {
-        if (kernel->name == kernel_name) {
-            kernel->program = program;
-            clRetainKernel(kernel);
-            clRetainProgram(program);
-
-            SET_SUCCESS();
+    const auto lazyKernel = program->findKernel(kernel_name);
+    if (!lazyKernel) {
+        SET_ERROR_AND_RETURN(
+            CL_INVALID_KERNEL_NAME,
+            "Kernel with name " + std::string(kernel_name) + " not found.");
+    }
 
-            return kernel;
-        }
+    std::shared_ptr<const KernelDefinition> definition;
+    try {
+        definition = lazyKernel->get();
+    } catch (const std::runtime_error& e) {
+        SET_ERROR_AND_RETURN(CL_INVALID_PROGRAM_EXECUTABLE, e.what());
     }
 
-    SET_ERROR_AND_RETURN(
-        CL_INVALID_KERNEL_NAME,
-        "Kernel with name " + std::string(kernel_name) + " not found.");
+    const auto kernel = new CLKernel(kDispatchTable, std::move(definition));
+    kernel->program = program;
+    clRetainProgram(program);
+
+    SET_SUCCESS();
+
+    return kernel;
 }
 
 CL_API_ENTRY cl_int CL_API_CALL
@@ -43,7 +49,7 @@ clCreateKernelsInProgram(cl_program program,
         RETURN_ERROR(CL_INVALID_PROGRAM, "Program is null.");
     }
 
-    const auto disassembledKernels = program->disassembledBinary->kernels;
+    const auto& disassembledKernels = program->disassembledBinary->kernels;
 
     if (kernels && num_kernels < disassembledKernels.size()) {
         RETURN_ERROR(
@@ -53,11 +59,17 @@ clCreateKernelsInProgram(cl_program program,
     }
 
     if (kernels) {
+        try {
+            LazyKernel::parseAll(disassembledKernels);
+        } catch (const std::runtime_error& e) {
+            RETURN_ERROR(CL_INVALID_PROGRAM_EXECUTABLE, e.what());
+        }
+
         for (int i = 0; i < disassembledKernels.size(); ++i) {
-            kernels[i] = disassembledKernels[i];
+            kernels[i] =
+                new CLKernel(kDispatchTable, disassembledKernels[i]->get());
             kernels[i]->program = program;
             clRetainProgram(program);
-            clRetainKernel(kernels[i]);
         }
     }
 
@@ -80,6 +92,10 @@ CL_API_ENTRY cl_int CL_API_CALL clSetKernelArg(cl_kernel kernel,
         kernel->setArgument(arg_index, arg_size, arg_value);
     } catch (const KernelArgumentOutOfBoundsError& e) {
         RETURN_ERROR(CL_INVALID_ARG_INDEX, e.what());
+    } catch (const KernelArgumentSizeError& e) {
+        RETURN_ERROR(CL_INVALID_ARG_SIZE, e.what());
+    } catch (const KernelArgumentValueError& e) {
+        RETURN_ERROR(CL_INVALID_ARG_VALUE, e.what());
     }
 
     return CL_SUCCESS;
@@ -90,7 +106,7 @@ CL_API_ENTRY cl_int CL_API_CALL clRetainKernel(cl_kernel kernel) {
         RETURN_ERROR(CL_INVALID_KERNEL, "Kernel is null.");
     }
 
-    kernel->referenceCount++;
+    kernel->referenceCount.fetch_add(1, std::memory_order_relaxed);
 
     return CL_SUCCESS;
 }
@@ -100,25 +116,29 @@ CL_API_ENTRY cl_int CL_API_CALL clReleaseKernel(cl_kernel kernel) {
         RETURN_ERROR(CL_INVALID_KERNEL, "Kernel is null.");
     }
 
-    kernel->referenceCount--;
-
-    if (kernel->referenceCount == 0) {
+    if (kernel->referenceCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
         delete kernel;
     }
 
     return CL_SUCCESS;
 }
 
-CL_API_ENTRY cl_int CL_API_CALL
-clEnqueueNDRangeKernel(cl_command_queue command_queue,
-                       cl_kernel kernel,
-                       cl_uint work_dim,
-                       const size_t* global_work_offset,
-                       const size_t* global_work_size,
-                       const size_t* local_work_size,
-                       cl_uint num_events_in_wait_list,
-                       const cl_event* event_wait_list,
-                       cl_event* event) {
+namespace {
+/**
+ * Checks and enqueues a launch of the kernel.
+ * @param type CL_COMMAND_NDRANGE_KERNEL or CL_COMMAND_TASK, reported by the
+ * event of the launch
+ */
+cl_int enqueueKernel(cl_command_type type,
+                     cl_command_queue command_queue,
+                     cl_kernel kernel,
+                     cl_uint work_dim,
+                     const size_t* global_work_offset,
+                     const size_t* global_work_size,
+                     const size_t* local_work_size,
+                     cl_uint num_events_in_wait_list,
+                     const cl_event* event_wait_list,
+                     cl_event* event) {
     if (!command_queue) {
         RETURN_ERROR(CL_INVALID_COMMAND_QUEUE, "Command queue is null.");
     }
@@ -175,7 +195,7 @@ clEnqueueNDRangeKernel(cl_command_queue command_queue,
 
     std::function<bool(const KernelArgument&)> argNotSetPredicate =
         [](const KernelArgument& kernel) {
-            return !kernel.value.has_value();
+            return !kernel.isSet;
         };
 
     if (std::any_of(kernel->getArguments().begin(),
@@ -184,14 +204,39 @@ clEnqueueNDRangeKernel(cl_command_queue command_queue,
                      "Not all kernel arguments are set.");
     }
 
-    const auto command = std::make_shared<KernelExecutionCommand>(
-        kernel, work_dim, global_work_offset, global_work_size,
-        local_work_size);
+    const auto waitListError = checkEventWaitList(
+        command_queue->context, num_events_in_wait_list, event_wait_list);
+    if (waitListError != CL_SUCCESS) {
+        return waitListError;
+    }
+
+    const auto command =
+        command_queue->makeCommand<KernelExecutionCommand>(
+            type, kernel, work_dim, global_work_offset, global_work_size,
+            local_work_size);
 
-    command_queue->enqueue(command);
+    command_queue->enqueue(command, num_events_in_wait_list, event_wait_list,
+                           event);
 
     return CL_SUCCESS;
 }
+}  // namespace
+
+CL_API_ENTRY cl_int CL_API_CALL
+clEnqueueNDRangeKernel(cl_command_queue command_queue,
+                       cl_kernel kernel,
+                       cl_uint work_dim,
+                       const size_t* global_work_offset,
+                       const size_t* global_work_size,
+                       const size_t* local_work_size,
+                       cl_uint num_events_in_wait_list,
+                       const cl_event* event_wait_list,
+                       cl_event* event) {
+    return enqueueKernel(CL_COMMAND_NDRANGE_KERNEL, command_queue, kernel,
+                         work_dim, global_work_offset, global_work_size,
+                         local_work_size, num_events_in_wait_list,
+                         event_wait_list, event);
+}
 
 CL_API_ENTRY cl_int CL_API_CALL clEnqueueTask(cl_command_queue command_queue,
                                               cl_kernel kernel,
@@ -200,9 +245,9 @@ CL_API_ENTRY cl_int CL_API_CALL clEnqueueTask(cl_command_queue command_queue,
                                               cl_event* event) {
     size_t workSize[1];
     workSize[0] = 1;
-    return clEnqueueNDRangeKernel(command_queue, kernel, 1, nullptr, workSize,
-                                  workSize, num_events_in_wait_list,
-                                  event_wait_list, event);
+    return enqueueKernel(CL_COMMAND_TASK, command_queue, kernel, 1, nullptr,
+                         workSize, workSize, num_events_in_wait_list,
+                         event_wait_list, event);
 }
 
 CL_API_ENTRY cl_int CL_API_CALL
@@ -250,7 +295,8 @@ CL_API_ENTRY cl_int CL_API_CALL clGetKernelInfo(cl_kernel kernel,
 
                 case CL_KERNEL_REFERENCE_COUNT: {
                     resultSize = sizeof(cl_uint);
-                    result = reinterpret_cast<void*>(kernel->referenceCount);
+                    result = reinterpret_cast<void*>(
+                        kernel->referenceCount.load());
                     break;
                 }
 
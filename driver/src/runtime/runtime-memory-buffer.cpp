@@ -1,5 +1,8 @@
 #include <command/Command.h>
+#include <command/ParallelCopy.h>
+#include <array>
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
 #include <iostream>
 #include <memory>
@@ -77,7 +80,8 @@ CL_API_ENTRY cl_mem CL_API_CALL clCreateBuffer(cl_context context,
             CL_MEM_OBJECT_ALLOCATION_FAILURE,
             "Cannot allocate " + std::to_string(size) +
                 " bytes of data. Used: " +
-                std::to_string(context->device->usedGlobalMemory) + " / " +
+                std::to_string(context->device->usedGlobalMemory.load()) +
+                " / " +
                 std::to_string(context->device->globalMemorySize) + " bytes.");
     }
 
@@ -94,24 +98,19 @@ CL_API_ENTRY cl_mem CL_API_CALL clCreateBuffer(cl_context context,
     mem->hostCanWrite = hostRWAccess || (flags & CL_MEM_HOST_WRITE_ONLY);
 
     mem->size = size;
+    mem->flags = flags;
 
     if (flags & CL_MEM_USE_HOST_PTR) {
         mem->address = static_cast<std::byte*>(host_ptr);
+        mem->hostPtr = host_ptr;
 
     } else {
-        if (flags & CL_MEM_ALLOC_HOST_PTR) {
-            // TODO: support CL_MEM_ALLOC_HOST_PTR
-            kLogger.warn(
-                "CL_MEM_ALLOC_HOST_PTR is not supported,"
-                "will act like flag was not specified!");
-        }
-
-        mem->address = new std::byte[mem->size];
+        // device memory is host memory already, so CL_MEM_ALLOC_HOST_PTR
+        // needs nothing special
+        mem->address = kDeviceMemoryAllocator.allocate(mem->size);
 
-        if (flags & CL_MEM_COPY_HOST_PTR) {
-            memcpy(mem->address, host_ptr, mem->size);
-        } else {
-            memset(mem->address, 0, mem->size);
+        if (mem->address && (flags & CL_MEM_COPY_HOST_PTR)) {
+            parallelCopy(mem->address, host_ptr, mem->size);
         }
     }
 
@@ -134,9 +133,123 @@ clCreateSubBuffer(cl_mem buffer,
                   cl_buffer_create_type buffer_create_type,
                   const void* buffer_create_info,
                   cl_int* errcode_ret) {
-    std::cerr << "Unimplemented OpenCL API call: clCreateSubBuffer"
-              << std::endl;
-    return nullptr;
+    if (!buffer || buffer->parent) {
+        SET_ERROR_AND_RETURN(CL_INVALID_MEM_OBJECT,
+                             "Buffer is null or is a sub-buffer itself.");
+    }
+
+    if (buffer_create_type != CL_BUFFER_CREATE_TYPE_REGION ||
+        !buffer_create_info) {
+        SET_ERROR_AND_RETURN(CL_INVALID_VALUE,
+                             "Only CL_BUFFER_CREATE_TYPE_REGION with a region "
+                             "is supported.");
+    }
+
+    const auto region =
+        static_cast<const cl_buffer_region*>(buffer_create_info);
+
+    if (region->size == 0) {
+        SET_ERROR_AND_RETURN(CL_INVALID_BUFFER_SIZE, "Region size is 0.");
+    }
+
+    if (region->origin + region->size > buffer->size) {
+        SET_ERROR_AND_RETURN(
+            CL_INVALID_VALUE,
+            "Region of " + std::to_string(region->size) +
+                " bytes with origin " + std::to_string(region->origin) +
+                " is out of buffer size of " + std::to_string(buffer->size) +
+                " bytes.");
+    }
+
+    const auto alignment = buffer->context->device->memoryBaseAddressAlignment;
+    if (alignment && region->origin % alignment != 0) {
+        SET_ERROR_AND_RETURN(CL_MISALIGNED_SUB_BUFFER_OFFSET,
+                             "Region origin " + std::to_string(region->origin) +
+                                 " is not aligned to " +
+                                 std::to_string(alignment) + " bytes.");
+    }
+
+    const cl_mem_flags kernelAccessFlags =
+        CL_MEM_READ_WRITE | CL_MEM_READ_ONLY | CL_MEM_WRITE_ONLY;
+    const cl_mem_flags hostAccessFlags =
+        CL_MEM_HOST_WRITE_ONLY | CL_MEM_HOST_READ_ONLY | CL_MEM_HOST_NO_ACCESS;
+    const cl_mem_flags hostPtrFlags =
+        CL_MEM_USE_HOST_PTR | CL_MEM_ALLOC_HOST_PTR | CL_MEM_COPY_HOST_PTR;
+
+    if (flags & hostPtrFlags) {
+        SET_ERROR_AND_RETURN(CL_INVALID_VALUE,
+                             "Host pointer flags are inherited from the "
+                             "buffer and can't be specified.");
+    }
+
+    if (utils::hasMutuallyExclusiveFlags(
+            flags, {CL_MEM_READ_WRITE, CL_MEM_READ_ONLY, CL_MEM_WRITE_ONLY})) {
+        SET_ERROR_AND_RETURN(
+            CL_INVALID_VALUE,
+            "CL_MEM_READ_WRITE, CL_MEM_READ_ONLY, CL_MEM_WRITE_ONLY are "
+            "mutually exclusive.");
+    }
+
+    if (utils::hasMutuallyExclusiveFlags(
+            flags, {CL_MEM_HOST_WRITE_ONLY, CL_MEM_HOST_READ_ONLY,
+                    CL_MEM_HOST_NO_ACCESS})) {
+        SET_ERROR_AND_RETURN(CL_INVALID_VALUE,
+                             "CL_MEM_HOST_WRITE_ONLY, CL_MEM_HOST_READ_ONLY, "
+                             "CL_MEM_HOST_NO_ACCESS are mutually exclusive.");
+    }
+
+    const bool kernelReads = flags & (CL_MEM_READ_WRITE | CL_MEM_READ_ONLY);
+    const bool kernelWrites = flags & (CL_MEM_READ_WRITE | CL_MEM_WRITE_ONLY);
+    if ((kernelReads && !buffer->kernelCanRead) ||
+        (kernelWrites && !buffer->kernelCanWrite)) {
+        SET_ERROR_AND_RETURN(CL_INVALID_VALUE,
+                             "Sub-buffer can't allow kernel access the buffer "
+                             "doesn't allow.");
+    }
+
+    if (((flags & CL_MEM_HOST_READ_ONLY) && !buffer->hostCanRead) ||
+        ((flags & CL_MEM_HOST_WRITE_ONLY) && !buffer->hostCanWrite)) {
+        SET_ERROR_AND_RETURN(CL_INVALID_VALUE,
+                             "Sub-buffer can't allow host access the buffer "
+                             "doesn't allow.");
+    }
+
+    auto mem = new CLMem(kDispatchTable, buffer->context);
+
+    if (flags & kernelAccessFlags) {
+        mem->kernelCanRead = kernelReads;
+        mem->kernelCanWrite = kernelWrites;
+    } else {
+        mem->kernelCanRead = buffer->kernelCanRead;
+        mem->kernelCanWrite = buffer->kernelCanWrite;
+        flags |= buffer->flags & kernelAccessFlags;
+    }
+
+    if (flags & hostAccessFlags) {
+        mem->hostCanRead = flags & CL_MEM_HOST_READ_ONLY;
+        mem->hostCanWrite = flags & CL_MEM_HOST_WRITE_ONLY;
+    } else {
+        mem->hostCanRead = buffer->hostCanRead;
+        mem->hostCanWrite = buffer->hostCanWrite;
+        flags |= buffer->flags & hostAccessFlags;
+    }
+
+    mem->flags = flags | (buffer->flags & hostPtrFlags);
+    mem->parent = buffer;
+    mem->origin = region->origin;
+    mem->size = region->size;
+    mem->address = buffer->address + region->origin;
+    if (buffer->hostPtr) {
+        mem->hostPtr = static_cast<std::byte*>(buffer->hostPtr) + mem->origin;
+    }
+
+    // the parent's memory stays alive as long as any of its views
+    clRetainMemObject(buffer);
+    buffer->addSubBuffer(mem);
+
+    SET_SUCCESS();
+
+    return mem;
 }
 
 #define CHECK_BUFFER_PARAMETERS()                                        \
@@ -173,16 +286,18 @@ clEnqueueReadBuffer(cl_command_queue command_queue,
                      "clEnqueueReadBuffer on write-only buffer.");
     }
 
-    const auto command =
-        std::make_shared<BufferReadCommand>(buffer, size, offset, ptr);
-
-    command_queue->enqueue(command);
-
-    if (blocking_read) {
-        clFlush(command_queue);
+    const auto waitListError = checkEventWaitList(
+        command_queue->context, num_events_in_wait_list, event_wait_list);
+    if (waitListError != CL_SUCCESS) {
+        return waitListError;
     }
 
-    return CL_SUCCESS;
+    const auto command = command_queue->makeCommand<BufferReadCommand>(
+        buffer, size, offset, ptr);
+
+    return command_queue->enqueue(command, blocking_read,
+                                  num_events_in_wait_list, event_wait_list,
+                                  event);
 }
 
 CL_API_ENTRY cl_int CL_API_CALL
@@ -202,17 +317,142 @@ clEnqueueWriteBuffer(cl_command_queue command_queue,
                      "clEnqueueWriteBuffer on read-only buffer.");
     }
 
-    const auto command =
-        std::make_shared<BufferWriteCommand>(buffer, size, offset, ptr);
+    const auto waitListError = checkEventWaitList(
+        command_queue->context, num_events_in_wait_list, event_wait_list);
+    if (waitListError != CL_SUCCESS) {
+        return waitListError;
+    }
 
-    command_queue->enqueue(command);
+    const auto command = command_queue->makeCommand<BufferWriteCommand>(
+        buffer, size, offset, ptr);
+
+    return command_queue->enqueue(command, blocking_write,
+                                  num_events_in_wait_list, event_wait_list,
+                                  event);
+}
 
-    if (blocking_write) {
-        clFlush(command_queue);
+namespace {
+/**
+ * Replaces zero pitches with the packed ones.
+ * @return false if the pitches can't hold the region
+ */
+bool resolvePitches(const size_t* region,
+                    size_t& rowPitch,
+                    size_t& slicePitch) {
+    if (!rowPitch) {
+        rowPitch = region[0];
     }
+    if (!slicePitch) {
+        slicePitch = region[1] * rowPitch;
+    }
+    return rowPitch >= region[0] && slicePitch >= region[1] * rowPitch &&
+           slicePitch % rowPitch == 0;
+}
 
-    return CL_SUCCESS;
+size_t rectOffset(const size_t* origin, size_t rowPitch, size_t slicePitch) {
+    return origin[2] * slicePitch + origin[1] * rowPitch + origin[0];
+}
+
+// distance from the first to one past the last byte of the region
+size_t rectExtent(const size_t* region, size_t rowPitch, size_t slicePitch) {
+    return (region[2] - 1) * slicePitch + (region[1] - 1) * rowPitch +
+           region[0];
+}
+
+/**
+ * Checks two regions laid out in the same memory for overlap. Regions with
+ * the same pitches are compared as boxes, others only by extent, which may
+ * report an overlap of interleaved regions.
+ */
+bool rectsOverlap(size_t sourceStart,
+                  size_t sourceRowPitch,
+                  size_t sourceSlicePitch,
+                  size_t destinationStart,
+                  size_t destinationRowPitch,
+                  size_t destinationSlicePitch,
+                  const size_t* region) {
+    const size_t sourceEnd =
+        sourceStart + rectExtent(region, sourceRowPitch, sourceSlicePitch);
+    const size_t destinationEnd =
+        destinationStart +
+        rectExtent(region, destinationRowPitch, destinationSlicePitch);
+    if (sourceEnd <= destinationStart || destinationEnd <= sourceStart) {
+        return false;
+    }
+
+    if (sourceRowPitch != destinationRowPitch ||
+        sourceSlicePitch != destinationSlicePitch) {
+        return true;
+    }
+
+    const size_t rowPitch = sourceRowPitch;
+    const size_t slicePitch = sourceSlicePitch;
+    const auto coordinates = [&](size_t offset) {
+        return std::array<size_t, 3>{offset % rowPitch,
+                                     offset % slicePitch / rowPitch,
+                                     offset / slicePitch};
+    };
+    const auto source = coordinates(sourceStart);
+    const auto destination = coordinates(destinationStart);
+
+    // a box wrapping over a row or slice end can't be compared by
+    // coordinates
+    const size_t rowsInSlice = slicePitch / rowPitch;
+    if (source[0] + region[0] > rowPitch ||
+        destination[0] + region[0] > rowPitch ||
+        source[1] + region[1] > rowsInSlice ||
+        destination[1] + region[1] > rowsInSlice) {
+        return true;
+    }
+
+    for (size_t i = 0; i < 3; ++i) {
+        if (source[i] + region[i] <= destination[i] ||
+            destination[i] + region[i] <= source[i]) {
+            return false;
+        }
+    }
+    return true;
 }
+}  // namespace
+
+#define CHECK_RECT_PARAMETERS(origin, rowPitch, slicePitch, memorySize)   \
+    do {                                                                  \
+        if (!resolvePitches(region, rowPitch, slicePitch)) {              \
+            RETURN_ERROR(CL_INVALID_VALUE,                                \
+                         "Pitches are too small for the region or slice " \
+                         "pitch is not a multiple of row pitch.");        \
+        }                                                                 \
+                                                                          \
+        if (rectOffset(origin, rowPitch, slicePitch) +                    \
+                rectExtent(region, rowPitch, slicePitch) >                \
+            (memorySize)) {                                               \
+            RETURN_ERROR(CL_INVALID_VALUE,                                \
+                         "Region is out of buffer bounds.");              \
+        }                                                                 \
+    } while (0)
+
+#define CHECK_BUFFER_RECT_PARAMETERS()                                    \
+    do {                                                                  \
+        if (!command_queue) {                                             \
+            RETURN_ERROR(CL_INVALID_COMMAND_QUEUE,                        \
+                         "Command queue is null.");                       \
+        }                                                                 \
+                                                                          \
+        if (!buffer) {                                                    \
+            RETURN_ERROR(CL_INVALID_MEM_OBJECT, "Buffer is null.");       \
+        }                                                                 \
+                                                                          \
+        if (!ptr || !buffer_origin || !host_origin || !region ||          \
+            !region[0] || !region[1] || !region[2]) {                     \
+            RETURN_ERROR(CL_INVALID_VALUE,                                \
+                         "ptr, origins or region is null or empty.");     \
+        }                                                                 \
+                                                                          \
+        CHECK_RECT_PARAMETERS(buffer_origin, buffer_row_pitch,            \
+                              buffer_slice_pitch, buffer->size);          \
+        CHECK_RECT_PARAMETERS(host_origin, host_row_pitch,                \
+                              host_slice_pitch, SIZE_MAX);                \
+    } while (0)
 
 CL_API_ENTRY cl_int CL_API_CALL
 clEnqueueReadBufferRect(cl_command_queue command_queue,
@@ -229,13 +469,31 @@ clEnqueueReadBufferRect(cl_command_queue command_queue,
                         cl_uint num_events_in_wait_list,
                         const cl_event* event_wait_list,
                         cl_event* event) {
-    if (blocking_read) {
-        clFlush(command_queue);
+    CHECK_BUFFER_RECT_PARAMETERS();
+
+    if (!buffer->hostCanRead) {
+        RETURN_ERROR(CL_INVALID_OPERATION,
+                     "clEnqueueReadBufferRect on write-only buffer.");
+    }
+
+    const auto waitListError = checkEventWaitList(
+        command_queue->context, num_events_in_wait_list, event_wait_list);
+    if (waitListError != CL_SUCCESS) {
+        return waitListError;
     }
 
-    std::cerr << "Unimplemented OpenCL API call: clEnqueueReadBufferRect"
-              << std::endl;
-    return CL_INVALID_PLATFORM;
+    const auto command = command_queue->makeCommand<BufferRectCommand>(
+        CL_COMMAND_READ_BUFFER_RECT, buffer, nullptr,
+        static_cast<std::byte*>(ptr) +
+            rectOffset(host_origin, host_row_pitch, host_slice_pitch),
+        host_row_pitch, host_slice_pitch,
+        buffer->address +
+            rectOffset(buffer_origin, buffer_row_pitch, buffer_slice_pitch),
+        buffer_row_pitch, buffer_slice_pitch, region);
+
+    return command_queue->enqueue(command, blocking_read,
+                                  num_events_in_wait_list, event_wait_list,
+                                  event);
 }
 
 CL_API_ENTRY cl_int CL_API_CALL
@@ -253,13 +511,31 @@ clEnqueueWriteBufferRect(cl_command_queue command_queue,
                          cl_uint num_events_in_wait_list,
                          const cl_event* event_wait_list,
                          cl_event* event) {
-    if (blocking_write) {
-        clFlush(command_queue);
+    CHECK_BUFFER_RECT_PARAMETERS();
+
+    if (!buffer->hostCanWrite) {
+        RETURN_ERROR(CL_INVALID_OPERATION,
+                     "clEnqueueWriteBufferRect on read-only buffer.");
+    }
+
+    const auto waitListError = checkEventWaitList(
+        command_queue->context, num_events_in_wait_list, event_wait_list);
+    if (waitListError != CL_SUCCESS) {
+        return waitListError;
     }
 
-    std::cerr << "Unimplemented OpenCL API call: clEnqueueWriteBufferRect"
-              << std::endl;
-    return CL_INVALID_PLATFORM;
+    const auto command = command_queue->makeCommand<BufferRectCommand>(
+        CL_COMMAND_WRITE_BUFFER_RECT, nullptr, buffer,
+        buffer->address +
+            rectOffset(buffer_origin, buffer_row_pitch, buffer_slice_pitch),
+        buffer_row_pitch, buffer_slice_pitch,
+        static_cast<const std::byte*>(ptr) +
+            rectOffset(host_origin, host_row_pitch, host_slice_pitch),
+        host_row_pitch, host_slice_pitch, region);
+
+    return command_queue->enqueue(command, blocking_write,
+                                  num_events_in_wait_list, event_wait_list,
+                                  event);
 }
 
 CL_API_ENTRY cl_int CL_API_CALL
@@ -272,9 +548,47 @@ clEnqueueFillBuffer(cl_command_queue command_queue,
                     cl_uint num_events_in_wait_list,
                     const cl_event* event_wait_list,
                     cl_event* event) {
-    std::cerr << "Unimplemented OpenCL API call: clEnqueueFillBuffer"
-              << std::endl;
-    return CL_INVALID_PLATFORM;
+    if (!command_queue) {
+        RETURN_ERROR(CL_INVALID_COMMAND_QUEUE, "Command queue is null.");
+    }
+
+    if (!buffer) {
+        RETURN_ERROR(CL_INVALID_MEM_OBJECT, "Buffer is null.");
+    }
+
+    if (!pattern || pattern_size == 0 || pattern_size > 128 ||
+        (pattern_size & (pattern_size - 1)) != 0) {
+        RETURN_ERROR(CL_INVALID_VALUE,
+                     "Pattern is null or its size is not a power of two up "
+                     "to 128.");
+    }
+
+    if (offset % pattern_size != 0 || size % pattern_size != 0) {
+        RETURN_ERROR(CL_INVALID_VALUE,
+                     "Offset and size should be multiples of pattern size.");
+    }
+
+    if (offset + size > buffer->size) {
+        RETURN_ERROR(CL_INVALID_VALUE,
+                     "Requested size of " + std::to_string(size) +
+                         " bytes with offset of " + std::to_string(offset) +
+                         " bytes is more than buffer size of " +
+                         std::to_string(buffer->size) + " bytes.");
+    }
+
+    const auto waitListError = checkEventWaitList(
+        command_queue->context, num_events_in_wait_list, event_wait_list);
+    if (waitListError != CL_SUCCESS) {
+        return waitListError;
+    }
+
+    command_queue->enqueue(
+        command_queue->makeCommand<FillBufferCommand>(buffer, pattern,
+                                                      pattern_size, offset,
+                                                      size),
+        num_events_in_wait_list, event_wait_list, event);
+
+    return CL_SUCCESS;
 }
 
 CL_API_ENTRY cl_int CL_API_CALL
@@ -287,9 +601,41 @@ clEnqueueCopyBuffer(cl_command_queue command_queue,
                     cl_uint num_events_in_wait_list,
                     const cl_event* event_wait_list,
                     cl_event* event) {
-    std::cerr << "Unimplemented OpenCL API call: clEnqueueCopyBuffer"
-              << std::endl;
-    return CL_INVALID_PLATFORM;
+    if (!command_queue) {
+        RETURN_ERROR(CL_INVALID_COMMAND_QUEUE, "Command queue is null.");
+    }
+
+    if (!src_buffer || !dst_buffer) {
+        RETURN_ERROR(CL_INVALID_MEM_OBJECT, "Buffer is null.");
+    }
+
+    if (size == 0 || src_offset + size > src_buffer->size ||
+        dst_offset + size > dst_buffer->size) {
+        RETURN_ERROR(CL_INVALID_VALUE,
+                     "Size is 0 or copied region is out of buffer bounds.");
+    }
+
+    const auto sourceStart = src_buffer->origin + src_offset;
+    const auto destinationStart = dst_buffer->origin + dst_offset;
+    if (src_buffer->getRoot() == dst_buffer->getRoot() &&
+        sourceStart < destinationStart + size &&
+        destinationStart < sourceStart + size) {
+        RETURN_ERROR(CL_MEM_COPY_OVERLAP,
+                     "Source and destination regions overlap.");
+    }
+
+    const auto waitListError = checkEventWaitList(
+        command_queue->context, num_events_in_wait_list, event_wait_list);
+    if (waitListError != CL_SUCCESS) {
+        return waitListError;
+    }
+
+    command_queue->enqueue(
+        command_queue->makeCommand<CopyBufferCommand>(
+            src_buffer, dst_buffer, src_offset, dst_offset, size),
+        num_events_in_wait_list, event_wait_list, event);
+
+    return CL_SUCCESS;
 }
 
 CL_API_ENTRY cl_int CL_API_CALL
@@ -306,9 +652,60 @@ clEnqueueCopyBufferRect(cl_command_queue command_queue,
                         cl_uint num_events_in_wait_list,
                         const cl_event* event_wait_list,
                         cl_event* event) {
-    std::cerr << "Unimplemented OpenCL API call: clEnqueueCopyBufferRect"
-              << std::endl;
-    return CL_INVALID_PLATFORM;
+    if (!command_queue) {
+        RETURN_ERROR(CL_INVALID_COMMAND_QUEUE, "Command queue is null.");
+    }
+
+    if (!src_buffer || !dst_buffer) {
+        RETURN_ERROR(CL_INVALID_MEM_OBJECT, "Buffer is null.");
+    }
+
+    if (!src_origin || !dst_origin || !region || !region[0] || !region[1] ||
+        !region[2]) {
+        RETURN_ERROR(CL_INVALID_VALUE, "Origins or region is null or empty.");
+    }
+
+    CHECK_RECT_PARAMETERS(src_origin, src_row_pitch, src_slice_pitch,
+                          src_buffer->size);
+    CHECK_RECT_PARAMETERS(dst_origin, dst_row_pitch, dst_slice_pitch,
+                          dst_buffer->size);
+
+    if (src_buffer == dst_buffer && (src_row_pitch != dst_row_pitch ||
+                                     src_slice_pitch != dst_slice_pitch)) {
+        RETURN_ERROR(CL_INVALID_VALUE,
+                     "Copy within one buffer should use the same pitches.");
+    }
+
+    if (src_buffer->getRoot() == dst_buffer->getRoot() &&
+        rectsOverlap(
+            src_buffer->origin +
+                rectOffset(src_origin, src_row_pitch, src_slice_pitch),
+            src_row_pitch, src_slice_pitch,
+            dst_buffer->origin +
+                rectOffset(dst_origin, dst_row_pitch, dst_slice_pitch),
+            dst_row_pitch, dst_slice_pitch, region)) {
+        RETURN_ERROR(CL_MEM_COPY_OVERLAP,
+                     "Source and destination regions overlap.");
+    }
+
+    const auto waitListError = checkEventWaitList(
+        command_queue->context, num_events_in_wait_list, event_wait_list);
+    if (waitListError != CL_SUCCESS) {
+        return waitListError;
+    }
+
+    command_queue->enqueue(
+        command_queue->makeCommand<BufferRectCommand>(
+            CL_COMMAND_COPY_BUFFER_RECT, src_buffer, dst_buffer,
+            dst_buffer->address +
+                rectOffset(dst_origin, dst_row_pitch, dst_slice_pitch),
+            dst_row_pitch, dst_slice_pitch,
+            src_buffer->address +
+                rectOffset(src_origin, src_row_pitch, src_slice_pitch),
+            src_row_pitch, src_slice_pitch, region),
+        num_events_in_wait_list, event_wait_list, event);
+
+    return CL_SUCCESS;
 }
 
 CL_API_ENTRY void* CL_API_CALL
@@ -322,11 +719,60 @@ clEnqueueMapBuffer(cl_command_queue command_queue,
                    const cl_event* event_wait_list,
                    cl_event* event,
                    cl_int* errcode_ret) {
-    if (blocking_map) {
-        clFlush(command_queue);
+    if (!command_queue) {
+        SET_ERROR_AND_RETURN(CL_INVALID_COMMAND_QUEUE,
+                             "Command queue is null.");
     }
 
-    std::cerr << "Unimplemented OpenCL API call: clEnqueueMapBuffer"
-              << std::endl;
-    return nullptr;
+    if (!buffer) {
+        SET_ERROR_AND_RETURN(CL_INVALID_MEM_OBJECT, "Buffer is null.");
+    }
+
+    if (!size || offset + size > buffer->size) {
+        SET_ERROR_AND_RETURN(CL_INVALID_VALUE,
+                             "Requested region of " + std::to_string(size) +
+                                 " bytes with offset of " +
+                                 std::to_string(offset) +
+                                 " bytes is empty or out of buffer bounds.");
+    }
+
+    if ((map_flags & CL_MAP_WRITE_INVALIDATE_REGION) &&
+        (map_flags & (CL_MAP_READ | CL_MAP_WRITE))) {
+        SET_ERROR_AND_RETURN(CL_INVALID_VALUE,
+                             "CL_MAP_WRITE_INVALIDATE_REGION can't be "
+                             "combined with CL_MAP_READ or CL_MAP_WRITE.");
+    }
+
+    if ((map_flags & CL_MAP_READ) && !buffer->hostCanRead) {
+        SET_ERROR_AND_RETURN(CL_INVALID_OPERATION,
+                             "CL_MAP_READ of a buffer host can't read.");
+    }
+
+    if ((map_flags & (CL_MAP_WRITE | CL_MAP_WRITE_INVALIDATE_REGION)) &&
+        !buffer->hostCanWrite) {
+        SET_ERROR_AND_RETURN(CL_INVALID_OPERATION,
+                             "CL_MAP_WRITE of a buffer host can't write.");
+    }
+
+    const auto waitListError = checkEventWaitList(
+        command_queue->context, num_events_in_wait_list, event_wait_list);
+    if (waitListError != CL_SUCCESS) {
+        SET_ERROR_AND_RETURN(waitListError, "Invalid event wait list.");
+    }
+
+    const auto error = command_queue->enqueueMap(
+        buffer, CL_COMMAND_MAP_BUFFER, blocking_map, num_events_in_wait_list,
+        event_wait_list, event);
+    if (error != CL_SUCCESS) {
+        SET_ERROR_AND_RETURN(error, "Map command failed.");
+    }
+
+    // the buffer must outlive its mappings
+    clRetainMemObject(buffer);
+    std::byte* mapped = buffer->address + offset;
+    buffer->addMapping({mapped, size, map_flags});
+
+    SET_SUCCESS();
+
+    return mapped;
 }
@@ -1,5 +1,169 @@
+#include <command/Command.h>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <common/utils/common.hpp>
 #include <iostream>
-#include "icd/icd.h"
+
+#include "icd/CLCommandQueue.h"
+#include "icd/CLContext.h"
+#include "icd/CLDeviceId.hpp"
+#include "memory/ImageFormat.h"
+#include "runtime-commons.h"
+
+namespace {
+bool isImageType(cl_mem_object_type type) {
+    return type == CL_MEM_OBJECT_IMAGE1D ||
+           type == CL_MEM_OBJECT_IMAGE1D_ARRAY ||
+           type == CL_MEM_OBJECT_IMAGE2D ||
+           type == CL_MEM_OBJECT_IMAGE2D_ARRAY ||
+           type == CL_MEM_OBJECT_IMAGE3D;
+}
+
+/**
+ * @return texels of the image layout in each dimension: layers of 1D
+ * arrays are rows and layers of 2D arrays are slices
+ */
+std::array<size_t, 3> getLayoutDimensions(const cl_image_desc& desc) {
+    switch (desc.image_type) {
+        case CL_MEM_OBJECT_IMAGE1D: return {desc.image_width, 1, 1};
+        case CL_MEM_OBJECT_IMAGE1D_ARRAY:
+            return {desc.image_width, desc.image_array_size, 1};
+        case CL_MEM_OBJECT_IMAGE2D:
+            return {desc.image_width, desc.image_height, 1};
+        case CL_MEM_OBJECT_IMAGE2D_ARRAY:
+            return {desc.image_width, desc.image_height,
+                    desc.image_array_size};
+        default:
+            return {desc.image_width, desc.image_height, desc.image_depth};
+    }
+}
+
+/**
+ * @return false if any dimension is 0 or more than the device supports
+ */
+bool fitsDeviceLimits(const cl_image_desc& desc,
+                      const std::array<size_t, 3>& dimensions) {
+    const auto limit = [](cl_device_info parameter) {
+        return kDeviceConfigurationParser.requireParameter<const size_t>(
+            parameter);
+    };
+
+    std::array<size_t, 3> limits;
+    switch (desc.image_type) {
+        case CL_MEM_OBJECT_IMAGE1D:
+            limits = {limit(CL_DEVICE_IMAGE2D_MAX_WIDTH), 1, 1};
+            break;
+        case CL_MEM_OBJECT_IMAGE1D_ARRAY:
+            limits = {limit(CL_DEVICE_IMAGE2D_MAX_WIDTH),
+                      limit(CL_DEVICE_IMAGE_MAX_ARRAY_SIZE), 1};
+            break;
+        case CL_MEM_OBJECT_IMAGE2D:
+            limits = {limit(CL_DEVICE_IMAGE2D_MAX_WIDTH),
+                      limit(CL_DEVICE_IMAGE2D_MAX_HEIGHT), 1};
+            break;
+        case CL_MEM_OBJECT_IMAGE2D_ARRAY:
+            limits = {limit(CL_DEVICE_IMAGE2D_MAX_WIDTH),
+                      limit(CL_DEVICE_IMAGE2D_MAX_HEIGHT),
+                      limit(CL_DEVICE_IMAGE_MAX_ARRAY_SIZE)};
+            break;
+        default:
+            limits = {limit(CL_DEVICE_IMAGE3D_MAX_WIDTH),
+                      limit(CL_DEVICE_IMAGE3D_MAX_HEIGHT),
+                      limit(CL_DEVICE_IMAGE3D_MAX_DEPTH)};
+            break;
+    }
+
+    for (size_t i = 0; i < 3; ++i) {
+        if (dimensions[i] == 0 || dimensions[i] > limits[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Replaces zero pitches of linear image data with the packed ones.
+ *
+ * @param width texels in a row
+ * @param rows rows in a slice, for 1D arrays the slice is a single row
+ * @return false if the pitches can't hold the rows or slices
+ */
+bool resolveImagePitches(size_t elementSize,
+                         size_t width,
+                         size_t rows,
+                         size_t& rowPitch,
+                         size_t& slicePitch) {
+    if (!rowPitch) {
+        rowPitch = width * elementSize;
+    }
+    if (!slicePitch) {
+        slicePitch = rows * rowPitch;
+    }
+    return rowPitch >= width * elementSize && rowPitch % elementSize == 0 &&
+           slicePitch >= rows * rowPitch;
+}
+
+size_t rowsInSlice(cl_mem_object_type type, size_t height) {
+    return type == CL_MEM_OBJECT_IMAGE1D_ARRAY ? 1 : height;
+}
+
+/**
+ * Distance between layout rows in linear image data: layers of 1D arrays
+ * are one slice pitch apart.
+ */
+size_t layoutRowPitch(cl_mem_object_type type,
+                      size_t rowPitch,
+                      size_t slicePitch) {
+    return type == CL_MEM_OBJECT_IMAGE1D_ARRAY ? slicePitch : rowPitch;
+}
+
+bool regionFits(const CLImageProperties& image,
+                const size_t* origin,
+                const size_t* region) {
+    const std::array<size_t, 3> dimensions{image.width, image.height,
+                                           image.depth};
+    for (size_t i = 0; i < 3; ++i) {
+        if (region[i] == 0 || origin[i] > dimensions[i] ||
+            region[i] > dimensions[i] - origin[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool regionsOverlap(const size_t* sourceOrigin,
+                    const size_t* destinationOrigin,
+                    const size_t* region) {
+    for (size_t i = 0; i < 3; ++i) {
+        if (sourceOrigin[i] + region[i] <= destinationOrigin[i] ||
+            destinationOrigin[i] + region[i] <= sourceOrigin[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+}  // namespace
+
+#define CHECK_IMAGE(memory)                                 \
+    do {                                                    \
+        if (!(memory) || !(memory)->image) {                \
+            RETURN_ERROR(CL_INVALID_MEM_OBJECT,             \
+                         "Image is null or not an image."); \
+        }                                                   \
+    } while (0)
+
+#define CHECK_IMAGE_REGION(memory, origin)                               \
+    do {                                                                 \
+        if (!(origin) || !region) {                                      \
+            RETURN_ERROR(CL_INVALID_VALUE, "Origin or region is null."); \
+        }                                                                \
+                                                                         \
+        if (!regionFits(*(memory)->image, origin, region)) {             \
+            RETURN_ERROR(CL_INVALID_VALUE,                               \
+                         "Region is empty or out of image bounds.");     \
+        }                                                                \
+    } while (0)
 
 CL_API_ENTRY cl_mem CL_API_CALL
 clCreateImage(cl_context context,
@@ -8,8 +172,135 @@ clCreateImage(cl_context context,
               const cl_image_desc* image_desc,
               void* host_ptr,
               cl_int* errcode_ret) {
-    std::cerr << "Unimplemented OpenCL API call: clCreateImage" << std::endl;
-    return nullptr;
+    if (!context) {
+        SET_ERROR_AND_RETURN(CL_INVALID_CONTEXT, "Context is null.");
+    }
+
+    if (!image_format) {
+        SET_ERROR_AND_RETURN(CL_INVALID_IMAGE_FORMAT_DESCRIPTOR,
+                             "Image format is null.");
+    }
+
+    const size_t elementSize = getImageElementSize(*image_format);
+    if (!elementSize) {
+        SET_ERROR_AND_RETURN(CL_IMAGE_FORMAT_NOT_SUPPORTED,
+                             "Image format is not supported.");
+    }
+
+    if (!image_desc || !isImageType(image_desc->image_type) ||
+        image_desc->num_mip_levels || image_desc->num_samples ||
+        image_desc->buffer) {
+        SET_ERROR_AND_RETURN(CL_INVALID_IMAGE_DESCRIPTOR,
+                             "Image descriptor is null, has unsupported "
+                             "type, mip levels, samples or buffer.");
+    }
+
+    const auto dimensions = getLayoutDimensions(*image_desc);
+    if (!fitsDeviceLimits(*image_desc, dimensions)) {
+        SET_ERROR_AND_RETURN(CL_INVALID_IMAGE_SIZE,
+                             "Image size is 0 or more than device supports.");
+    }
+
+    if (flags & CL_MEM_USE_HOST_PTR) {
+        // texels are stored in tiles, so host memory can't back the image
+        SET_ERROR_AND_RETURN(CL_INVALID_VALUE,
+                             "CL_MEM_USE_HOST_PTR is not supported for "
+                             "images.");
+    }
+
+    if (!host_ptr != !(flags & CL_MEM_COPY_HOST_PTR)) {
+        SET_ERROR_AND_RETURN(
+            CL_INVALID_HOST_PTR,
+            "host_ptr should be set if and only if CL_MEM_COPY_HOST_PTR is "
+            "specified.");
+    }
+
+    size_t rowPitch = image_desc->image_row_pitch;
+    size_t slicePitch = image_desc->image_slice_pitch;
+    if (!host_ptr && (rowPitch || slicePitch)) {
+        SET_ERROR_AND_RETURN(CL_INVALID_IMAGE_DESCRIPTOR,
+                             "Pitches are set but host_ptr is null.");
+    }
+
+    const size_t sliceRows =
+        rowsInSlice(image_desc->image_type, dimensions[1]);
+    if (!resolveImagePitches(elementSize, dimensions[0], sliceRows, rowPitch,
+                             slicePitch)) {
+        SET_ERROR_AND_RETURN(CL_INVALID_IMAGE_DESCRIPTOR,
+                             "Pitches are too small or row pitch is not a "
+                             "multiple of element size.");
+    }
+
+    if (utils::hasMutuallyExclusiveFlags(
+            flags, {CL_MEM_READ_WRITE, CL_MEM_READ_ONLY, CL_MEM_WRITE_ONLY})) {
+        SET_ERROR_AND_RETURN(
+            CL_INVALID_VALUE,
+            "CL_MEM_READ_WRITE, CL_MEM_READ_ONLY, CL_MEM_WRITE_ONLY are "
+            "mutually exclusive.");
+    }
+
+    if (utils::hasMutuallyExclusiveFlags(
+            flags, {CL_MEM_HOST_WRITE_ONLY, CL_MEM_HOST_READ_ONLY,
+                    CL_MEM_HOST_NO_ACCESS})) {
+        SET_ERROR_AND_RETURN(CL_INVALID_VALUE,
+                             "CL_MEM_HOST_WRITE_ONLY, CL_MEM_HOST_READ_ONLY, "
+                             "CL_MEM_HOST_NO_ACCESS are mutually exclusive.");
+    }
+
+    const ImageLayout layout(
+        elementSize, dimensions[0], dimensions[1], dimensions[2],
+        image_desc->image_type != CL_MEM_OBJECT_IMAGE1D &&
+            image_desc->image_type != CL_MEM_OBJECT_IMAGE1D_ARRAY);
+
+    if (context->device->usedGlobalMemory + layout.getSize() >
+        context->device->globalMemorySize) {
+        SET_ERROR_AND_RETURN(
+            CL_MEM_OBJECT_ALLOCATION_FAILURE,
+            "Cannot allocate " + std::to_string(layout.getSize()) +
+                " bytes of data. Used: " +
+                std::to_string(context->device->usedGlobalMemory.load()) +
+                " / " +
+                std::to_string(context->device->globalMemorySize) + " bytes.");
+    }
+
+    auto mem = new CLMem(kDispatchTable, context);
+
+    bool kernelRWAccess = (!flags) || (flags & CL_MEM_READ_WRITE);
+    mem->kernelCanRead = kernelRWAccess || (flags & CL_MEM_READ_ONLY);
+    mem->kernelCanWrite = kernelRWAccess || (flags & CL_MEM_WRITE_ONLY);
+
+    bool hostRWAccess =
+        (flags & (CL_MEM_HOST_WRITE_ONLY | CL_MEM_HOST_READ_ONLY |
+                  CL_MEM_HOST_NO_ACCESS)) == 0;
+    mem->hostCanRead = hostRWAccess || (flags & CL_MEM_HOST_READ_ONLY);
+    mem->hostCanWrite = hostRWAccess || (flags & CL_MEM_HOST_WRITE_ONLY);
+
+    mem->type = image_desc->image_type;
+    mem->flags = flags;
+    mem->size = layout.getSize();
+    mem->image = CLImageProperties{*image_format, *image_desc, dimensions[0],
+                                   dimensions[1], dimensions[2], layout};
+    mem->address = kDeviceMemoryAllocator.allocate(mem->size);
+
+    if (!mem->address) {
+        delete mem;
+        SET_ERROR_AND_RETURN(CL_MEM_OBJECT_ALLOCATION_FAILURE,
+                             "Failed to allocate image memory.");
+    }
+
+    if (flags & CL_MEM_COPY_HOST_PTR) {
+        const size_t origin[3] = {0, 0, 0};
+        layout.copyFromLinear(
+            mem->address, static_cast<const std::byte*>(host_ptr), origin,
+            dimensions.data(),
+            layoutRowPitch(mem->type, rowPitch, slicePitch), slicePitch);
+    }
+
+    context->device->usedGlobalMemory += mem->size;
+
+    SET_SUCCESS();
+
+    return mem;
 }
 
 CL_API_ENTRY cl_int CL_API_CALL
@@ -24,13 +315,42 @@ clEnqueueReadImage(cl_command_queue command_queue,
                    cl_uint num_events_in_wait_list,
                    const cl_event* event_wait_list,
                    cl_event* event) {
-    if (blocking_read) {
-        clFlush(command_queue);
+    if (!command_queue) {
+        RETURN_ERROR(CL_INVALID_COMMAND_QUEUE, "Command queue is null.");
     }
 
-    std::cerr << "Unimplemented OpenCL API call: clEnqueueReadImage"
-              << std::endl;
-    return CL_INVALID_PLATFORM;
+    CHECK_IMAGE(image);
+    CHECK_IMAGE_REGION(image, origin);
+
+    if (!ptr) {
+        RETURN_ERROR(CL_INVALID_VALUE, "ptr is null.");
+    }
+
+    if (!resolveImagePitches(image->image->layout.getElementSize(),
+                             region[0], rowsInSlice(image->type, region[1]),
+                             row_pitch, slice_pitch)) {
+        RETURN_ERROR(CL_INVALID_VALUE, "Pitches are too small for the region.");
+    }
+
+    if (!image->hostCanRead) {
+        RETURN_ERROR(CL_INVALID_OPERATION,
+                     "clEnqueueReadImage on write-only image.");
+    }
+
+    const auto waitListError = checkEventWaitList(
+        command_queue->context, num_events_in_wait_list, event_wait_list);
+    if (waitListError != CL_SUCCESS) {
+        return waitListError;
+    }
+
+    const auto command = command_queue->makeCommand<ImageTransferCommand>(
+        CL_COMMAND_READ_IMAGE, image, nullptr, static_cast<std::byte*>(ptr),
+        layoutRowPitch(image->type, row_pitch, slice_pitch), slice_pitch,
+        origin, region);
+
+    return command_queue->enqueue(command, blocking_read,
+                                  num_events_in_wait_list, event_wait_list,
+                                  event);
 }
 
 CL_API_ENTRY cl_int CL_API_CALL
@@ -45,13 +365,44 @@ clEnqueueWriteImage(cl_command_queue command_queue,
                     cl_uint num_events_in_wait_list,
                     const cl_event* event_wait_list,
                     cl_event* event) {
-    if (blocking_write) {
-        clFlush(command_queue);
+    if (!command_queue) {
+        RETURN_ERROR(CL_INVALID_COMMAND_QUEUE, "Command queue is null.");
     }
 
-    std::cerr << "Unimplemented OpenCL API call: clEnqueueWriteImage"
-              << std::endl;
-    return CL_INVALID_PLATFORM;
+    CHECK_IMAGE(image);
+    CHECK_IMAGE_REGION(image, origin);
+
+    if (!ptr) {
+        RETURN_ERROR(CL_INVALID_VALUE, "ptr is null.");
+    }
+
+    if (!resolveImagePitches(image->image->layout.getElementSize(),
+                             region[0], rowsInSlice(image->type, region[1]),
+                             input_row_pitch, input_slice_pitch)) {
+        RETURN_ERROR(CL_INVALID_VALUE, "Pitches are too small for the region.");
+    }
+
+    if (!image->hostCanWrite) {
+        RETURN_ERROR(CL_INVALID_OPERATION,
+                     "clEnqueueWriteImage on read-only image.");
+    }
+
+    const auto waitListError = checkEventWaitList(
+        command_queue->context, num_events_in_wait_list, event_wait_list);
+    if (waitListError != CL_SUCCESS) {
+        return waitListError;
+    }
+
+    // the command only reads through the pointer
+    const auto command = command_queue->makeCommand<ImageTransferCommand>(
+        CL_COMMAND_WRITE_IMAGE, image, nullptr,
+        const_cast<std::byte*>(static_cast<const std::byte*>(ptr)),
+        layoutRowPitch(image->type, input_row_pitch, input_slice_pitch),
+        input_slice_pitch, origin, region);
+
+    return command_queue->enqueue(command, blocking_write,
+                                  num_events_in_wait_list, event_wait_list,
+                                  event);
 }
 
 CL_API_ENTRY cl_int CL_API_CALL
@@ -63,9 +414,28 @@ clEnqueueFillImage(cl_command_queue command_queue,
                    cl_uint num_events_in_wait_list,
                    const cl_event* event_wait_list,
                    cl_event* event) {
-    std::cerr << "Unimplemented OpenCL API call: clEnqueueFillImage"
-              << std::endl;
-    return CL_INVALID_PLATFORM;
+    if (!command_queue) {
+        RETURN_ERROR(CL_INVALID_COMMAND_QUEUE, "Command queue is null.");
+    }
+
+    CHECK_IMAGE(image);
+    CHECK_IMAGE_REGION(image, origin);
+
+    if (!fill_color) {
+        RETURN_ERROR(CL_INVALID_VALUE, "Fill color is null.");
+    }
+
+    const auto waitListError = checkEventWaitList(
+        command_queue->context, num_events_in_wait_list, event_wait_list);
+    if (waitListError != CL_SUCCESS) {
+        return waitListError;
+    }
+
+    command_queue->enqueue(command_queue->makeCommand<FillImageCommand>(
+                               image, fill_color, origin, region),
+                           num_events_in_wait_list, event_wait_list, event);
+
+    return CL_SUCCESS;
 }
 
 CL_API_ENTRY cl_int CL_API_CALL
@@ -78,9 +448,43 @@ clEnqueueCopyImage(cl_command_queue command_queue,
                    cl_uint num_events_in_wait_list,
                    const cl_event* event_wait_list,
                    cl_event* event) {
-    std::cerr << "Unimplemented OpenCL API call: clEnqueueCopyImage"
-              << std::endl;
-    return CL_INVALID_PLATFORM;
+    if (!command_queue) {
+        RETURN_ERROR(CL_INVALID_COMMAND_QUEUE, "Command queue is null.");
+    }
+
+    CHECK_IMAGE(src_image);
+    CHECK_IMAGE(dst_image);
+    CHECK_IMAGE_REGION(src_image, src_origin);
+    CHECK_IMAGE_REGION(dst_image, dst_origin);
+
+    const auto& sourceFormat = src_image->image->format;
+    const auto& destinationFormat = dst_image->image->format;
+    if (sourceFormat.image_channel_order !=
+            destinationFormat.image_channel_order ||
+        sourceFormat.image_channel_data_type !=
+            destinationFormat.image_channel_data_type) {
+        RETURN_ERROR(CL_IMAGE_FORMAT_MISMATCH,
+                     "Source and destination image formats differ.");
+    }
+
+    if (src_image == dst_image &&
+        regionsOverlap(src_origin, dst_origin, region)) {
+        RETURN_ERROR(CL_MEM_COPY_OVERLAP,
+                     "Source and destination regions overlap.");
+    }
+
+    const auto waitListError = checkEventWaitList(
+        command_queue->context, num_events_in_wait_list, event_wait_list);
+    if (waitListError != CL_SUCCESS) {
+        return waitListError;
+    }
+
+    command_queue->enqueue(
+        command_queue->makeCommand<CopyImageCommand>(
+            src_image, dst_image, src_origin, dst_origin, region),
+        num_events_in_wait_list, event_wait_list, event);
+
+    return CL_SUCCESS;
 }
 
 CL_API_ENTRY cl_int CL_API_CALL
@@ -93,9 +497,40 @@ clEnqueueCopyImageToBuffer(cl_command_queue command_queue,
                            cl_uint num_events_in_wait_list,
                            const cl_event* event_wait_list,
                            cl_event* event) {
-    std::cerr << "Unimplemented OpenCL API call: clEnqueueCopyImageToBuffer"
-              << std::endl;
-    return CL_INVALID_PLATFORM;
+    if (!command_queue) {
+        RETURN_ERROR(CL_INVALID_COMMAND_QUEUE, "Command queue is null.");
+    }
+
+    CHECK_IMAGE(src_image);
+    CHECK_IMAGE_REGION(src_image, src_origin);
+
+    if (!dst_buffer || dst_buffer->image) {
+        RETURN_ERROR(CL_INVALID_MEM_OBJECT, "Buffer is null or an image.");
+    }
+
+    const size_t rowPitch =
+        region[0] * src_image->image->layout.getElementSize();
+    const size_t slicePitch = region[1] * rowPitch;
+    if (dst_offset > dst_buffer->size ||
+        region[2] * slicePitch > dst_buffer->size - dst_offset) {
+        RETURN_ERROR(CL_INVALID_VALUE,
+                     "Copied region is out of buffer bounds.");
+    }
+
+    const auto waitListError = checkEventWaitList(
+        command_queue->context, num_events_in_wait_list, event_wait_list);
+    if (waitListError != CL_SUCCESS) {
+        return waitListError;
+    }
+
+    command_queue->enqueue(
+        command_queue->makeCommand<ImageTransferCommand>(
+            CL_COMMAND_COPY_IMAGE_TO_BUFFER, src_image, dst_buffer,
+            dst_buffer->address + dst_offset, rowPitch, slicePitch, src_origin,
+            region),
+        num_events_in_wait_list, event_wait_list, event);
+
+    return CL_SUCCESS;
 }
 
 CL_API_ENTRY cl_int CL_API_CALL
@@ -108,9 +543,40 @@ clEnqueueCopyBufferToImage(cl_command_queue command_queue,
                            cl_uint num_events_in_wait_list,
                            const cl_event* event_wait_list,
                            cl_event* event) {
-    std::cerr << "Unimplemented OpenCL API call: clEnqueueCopyBufferToImage"
-              << std::endl;
-    return CL_INVALID_PLATFORM;
+    if (!command_queue) {
+        RETURN_ERROR(CL_INVALID_COMMAND_QUEUE, "Command queue is null.");
+    }
+
+    CHECK_IMAGE(dst_image);
+    CHECK_IMAGE_REGION(dst_image, dst_origin);
+
+    if (!src_buffer || src_buffer->image) {
+        RETURN_ERROR(CL_INVALID_MEM_OBJECT, "Buffer is null or an image.");
+    }
+
+    const size_t rowPitch =
+        region[0] * dst_image->image->layout.getElementSize();
+    const size_t slicePitch = region[1] * rowPitch;
+    if (src_offset > src_buffer->size ||
+        region[2] * slicePitch > src_buffer->size - src_offset) {
+        RETURN_ERROR(CL_INVALID_VALUE,
+                     "Copied region is out of buffer bounds.");
+    }
+
+    const auto waitListError = checkEventWaitList(
+        command_queue->context, num_events_in_wait_list, event_wait_list);
+    if (waitListError != CL_SUCCESS) {
+        return waitListError;
+    }
+
+    command_queue->enqueue(
+        command_queue->makeCommand<ImageTransferCommand>(
+            CL_COMMAND_COPY_BUFFER_TO_IMAGE, dst_image, src_buffer,
+            src_buffer->address + src_offset, rowPitch, slicePitch, dst_origin,
+            region),
+        num_events_in_wait_list, event_wait_list, event);
+
+    return CL_SUCCESS;
 }
 
 CL_API_ENTRY void* CL_API_CALL
@@ -127,7 +593,7 @@ clEnqueueMapImage(cl_command_queue command_queue,
                   cl_event* event,
                   cl_int* errcode_ret) {
     if (blocking_map) {
-        clFlush(command_queue);
+        clFinish(command_queue);
     }
 
     std::cerr << "Unimplemented OpenCL API call: clEnqueueMapImage"
@@ -143,9 +609,33 @@ clGetSupportedImageFormats(cl_context context,
                            cl_uint num_entries,
                            cl_image_format* image_formats,
                            cl_uint* num_image_formats) {
-    std::cerr << "Unimplemented OpenCL API call: clGetSupportedImageFormats"
-              << std::endl;
-    return CL_INVALID_PLATFORM;
+    if (!context) {
+        RETURN_ERROR(CL_INVALID_CONTEXT, "Context is null.");
+    }
+
+    if (!isImageType(image_type)) {
+        RETURN_ERROR(CL_INVALID_VALUE, "Image type is not supported.");
+    }
+
+    if (image_formats && num_entries == 0) {
+        RETURN_ERROR(CL_INVALID_VALUE,
+                     "image_formats is set but num_entries == 0.");
+    }
+
+    // every format is supported with any flags and image type
+    const auto& formats = getSupportedImageFormats();
+
+    if (image_formats) {
+        std::copy_n(formats.begin(),
+                    std::min<size_t>(num_entries, formats.size()),
+                    image_formats);
+    }
+
+    if (num_image_formats) {
+        *num_image_formats = formats.size();
+    }
+
+    return CL_SUCCESS;
 }
 
 CL_API_ENTRY cl_int CL_API_CALL clGetImageInfo(cl_mem image,
@@ -153,8 +643,106 @@ CL_API_ENTRY cl_int CL_API_CALL clGetImageInfo(cl_mem image,
                                                size_t param_value_size,
                                                void* param_value,
                                                size_t* param_value_size_ret) {
-    std::cerr << "Unimplemented OpenCL API call: clGetImageInfo" << std::endl;
-    return CL_INVALID_PLATFORM;
+    CHECK_IMAGE(image);
+
+    const auto& properties = *image->image;
+    const auto& desc = properties.desc;
+    const size_t elementSize = properties.layout.getElementSize();
+    const bool isOneDimensional =
+        desc.image_type == CL_MEM_OBJECT_IMAGE1D ||
+        desc.image_type == CL_MEM_OBJECT_IMAGE1D_ARRAY;
+    const bool isArrayImage = desc.image_type == CL_MEM_OBJECT_IMAGE1D_ARRAY ||
+                              desc.image_type == CL_MEM_OBJECT_IMAGE2D_ARRAY;
+
+    // pitches of the image data read back in the linear layout
+    const size_t rowPitch = properties.width * elementSize;
+    size_t slicePitch = 0;
+    if (desc.image_type == CL_MEM_OBJECT_IMAGE1D_ARRAY) {
+        slicePitch = rowPitch;
+    } else if (desc.image_type == CL_MEM_OBJECT_IMAGE2D_ARRAY ||
+               desc.image_type == CL_MEM_OBJECT_IMAGE3D) {
+        slicePitch = rowPitch * properties.height;
+    }
+
+    return getParamInfo(
+        param_name, param_value_size, param_value, param_value_size_ret, [&]() {
+            CLObjectInfoParameterValueType result;
+            size_t resultSize;
+            bool isArray = false;
+            switch (param_name) {
+                case CL_IMAGE_FORMAT: {
+                    resultSize = sizeof(cl_image_format);
+                    result = const_cast<cl_image_format*>(&properties.format);
+                    isArray = true;
+                    break;
+                }
+
+                case CL_IMAGE_ELEMENT_SIZE: {
+                    resultSize = sizeof(size_t);
+                    result = reinterpret_cast<void*>(elementSize);
+                    break;
+                }
+
+                case CL_IMAGE_ROW_PITCH: {
+                    resultSize = sizeof(size_t);
+                    result = reinterpret_cast<void*>(rowPitch);
+                    break;
+                }
+
+                case CL_IMAGE_SLICE_PITCH: {
+                    resultSize = sizeof(size_t);
+                    result = reinterpret_cast<void*>(slicePitch);
+                    break;
+                }
+
+                case CL_IMAGE_WIDTH: {
+                    resultSize = sizeof(size_t);
+                    result = reinterpret_cast<void*>(desc.image_width);
+                    break;
+                }
+
+                case CL_IMAGE_HEIGHT: {
+                    resultSize = sizeof(size_t);
+                    result = reinterpret_cast<void*>(
+                        isOneDimensional ? 0 : desc.image_height);
+                    break;
+                }
+
+                case CL_IMAGE_DEPTH: {
+                    resultSize = sizeof(size_t);
+                    result = reinterpret_cast<void*>(
+                        desc.image_type == CL_MEM_OBJECT_IMAGE3D
+                            ? desc.image_depth
+                            : 0);
+                    break;
+                }
+
+                case CL_IMAGE_ARRAY_SIZE: {
+                    resultSize = sizeof(size_t);
+                    result = reinterpret_cast<void*>(
+                        isArrayImage ? desc.image_array_size : 0);
+                    break;
+                }
+
+                case CL_IMAGE_BUFFER: {
+                    resultSize = sizeof(cl_mem);
+                    result = nullptr;
+                    break;
+                }
+
+                case CL_IMAGE_NUM_MIP_LEVELS:
+                case CL_IMAGE_NUM_SAMPLES: {
+                    resultSize = sizeof(cl_uint);
+                    result = nullptr;
+                    break;
+                }
+
+                default: return utils::optionalOf<CLObjectInfoParameterValue>();
+            }
+
+            return utils::optionalOf(
+                CLObjectInfoParameterValue(result, resultSize, isArray));
+        });
 }
 
 CL_API_ENTRY cl_mem CL_API_CALL
@@ -166,8 +754,14 @@ clCreateImage2D(cl_context context,
                 size_t image_row_pitch,
                 void* host_ptr,
                 cl_int* errcode_ret) {
-    std::cerr << "Unimplemented OpenCL API call: clCreateImage2D" << std::endl;
-    return nullptr;
+    cl_image_desc desc{};
+    desc.image_type = CL_MEM_OBJECT_IMAGE2D;
+    desc.image_width = image_width;
+    desc.image_height = image_height;
+    desc.image_row_pitch = image_row_pitch;
+
+    return clCreateImage(context, flags, image_format, &desc, host_ptr,
+                         errcode_ret);
 }
 
 CL_API_ENTRY
@@ -182,6 +776,14 @@ clCreateImage3D(cl_context context,
                 size_t image_slice_pitch,
                 void* host_ptr,
                 cl_int* errcode_ret) {
-    std::cerr << "Unimplemented OpenCL API call: clCreateImage3D" << std::endl;
-    return nullptr;
+    cl_image_desc desc{};
+    desc.image_type = CL_MEM_OBJECT_IMAGE3D;
+    desc.image_width = image_width;
+    desc.image_height = image_height;
+    desc.image_depth = image_depth;
+    desc.image_row_pitch = image_row_pitch;
+    desc.image_slice_pitch = image_slice_pitch;
+
+    return clCreateImage(context, flags, image_format, &desc, host_ptr,
+                         errcode_ret);
 }
@@ -1,5 +1,8 @@
 #include <iostream>
 #include <memory>
+#include <common/utils/common.hpp>
+
+#include "icd/CLCommandQueue.h"
 #include "icd/CLContext.h"
 #include "icd/CLDeviceId.hpp"
 #include "icd/CLMem.h"
@@ -10,7 +13,7 @@ CL_API_ENTRY cl_int CL_API_CALL clRetainMemObject(cl_mem memobj) {
         RETURN_ERROR(CL_INVALID_MEM_OBJECT, "Memory object is null.");
     }
 
-    memobj->referenceCount++;
+    memobj->referenceCount.fetch_add(1, std::memory_order_relaxed);
 
     return CL_SUCCESS;
 }
@@ -20,10 +23,17 @@ CL_API_ENTRY cl_int CL_API_CALL clReleaseMemObject(cl_mem memobj) {
         RETURN_ERROR(CL_INVALID_MEM_OBJECT, "Memory object is null.");
     }
 
-    memobj->referenceCount--;
+    if (memobj->referenceCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        if (const auto parent = memobj->parent) {
+            parent->removeSubBuffer(memobj);
+            delete memobj;
+            clReleaseMemObject(parent);
+            return CL_SUCCESS;
+        }
 
-    if (memobj->referenceCount == 0) {
-        delete[] memobj->address;
+        if (!(memobj->flags & CL_MEM_USE_HOST_PTR)) {
+            kDeviceMemoryAllocator.free(memobj->address, memobj->size);
+        }
         memobj->context->device->usedGlobalMemory -= memobj->size;
         delete memobj;
     }
@@ -37,9 +47,76 @@ clGetMemObjectInfo(cl_mem memobj,
                    size_t param_value_size,
                    void* param_value,
                    size_t* param_value_size_ret) {
-    std::cerr << "Unimplemented OpenCL API call: clGetMemObjectInfo"
-              << std::endl;
-    return CL_INVALID_PLATFORM;
+    if (!memobj) {
+        RETURN_ERROR(CL_INVALID_MEM_OBJECT, "Memory object is null.");
+    }
+
+    return getParamInfo(
+        param_name, param_value_size, param_value, param_value_size_ret, [&]() {
+            CLObjectInfoParameterValueType result;
+            size_t resultSize;
+            switch (param_name) {
+                case CL_MEM_TYPE: {
+                    resultSize = sizeof(cl_mem_object_type);
+                    result = reinterpret_cast<void*>(memobj->type);
+                    break;
+                }
+
+                case CL_MEM_FLAGS: {
+                    resultSize = sizeof(cl_mem_flags);
+                    result = reinterpret_cast<void*>(memobj->flags);
+                    break;
+                }
+
+                case CL_MEM_SIZE: {
+                    resultSize = sizeof(size_t);
+                    result = reinterpret_cast<void*>(memobj->size);
+                    break;
+                }
+
+                case CL_MEM_HOST_PTR: {
+                    resultSize = sizeof(void*);
+                    result = memobj->hostPtr;
+                    break;
+                }
+
+                case CL_MEM_MAP_COUNT: {
+                    resultSize = sizeof(cl_uint);
+                    result = reinterpret_cast<void*>(memobj->getMapCount());
+                    break;
+                }
+
+                case CL_MEM_REFERENCE_COUNT: {
+                    resultSize = sizeof(cl_uint);
+                    result = reinterpret_cast<void*>(
+                        memobj->referenceCount.load());
+                    break;
+                }
+
+                case CL_MEM_ASSOCIATED_MEMOBJECT: {
+                    resultSize = sizeof(cl_mem);
+                    result = reinterpret_cast<void*>(memobj->parent);
+                    break;
+                }
+
+                case CL_MEM_OFFSET: {
+                    resultSize = sizeof(size_t);
+                    result = reinterpret_cast<void*>(memobj->origin);
+                    break;
+                }
+
+                case CL_MEM_CONTEXT: {
+                    resultSize = sizeof(cl_context);
+                    result = reinterpret_cast<void*>(memobj->context);
+                    break;
+                }
+
+                default: return utils::optionalOf<CLObjectInfoParameterValue>();
+            }
+
+            return utils::optionalOf(
+                CLObjectInfoParameterValue(result, resultSize));
+        });
 }
 
 CL_API_ENTRY cl_int CL_API_CALL
@@ -49,9 +126,32 @@ clEnqueueUnmapMemObject(cl_command_queue command_queue,
                         cl_uint num_events_in_wait_list,
                         const cl_event* event_wait_list,
                         cl_event* event) {
-    std::cerr << "Unimplemented OpenCL API call: clEnqueueUnmapMemObject"
-              << std::endl;
-    return CL_INVALID_PLATFORM;
+    if (!command_queue) {
+        RETURN_ERROR(CL_INVALID_COMMAND_QUEUE, "Command queue is null.");
+    }
+
+    if (!memobj) {
+        RETURN_ERROR(CL_INVALID_MEM_OBJECT, "Memory object is null.");
+    }
+
+    const auto waitListError = checkEventWaitList(
+        command_queue->context, num_events_in_wait_list, event_wait_list);
+    if (waitListError != CL_SUCCESS) {
+        return waitListError;
+    }
+
+    if (!memobj->removeMapping(mapped_ptr)) {
+        RETURN_ERROR(CL_INVALID_VALUE,
+                     "Pointer is not mapped from the memory object.");
+    }
+
+    const auto error = command_queue->enqueueMap(
+        memobj, CL_COMMAND_UNMAP_MEM_OBJECT, false, num_events_in_wait_list,
+        event_wait_list, event);
+
+    clReleaseMemObject(memobj);
+
+    return error;
 }
 
 CL_API_ENTRY cl_int CL_API_CALL
@@ -55,17 +55,32 @@ clCreateProgramWithBinary(cl_context context,
     memcpy(buffer, binaries[0], program->binarySize);
     program->binary = buffer;
 
-    const auto disassembler = BinaryDisassembler();
-    try {
-        program->disassembledBinary =
-            disassembler.disassemble(program->binarySize, program->binary);
-        program->buildLog = "Success disassembling binary";
-
-    } catch (const std::runtime_error& e) {
-        program->buildLog = e.what();
-        SET_BINARY_STATUS_AND_RETURN(CL_INVALID_BINARY, e.what());
+    const auto cacheKey =
+        kProgramCache.keyOf(program->binarySize, program->binary);
+    program->disassembledBinary = kProgramCache.load(
+        cacheKey, program->binarySize, program->binary);
+
+    if (program->disassembledBinary) {
+        program->buildLog = "Loaded disassembled binary from cache";
+
+    } else {
+        const auto disassembler = BinaryDisassembler();
+        try {
+            program->disassembledBinary =
+                disassembler.disassemble(program->binarySize, program->binary);
+            program->buildLog = "Success disassembling binary";
+
+        } catch (const std::runtime_error& e) {
+            program->buildLog = e.what();
+            SET_BINARY_STATUS_AND_RETURN(CL_INVALID_BINARY, e.what());
+        }
+
+        kProgramCache.store(cacheKey, program->binarySize, program->binary,
+                            *program->disassembledBinary);
     }
 
+    program->indexKernels();
+
     SET_BINARY_STATUS(CL_SUCCESS);
     SET_SUCCESS();
 
@@ -105,7 +120,7 @@ CL_API_ENTRY cl_int CL_API_CALL clRetainProgram(cl_program program) {
         RETURN_ERROR(CL_INVALID_PROGRAM, "Program is null.");
     }
 
-    program->referenceCount++;
+    program->referenceCount.fetch_add(1, std::memory_order_relaxed);
     return CL_SUCCESS;
 }
 
@@ -114,9 +129,7 @@ CL_API_ENTRY cl_int CL_API_CALL clReleaseProgram(cl_program program) {
         RETURN_ERROR(CL_INVALID_PROGRAM, "Program is null.");
     }
 
-    program->referenceCount--;
-
-    if (program->referenceCount == 0) {
+    if (program->referenceCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
         delete program;
     }
 
@@ -140,7 +153,8 @@ CL_API_ENTRY cl_int CL_API_CALL clGetProgramInfo(cl_program program,
             switch (param_name) {
                 case CL_PROGRAM_REFERENCE_COUNT: {
                     resultSize = sizeof(cl_uint);
-                    result = reinterpret_cast<void*>(program->referenceCount);
+                    result = reinterpret_cast<void*>(
+                        program->referenceCount.load());
                     break;
                 }
 
@@ -182,12 +196,13 @@ CL_API_ENTRY cl_int CL_API_CALL clGetProgramInfo(cl_program program,
 
                 case CL_PROGRAM_NUM_KERNELS: {
                     resultSize = sizeof(size_t);
-                    result = reinterpret_cast<void*>(0);
+                    result = reinterpret_cast<void*>(
+                        program->disassembledBinary->kernels.size());
                     break;
                 }
 
                 case CL_PROGRAM_KERNEL_NAMES: {
-                    result = "";
+                    result = program->kernelNames;
                     break;
                 }
 
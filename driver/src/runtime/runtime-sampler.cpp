@@ -1,14 +1,32 @@
-#include <iostream>
-#include "icd/icd.h"
+#include <common/utils/common.hpp>
+
+#include "icd/CLSampler.hpp"
+#include "runtime-commons.h"
 
 CL_API_ENTRY cl_int CL_API_CALL clRetainSampler(cl_sampler sampler) {
-    std::cerr << "Unimplemented OpenCL API call: clRetainSampler" << std::endl;
-    return CL_INVALID_PLATFORM;
+    if (!sampler) {
+        RETURN_ERROR(CL_INVALID_SAMPLER, "Sampler is null.");
+    }
+
+    sampler->referenceCount++;
+
+    return CL_SUCCESS;
 }
 
 CL_API_ENTRY cl_int CL_API_CALL clReleaseSampler(cl_sampler sampler) {
-    std::cerr << "Unimplemented OpenCL API call: clReleaseSampler" << std::endl;
-    return CL_INVALID_PLATFORM;
+    if (!sampler) {
+        RETURN_ERROR(CL_INVALID_SAMPLER, "Sampler is null.");
+    }
+
+    sampler->referenceCount--;
+
+    if (sampler->referenceCount == 0) {
+        const auto context = sampler->context;
+        delete sampler;
+        clReleaseContext(context);
+    }
+
+    return CL_SUCCESS;
 }
 
 CL_API_ENTRY cl_int CL_API_CALL clGetSamplerInfo(cl_sampler sampler,
@@ -16,8 +34,55 @@ CL_API_ENTRY cl_int CL_API_CALL clGetSamplerInfo(cl_sampler sampler,
                                                  size_t param_value_size,
                                                  void* param_value,
                                                  size_t* param_value_size_ret) {
-    std::cerr << "Unimplemented OpenCL API call: clGetSamplerInfo" << std::endl;
-    return CL_INVALID_PLATFORM;
+    if (!sampler) {
+        RETURN_ERROR(CL_INVALID_SAMPLER, "Sampler is null.");
+    }
+
+    return getParamInfo(
+        param_name, param_value_size, param_value, param_value_size_ret, [&]() {
+            CLObjectInfoParameterValueType result;
+            size_t resultSize;
+
+            switch (param_name) {
+                case CL_SAMPLER_REFERENCE_COUNT: {
+                    resultSize = sizeof(cl_uint);
+                    result = reinterpret_cast<void*>(sampler->referenceCount);
+                    break;
+                }
+
+                case CL_SAMPLER_CONTEXT: {
+                    resultSize = sizeof(cl_context);
+                    result = reinterpret_cast<void*>(sampler->context);
+                    break;
+                }
+
+                case CL_SAMPLER_NORMALIZED_COORDS: {
+                    resultSize = sizeof(cl_bool);
+                    result = reinterpret_cast<void*>(
+                        static_cast<size_t>(sampler->normalizedCoords));
+                    break;
+                }
+
+                case CL_SAMPLER_ADDRESSING_MODE: {
+                    resultSize = sizeof(cl_addressing_mode);
+                    result = reinterpret_cast<void*>(
+                        static_cast<size_t>(sampler->addressingMode));
+                    break;
+                }
+
+                case CL_SAMPLER_FILTER_MODE: {
+                    resultSize = sizeof(cl_filter_mode);
+                    result = reinterpret_cast<void*>(
+                        static_cast<size_t>(sampler->filterMode));
+                    break;
+                }
+
+                default: return utils::optionalOf<CLObjectInfoParameterValue>();
+            }
+
+            return utils::optionalOf(
+                CLObjectInfoParameterValue(result, resultSize));
+        });
 }
 
 CL_API_ENTRY cl_sampler CL_API_CALL
@@ -26,6 +91,39 @@ clCreateSampler(cl_context context,
                 cl_addressing_mode addressing_mode,
                 cl_filter_mode filter_mode,
                 cl_int* errcode_ret) {
-    std::cerr << "Unimplemented OpenCL API call: clCreateSampler" << std::endl;
-    return nullptr;
+    if (!context) {
+        SET_ERROR_AND_RETURN(CL_INVALID_CONTEXT, "Context is null.");
+    }
+
+    switch (addressing_mode) {
+        case CL_ADDRESS_NONE:
+        case CL_ADDRESS_CLAMP_TO_EDGE:
+        case CL_ADDRESS_CLAMP: break;
+        case CL_ADDRESS_REPEAT:
+        case CL_ADDRESS_MIRRORED_REPEAT:
+            if (!normalized_coords) {
+                SET_ERROR_AND_RETURN(CL_INVALID_VALUE,
+                                     "Repeat addressing modes need "
+                                     "normalized coordinates.");
+            }
+            break;
+        default:
+            SET_ERROR_AND_RETURN(CL_INVALID_VALUE,
+                                 "Unknown addressing mode " +
+                                     std::to_string(addressing_mode) + ".");
+    }
+
+    if (filter_mode != CL_FILTER_NEAREST && filter_mode != CL_FILTER_LINEAR) {
+        SET_ERROR_AND_RETURN(CL_INVALID_VALUE,
+                             "Unknown filter mode " +
+                                 std::to_string(filter_mode) + ".");
+    }
+
+    auto sampler = new CLSampler(kDispatchTable, context, normalized_coords,
+                                 addressing_mode, filter_mode);
+    clRetainContext(context);
+
+    SET_SUCCESS();
+
+    return sampler;
 }
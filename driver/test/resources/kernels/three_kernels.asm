@@ -0,0 +1,31 @@
+/* Disassembling 'three_kernels.bin' */
+.amdcl2
+.gpu Iceland
+.64bit
+.compile_options "-O2"
+.kernel first
+.acl_version "AMD-COMP-LIB-v0.8 (0.0.SC_BUILD_NUMBER)"
+    .config
+        .dims x
+        .arg _.global_offset_0, "size_t", long
+        .arg out, "uint*", uint*, global, 
+    .text
+/*000000000000*/ s_load_dwordx2  s[0:1], s[4:5], 0x8
+/*000000000008*/ s_endpgm
+.kernel second
+    .config
+        .dims xy
+        .arg _.global_offset_0, "size_t", long
+        .arg _.global_offset_1, "size_t", long
+        .arg x, "int", int
+        .arg y, "float4", float4
+    .text
+/*000000000000*/ s_endpgm
+.kernel third
+    .config
+        .dims x
+        .arg in, "int*", int*, global, const, rdonly
+    .text
+/*000000000000*/ s_mov_b32       s0, 0
+.L4_0:
+/*000000000004*/ s_endpgm
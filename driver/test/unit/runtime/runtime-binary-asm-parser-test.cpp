@@ -0,0 +1,123 @@
+#include <common/test/doctest.h>
+
+#include <runtime/program/BinaryAsmParser.h>
+#include <runtime/program/KernelArgumentInfoParser.h>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "unit-test-common/test-commons.h"
+
+namespace {
+std::unique_ptr<BinaryDisassemblingResult> parseAsmFile(
+    const std::string& path) {
+    std::ifstream file(path);
+    REQUIRE(file.is_open());
+    auto input = std::make_shared<std::string>(
+        std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return BinaryAsmParser(input).parseAsm();
+}
+}  // namespace
+
+TEST_SUITE("Binary asm parser") {
+    TEST_CASE("BinaryAsmParser") {
+        SUBCASE("should parse every kernel of a binary") {
+            const auto result =
+                parseAsmFile("test/resources/kernels/three_kernels.asm");
+
+            CHECK(result->gpuName == "Iceland");
+            CHECK(result->compileOptions == "\"-O2\"");
+            // lines between the first .kernel and its .config are read as
+            // binary parameters
+            CHECK(result->parameters ==
+                  std::vector<std::string>{
+                      "/* Disassembling 'three_kernels.bin' */", ".amdcl2",
+                      ".64bit",
+                      ".acl_version \"AMD-COMP-LIB-v0.8 "
+                      "(0.0.SC_BUILD_NUMBER)\""});
+
+            const auto& kernels = result->kernels;
+            REQUIRE(kernels.size() == 3);
+            CHECK(!kernels[0]->isParsed());
+
+            LazyKernel::parseAll(kernels);
+
+            const auto first = kernels[0]->get();
+            CHECK(first->name == "first");
+            CHECK(first->config ==
+                  std::vector<std::string>{
+                      ".dims x",
+                      ".arg _.global_offset_0, \"size_t\", long",
+                      ".arg out, \"uint*\", uint*, global,"});
+            CHECK(first->instructions ==
+                  std::vector<std::string>{
+                      "/*000000000000*/ s_load_dwordx2  s[0:1], s[4:5], 0x8",
+                      "/*000000000008*/ s_endpgm"});
+            REQUIRE(first->arguments.size() == 1);
+            const auto* out = dynamic_cast<const PointerKernelArgumentInfo*>(
+                first->arguments[0].info.get());
+            REQUIRE(out != nullptr);
+            CHECK(out->argumentName == "out");
+            CHECK(out->type == "uint*");
+            CHECK(out->addressQualifier == CL_KERNEL_ARG_ADDRESS_GLOBAL);
+            CHECK(first->arguments[0].offset == 8);
+            CHECK(first->kernargSize == 16);
+
+            const auto second = kernels[1]->get();
+            CHECK(second->name == "second");
+            CHECK(second->config.size() == 5);
+            CHECK(second->instructions ==
+                  std::vector<std::string>{"/*000000000000*/ s_endpgm"});
+            REQUIRE(second->arguments.size() == 2);
+            CHECK(second->arguments[0].info->argumentName == "x");
+            CHECK(dynamic_cast<const ScalarKernelArgumentInfo*>(
+                      second->arguments[0].info.get()) != nullptr);
+            CHECK(second->arguments[0].offset == 16);
+            CHECK(second->arguments[1].info->argumentName == "y");
+            CHECK(dynamic_cast<const VectorKernelArgumentInfo*>(
+                      second->arguments[1].info.get()) != nullptr);
+            CHECK(second->arguments[1].offset == 32);
+            CHECK(second->kernargSize == 48);
+
+            const auto third = kernels[2]->get();
+            CHECK(third->name == "third");
+            CHECK(third->config ==
+                  std::vector<std::string>{
+                      ".dims x",
+                      ".arg in, \"int*\", int*, global, const, rdonly"});
+            // labels are kept as instructions
+            CHECK(third->instructions ==
+                  std::vector<std::string>{
+                      "/*000000000000*/ s_mov_b32       s0, 0", ".L4_0:",
+                      "/*000000000004*/ s_endpgm"});
+            REQUIRE(third->arguments.size() == 1);
+            CHECK(third->arguments[0].info->argumentName == "in");
+            CHECK(third->arguments[0].offset == 0);
+        }
+
+        SUBCASE("should rethrow errors of kernels parsed in parallel") {
+            const auto input = std::make_shared<std::string>(
+                ".gpu Iceland\n"
+                ".kernel good\n"
+                "    .config\n"
+                "        .arg x, \"int\", int\n"
+                "    .text\n"
+                "/*000000000000*/ s_endpgm\n"
+                ".kernel bad\n"
+                "    .config\n"
+                "        .arg x, \"int\", int, global\n"
+                "    .text\n"
+                "/*000000000000*/ s_endpgm\n");
+            const auto result = BinaryAsmParser(input).parseAsm();
+            const auto& kernels = result->kernels;
+            REQUIRE(kernels.size() == 2);
+
+            CHECK_THROWS_AS(LazyKernel::parseAll(kernels),
+                            KernelArgumentInfoParseError);
+            CHECK(kernels[0]->isParsed());
+            CHECK(!kernels[1]->isParsed());
+            CHECK_THROWS_AS(kernels[1]->get(), KernelArgumentInfoParseError);
+        }
+    }
+}
@@ -1,4 +1,11 @@
 #include <common/test/doctest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include "runtime/icd/icd.h"
 #include "unit-test-common/test-commons.h"
@@ -15,25 +22,27 @@ TEST_SUITE("Command queue API") {
             CHECK(queue != nullptr);
         }
 
-        SUBCASE("profiling is not supported") {
+        SUBCASE("should create profiling command queue") {
             const auto context = test::getContext();
             cl_int error;
             const auto queue = clCreateCommandQueue(
                 context, context->device, CL_QUEUE_PROFILING_ENABLE, &error);
 
-            CHECK(error == CL_INVALID_QUEUE_PROPERTIES);
-            CHECK(queue == nullptr);
+            CHECK(error == CL_SUCCESS);
+            CHECK(queue != nullptr);
+            CHECK(queue->properties == CL_QUEUE_PROFILING_ENABLE);
         }
 
-        SUBCASE("out-of-order execution is not supported") {
+        SUBCASE("should create out-of-order command queue") {
             const auto context = test::getContext();
             cl_int error;
             const auto queue = clCreateCommandQueue(
                 context, context->device,
                 CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE, &error);
 
-            CHECK(error == CL_INVALID_QUEUE_PROPERTIES);
-            CHECK(queue == nullptr);
+            CHECK(error == CL_SUCCESS);
+            CHECK(queue != nullptr);
+            CHECK(queue->isOutOfOrder());
         }
 
         SUBCASE("reference count should be 1 after creation") {
@@ -42,7 +51,7 @@ TEST_SUITE("Command queue API") {
 
         SUBCASE("should retain context after created") {
             const auto context = test::getContext();
-            const auto initialRefCount = context->referenceCount;
+            const auto initialRefCount = context->referenceCount.load();
 
             cl_int error;
             const auto queue =
@@ -90,8 +99,72 @@ TEST_SUITE("Command queue API") {
     }
 
     TEST_CASE("clFlush") {
-        SUBCASE("calls clFinish") {
-            CHECK(clFlush(test::getCommandQueue()) == CL_SUCCESS);
+        SUBCASE("should submit commands") {
+            const auto queue = test::getCommandQueue();
+            queue->enqueue(std::make_shared<test::DummyCommand>());
+
+            CHECK(clFlush(queue) == CL_SUCCESS);
+
+            clFinish(queue);
+            CHECK(queue->size() == 0);
+        }
+
+        SUBCASE("should fail with null command queue") {
+            CHECK(clFlush(nullptr) == CL_INVALID_COMMAND_QUEUE);
+        }
+    }
+
+    TEST_CASE("clEnqueueMarkerWithWaitList") {
+        SUBCASE("should complete after previous commands") {
+            const auto queue = test::getCommandQueue();
+            queue->enqueue(std::make_shared<test::DummyCommand>());
+
+            cl_event event;
+            CHECK(clEnqueueMarkerWithWaitList(queue, 0, nullptr, &event) ==
+                  CL_SUCCESS);
+            CHECK(event->commandType == CL_COMMAND_MARKER);
+
+            clFinish(queue);
+            CHECK(event->isComplete());
+            event->release();
+        }
+
+        SUBCASE("should fail with null command queue") {
+            CHECK(clEnqueueMarkerWithWaitList(nullptr, 0, nullptr, nullptr) ==
+                  CL_INVALID_COMMAND_QUEUE);
+        }
+
+        SUBCASE("should fail with inconsistent wait list") {
+            CHECK(clEnqueueMarkerWithWaitList(test::getCommandQueue(), 1,
+                                              nullptr, nullptr) ==
+                  CL_INVALID_EVENT_WAIT_LIST);
+        }
+
+        SUBCASE("should fail with event of another context") {
+            const auto queue = test::getCommandQueue();
+            cl_event event;
+            clEnqueueMarkerWithWaitList(queue, 0, nullptr, &event);
+
+            CHECK(clEnqueueMarkerWithWaitList(test::getCommandQueue(), 1,
+                                              &event,
+                                              nullptr) == CL_INVALID_CONTEXT);
+
+            clFinish(queue);
+            event->release();
+        }
+    }
+
+    TEST_CASE("clEnqueueMarker") {
+        SUBCASE("should fail with null event") {
+            CHECK(clEnqueueMarker(test::getCommandQueue(), nullptr) ==
+                  CL_INVALID_VALUE);
+        }
+    }
+
+    TEST_CASE("clEnqueueWaitForEvents") {
+        SUBCASE("should fail with empty event list") {
+            CHECK(clEnqueueWaitForEvents(test::getCommandQueue(), 0,
+                                         nullptr) == CL_INVALID_VALUE);
         }
     }
 
@@ -126,7 +199,7 @@ TEST_SUITE("Command queue API") {
         SUBCASE("should release context upon deletion") {
             auto queue = test::getCommandQueue();
             auto context = queue->context;
-            const auto contextRefCount = context->referenceCount;
+            const auto contextRefCount = context->referenceCount.load();
             const auto error = clReleaseCommandQueue(queue);
 
             CHECK(error == CL_SUCCESS);
@@ -136,7 +209,7 @@ TEST_SUITE("Command queue API") {
         SUBCASE("should not be deleted if queue is not empty") {
             auto queue = test::getCommandQueue();
             auto context = queue->context;
-            const auto contextRefCount = context->referenceCount;
+            const auto contextRefCount = context->referenceCount.load();
 
             queue->enqueue(std::make_shared<test::DummyCommand>());
 
@@ -198,6 +271,57 @@ TEST_SUITE("Command queue API") {
     }
 }
 
+struct BlockingCommand : public Command {
+    explicit BlockingCommand(std::shared_future<void> released)
+        : released(std::move(released)) {}
+
+    void execute() const override {
+        released.wait();
+    }
+
+    std::shared_future<void> released;
+};
+
+struct RecordingCommand : public Command {
+    RecordingCommand(std::vector<int>& order, int index)
+        : order(order), index(index) {}
+
+    void execute() const override {
+        order.push_back(index);
+    }
+
+    std::vector<int>& order;
+    const int index;
+};
+
+struct LockedRecordingCommand : public Command {
+    LockedRecordingCommand(std::vector<int>& order,
+                           std::mutex& mutex,
+                           int index)
+        : order(order), mutex(mutex), index(index) {}
+
+    void execute() const override {
+        std::lock_guard<std::mutex> lock(mutex);
+        order.push_back(index);
+    }
+
+    std::vector<int>& order;
+    std::mutex& mutex;
+    const int index;
+};
+
+cl_command_queue getOutOfOrderCommandQueue() {
+    const auto context = test::getContext();
+    cl_int error;
+    const auto queue = clCreateCommandQueue(
+        context, context->device, CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE,
+        &error);
+
+    REQUIRE(error == CL_SUCCESS);
+
+    return queue;
+}
+
 TEST_SUITE("CLCommandQueue") {
     TEST_CASE("enqueue") {
         SUBCASE("should increment queue size") {
@@ -214,6 +338,26 @@ TEST_SUITE("CLCommandQueue") {
     }
 
     TEST_CASE("flush") {
+        SUBCASE("should not wait for commands to complete") {
+            auto queue = test::getCommandQueue();
+            std::promise<void> release;
+            auto released = release.get_future().share();
+
+            queue->enqueue(std::make_shared<BlockingCommand>(released));
+            queue->enqueue(std::make_shared<test::DummyCommand>());
+
+            queue->flush();
+
+            CHECK(queue->size() > 0);
+
+            release.set_value();
+            queue->finish();
+
+            CHECK(queue->size() == 0);
+        }
+    }
+
+    TEST_CASE("finish") {
         SUBCASE("should clear command queue") {
             auto queue = test::getCommandQueue();
             queue->enqueue(std::make_shared<test::DummyCommand>());
@@ -222,9 +366,238 @@ TEST_SUITE("CLCommandQueue") {
 
             CHECK(queue->size() == 3);
 
+            queue->finish();
+
+            CHECK(queue->size() == 0);
+        }
+
+        SUBCASE("should execute commands in submission order") {
+            auto queue = test::getCommandQueue();
+            std::vector<int> order;
+
+            for (int i = 0; i < 2000; ++i) {
+                queue->enqueue(std::make_shared<RecordingCommand>(order, i));
+            }
+            queue->finish();
+
+            CHECK(order.size() == 2000);
+            CHECK(std::is_sorted(order.begin(), order.end()));
+        }
+
+        SUBCASE("should accept commands from several threads") {
+            auto queue = test::getCommandQueue();
+            std::vector<std::thread> threads;
+
+            for (int i = 0; i < 4; ++i) {
+                threads.emplace_back([queue]() {
+                    for (int j = 0; j < 1000; ++j) {
+                        queue->enqueue(std::make_shared<test::DummyCommand>());
+                    }
+                });
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+            queue->finish();
+
+            CHECK(queue->size() == 0);
+        }
+
+        SUBCASE("should count references released by executed commands") {
+            auto queue = test::getCommandQueue();
+            const size_t bufferSize = 16;
+            const auto buffer = test::createBuffer(0, bufferSize);
+            const auto device = buffer->context->device;
+            const cl_uint data = 42;
+
+            // commands release the buffer on the executor meanwhile
+            for (int i = 0; i < 2000; ++i) {
+                clEnqueueWriteBuffer(queue, buffer, false, 0, sizeof(data),
+                                     &data, 0, nullptr, nullptr);
+                clRetainMemObject(buffer);
+                clReleaseMemObject(buffer);
+                if (i % 100 == 0) {
+                    clFlush(queue);
+                }
+            }
+            clFinish(queue);
+
+            CHECK(buffer->referenceCount == 1);
+            const auto usedMemory = device->usedGlobalMemory.load();
+            clReleaseMemObject(buffer);
+            CHECK(device->usedGlobalMemory == usedMemory - bufferSize);
+        }
+    }
+
+    TEST_CASE("out-of-order execution") {
+        SUBCASE("independent commands should run concurrently") {
+            auto queue = getOutOfOrderCommandQueue();
+            std::promise<void> release;
+            auto released = release.get_future().share();
+
+            cl_event blocked;
+            cl_event independent;
+            queue->enqueue(std::make_shared<BlockingCommand>(released), 0,
+                           nullptr, &blocked);
+            queue->enqueue(std::make_shared<test::DummyCommand>(), 0, nullptr,
+                           &independent);
             queue->flush();
 
+            independent->wait();
+            CHECK(!blocked->isComplete());
+
+            release.set_value();
+            queue->finish();
+
+            CHECK(blocked->isComplete());
+            CHECK(queue->size() == 0);
+            blocked->release();
+            independent->release();
+        }
+
+        SUBCASE("should respect event wait list") {
+            auto queue = getOutOfOrderCommandQueue();
+            std::promise<void> release;
+            auto released = release.get_future().share();
+            std::vector<int> order;
+            std::mutex mutex;
+
+            cl_event first;
+            queue->enqueue(std::make_shared<BlockingCommand>(released), 0,
+                           nullptr, &first);
+            cl_event second;
+            queue->enqueue(
+                std::make_shared<LockedRecordingCommand>(order, mutex, 1), 1,
+                &first, &second);
+            queue->flush();
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            CHECK(!second->isComplete());
+
+            release.set_value();
+            second->wait();
+
+            CHECK(first->isComplete());
+            CHECK(order == std::vector<int>{1});
+            first->release();
+            second->release();
+        }
+
+        SUBCASE("barrier should order commands around it") {
+            auto queue = getOutOfOrderCommandQueue();
+            std::vector<int> order;
+            std::mutex mutex;
+
+            for (int i = 0; i < 8; ++i) {
+                queue->enqueue(
+                    std::make_shared<LockedRecordingCommand>(order, mutex, 0));
+            }
+            CHECK(clEnqueueBarrier(queue) == CL_SUCCESS);
+            for (int i = 0; i < 8; ++i) {
+                queue->enqueue(
+                    std::make_shared<LockedRecordingCommand>(order, mutex, 1));
+            }
+            queue->finish();
+
+            CHECK(order.size() == 16);
+            CHECK(std::is_sorted(order.begin(), order.end()));
+        }
+
+        SUBCASE("finish should wait for every command") {
+            auto queue = getOutOfOrderCommandQueue();
+            std::atomic<int> executed{0};
+
+            struct CountingCommand : public Command {
+                explicit CountingCommand(std::atomic<int>& executed)
+                    : executed(executed) {}
+
+                void execute() const override {
+                    executed++;
+                }
+
+                std::atomic<int>& executed;
+            };
+
+            for (int i = 0; i < 1000; ++i) {
+                queue->enqueue(std::make_shared<CountingCommand>(executed));
+            }
+            queue->finish();
+
+            CHECK(executed == 1000);
+            CHECK(queue->size() == 0);
+        }
+    }
+
+    TEST_CASE("transfer coalescing") {
+        SUBCASE("should elide write overwritten before it is read") {
+            const auto buffer = test::createBuffer(0, 16);
+            std::byte first[8];
+            std::byte second[8];
+
+            BufferTransferBatchCommand batch(buffer);
+            batch.addWrite(BufferWriteCommand(buffer, 8, 0, first));
+            batch.addWrite(BufferWriteCommand(buffer, 8, 0, second));
+            batch.optimize();
+
+            REQUIRE(batch.segments.size() == 1);
+            CHECK(batch.segments[0].hostPtr == second);
+        }
+
+        SUBCASE("should keep write read before it is overwritten") {
+            const auto buffer = test::createBuffer(0, 16);
+            std::byte first[8];
+            std::byte out[4];
+            std::byte second[8];
+
+            BufferTransferBatchCommand batch(buffer);
+            batch.addWrite(BufferWriteCommand(buffer, 8, 0, first));
+            batch.addRead(BufferReadCommand(buffer, 4, 4, out));
+            batch.addWrite(BufferWriteCommand(buffer, 8, 0, second));
+            batch.optimize();
+
+            CHECK(batch.segments.size() == 3);
+        }
+
+        SUBCASE("should join contiguous writes") {
+            const auto buffer = test::createBuffer(0, 16);
+            std::byte data[12];
+
+            BufferTransferBatchCommand batch(buffer);
+            batch.addWrite(BufferWriteCommand(buffer, 4, 0, data));
+            batch.addWrite(BufferWriteCommand(buffer, 4, 4, data + 4));
+            batch.addWrite(BufferWriteCommand(buffer, 4, 12, data + 8));
+            batch.optimize();
+
+            REQUIRE(batch.segments.size() == 2);
+            CHECK(batch.segments[0].size == 8);
+            CHECK(batch.segments[1].offset == 12);
+        }
+
+        SUBCASE("queue should complete every coalesced transfer") {
+            const auto queue = test::getCommandQueue();
+            const auto buffer = test::createBuffer(0, 64 * sizeof(cl_uint));
+            std::vector<cl_uint> data(64);
+            std::vector<cl_event> events(64);
+
+            for (cl_uint i = 0; i < 64; ++i) {
+                data[i] = i;
+                CHECK(clEnqueueWriteBuffer(queue, buffer, false,
+                                           i * sizeof(cl_uint),
+                                           sizeof(cl_uint), &data[i], 0,
+                                           nullptr, &events[i]) == CL_SUCCESS);
+            }
+
+            std::vector<cl_uint> out(64);
+            CHECK(clEnqueueReadBuffer(queue, buffer, true, 0,
+                                      64 * sizeof(cl_uint), out.data(), 0,
+                                      nullptr, nullptr) == CL_SUCCESS);
+
+            CHECK(out == data);
             CHECK(queue->size() == 0);
+            for (auto event : events) {
+                CHECK(event->getStatus() == CL_COMPLETE);
+                clReleaseEvent(event);
+            }
         }
     }
 }
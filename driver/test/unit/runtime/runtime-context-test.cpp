@@ -68,7 +68,7 @@ TEST_SUITE("Context API") {
     TEST_CASE("clRetainContext") {
         SUBCASE("should increment context reference count") {
             auto context = test::getContext();
-            const auto refCount = context->referenceCount;
+            const auto refCount = context->referenceCount.load();
             const auto error = clRetainContext(context);
 
             CHECK(error == CL_SUCCESS);
@@ -87,7 +87,7 @@ TEST_SUITE("Context API") {
 
             clRetainContext(context);
 
-            const auto refCount = context->referenceCount;
+            const auto refCount = context->referenceCount.load();
 
             const auto error = clReleaseContext(context);
 
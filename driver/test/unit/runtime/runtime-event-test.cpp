@@ -0,0 +1,433 @@
+#include <common/test/doctest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include "runtime/icd/icd.h"
+#include "unit-test-common/test-commons.h"
+
+cl_event createUserEvent() {
+    cl_int error;
+    const auto event = clCreateUserEvent(test::getContext(), &error);
+
+    REQUIRE(error == CL_SUCCESS);
+    REQUIRE(event != nullptr);
+
+    return event;
+}
+
+struct CallbackRecord {
+    std::promise<std::pair<cl_event, cl_int>> called;
+};
+
+void CL_CALLBACK recordCallback(cl_event event, cl_int status, void* data) {
+    static_cast<CallbackRecord*>(data)->called.set_value({event, status});
+}
+
+TEST_SUITE("Event API") {
+    TEST_CASE("clCreateUserEvent") {
+        SUBCASE("should create submitted user event") {
+            const auto event = createUserEvent();
+
+            CHECK(event->commandType == CL_COMMAND_USER);
+            CHECK(event->getStatus() == CL_SUBMITTED);
+            CHECK(event->queue == nullptr);
+            CHECK(event->referenceCount == 1);
+        }
+
+        SUBCASE("should fail with null context") {
+            cl_int error;
+            const auto event = clCreateUserEvent(nullptr, &error);
+
+            CHECK(error == CL_INVALID_CONTEXT);
+            CHECK(event == nullptr);
+        }
+    }
+
+    TEST_CASE("clSetUserEventStatus") {
+        SUBCASE("should complete user event") {
+            const auto event = createUserEvent();
+
+            CHECK(clSetUserEventStatus(event, CL_COMPLETE) == CL_SUCCESS);
+            CHECK(event->getStatus() == CL_COMPLETE);
+        }
+
+        SUBCASE("should accept error status") {
+            const auto event = createUserEvent();
+
+            CHECK(clSetUserEventStatus(event, -42) == CL_SUCCESS);
+            CHECK(event->getStatus() == -42);
+        }
+
+        SUBCASE("should fail if status is already set") {
+            const auto event = createUserEvent();
+            clSetUserEventStatus(event, CL_COMPLETE);
+
+            CHECK(clSetUserEventStatus(event, CL_COMPLETE) ==
+                  CL_INVALID_OPERATION);
+        }
+
+        SUBCASE("should fail with non-terminal status") {
+            CHECK(clSetUserEventStatus(createUserEvent(), CL_RUNNING) ==
+                  CL_INVALID_VALUE);
+        }
+
+        SUBCASE("should fail with command event") {
+            const auto queue = test::getCommandQueue();
+            cl_event event;
+            clEnqueueMarker(queue, &event);
+
+            CHECK(clSetUserEventStatus(event, CL_COMPLETE) ==
+                  CL_INVALID_EVENT);
+
+            clFinish(queue);
+        }
+    }
+
+    TEST_CASE("clWaitForEvents") {
+        SUBCASE("should wait for event completed by another thread") {
+            const auto event = createUserEvent();
+            std::thread completer([event]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                clSetUserEventStatus(event, CL_COMPLETE);
+            });
+
+            CHECK(clWaitForEvents(1, &event) == CL_SUCCESS);
+            CHECK(event->getStatus() == CL_COMPLETE);
+
+            completer.join();
+        }
+
+        SUBCASE("should flush queues of the events") {
+            const auto queue = test::getCommandQueue();
+            cl_event events[2];
+            clEnqueueMarker(queue, &events[0]);
+            clEnqueueMarker(queue, &events[1]);
+
+            CHECK(clWaitForEvents(2, events) == CL_SUCCESS);
+            CHECK(events[0]->isComplete());
+            CHECK(events[1]->isComplete());
+        }
+
+        SUBCASE("should report failed events") {
+            const auto event = createUserEvent();
+            clSetUserEventStatus(event, -1);
+
+            CHECK(clWaitForEvents(1, &event) ==
+                  CL_EXEC_STATUS_ERROR_FOR_EVENTS_IN_WAIT_LIST);
+        }
+
+        SUBCASE("should fail with empty list") {
+            CHECK(clWaitForEvents(0, nullptr) == CL_INVALID_VALUE);
+        }
+
+        SUBCASE("should fail with null event") {
+            cl_event events[2] = {createUserEvent(), nullptr};
+
+            CHECK(clWaitForEvents(2, events) == CL_INVALID_EVENT);
+        }
+
+        SUBCASE("should fail with events of different contexts") {
+            cl_event events[2] = {createUserEvent(), createUserEvent()};
+
+            CHECK(clWaitForEvents(2, events) == CL_INVALID_CONTEXT);
+        }
+    }
+
+    TEST_CASE("clGetEventInfo") {
+        SUBCASE("should fail with null event") {
+            CHECK(clGetEventInfo(nullptr, CL_EVENT_CONTEXT, 0, nullptr,
+                                 nullptr) == CL_INVALID_EVENT);
+        }
+
+        SUBCASE("should get command queue and type") {
+            const auto queue = test::getCommandQueue();
+            cl_event event;
+            clEnqueueMarker(queue, &event);
+            clFinish(queue);
+
+            cl_command_queue eventQueue;
+            CHECK(clGetEventInfo(event, CL_EVENT_COMMAND_QUEUE,
+                                 sizeof(cl_command_queue), &eventQueue,
+                                 nullptr) == CL_SUCCESS);
+            CHECK(eventQueue == queue);
+
+            cl_command_type type;
+            CHECK(clGetEventInfo(event, CL_EVENT_COMMAND_TYPE,
+                                 sizeof(cl_command_type), &type,
+                                 nullptr) == CL_SUCCESS);
+            CHECK(type == CL_COMMAND_MARKER);
+        }
+
+        SUBCASE("should get task command type") {
+            const auto queue = test::getCommandQueue();
+            const auto kernel = test::getKernel(
+                "test/resources/kernels/a_plus_b.bin", "a_plus_b");
+            const cl_uint data[1] = {1};
+            const auto buffer = test::createBuffer(
+                CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR, sizeof(data), data);
+            for (cl_uint i = 0; i < 3; ++i) {
+                clSetKernelArg(kernel, i, sizeof(cl_mem), &buffer);
+            }
+
+            cl_event event;
+            REQUIRE(clEnqueueTask(queue, kernel, 0, nullptr, &event) ==
+                    CL_SUCCESS);
+            clFinish(queue);
+
+            cl_command_type type;
+            CHECK(clGetEventInfo(event, CL_EVENT_COMMAND_TYPE,
+                                 sizeof(cl_command_type), &type,
+                                 nullptr) == CL_SUCCESS);
+            CHECK(type == CL_COMMAND_TASK);
+        }
+
+        SUBCASE("should get context") {
+            const auto event = createUserEvent();
+
+            cl_context context;
+            CHECK(clGetEventInfo(event, CL_EVENT_CONTEXT, sizeof(cl_context),
+                                 &context, nullptr) == CL_SUCCESS);
+            CHECK(context == event->context);
+        }
+
+        SUBCASE("should get execution status") {
+            const auto event = createUserEvent();
+            clSetUserEventStatus(event, -5);
+
+            cl_int status;
+            CHECK(clGetEventInfo(event, CL_EVENT_COMMAND_EXECUTION_STATUS,
+                                 sizeof(cl_int), &status,
+                                 nullptr) == CL_SUCCESS);
+            CHECK(status == -5);
+        }
+
+        SUBCASE("should get ref count") {
+            const auto event = createUserEvent();
+            clRetainEvent(event);
+
+            cl_uint refCount;
+            CHECK(clGetEventInfo(event, CL_EVENT_REFERENCE_COUNT,
+                                 sizeof(cl_uint), &refCount,
+                                 nullptr) == CL_SUCCESS);
+            CHECK(refCount == 2);
+        }
+    }
+
+    TEST_CASE("clRetainEvent / clReleaseEvent") {
+        SUBCASE("should change ref count") {
+            const auto event = createUserEvent();
+
+            CHECK(clRetainEvent(event) == CL_SUCCESS);
+            CHECK(event->referenceCount == 2);
+
+            CHECK(clReleaseEvent(event) == CL_SUCCESS);
+            CHECK(event->referenceCount == 1);
+        }
+
+        SUBCASE("released event should be reused") {
+            const auto event = createUserEvent();
+            clReleaseEvent(event);
+
+            CHECK(createUserEvent() == event);
+        }
+
+        SUBCASE("should fail with null event") {
+            CHECK(clRetainEvent(nullptr) == CL_INVALID_EVENT);
+            CHECK(clReleaseEvent(nullptr) == CL_INVALID_EVENT);
+        }
+    }
+
+    TEST_CASE("clSetEventCallback") {
+        SUBCASE("should call callback on completion") {
+            const auto event = createUserEvent();
+            CallbackRecord record;
+            auto called = record.called.get_future();
+
+            CHECK(clSetEventCallback(event, CL_COMPLETE, recordCallback,
+                                     &record) == CL_SUCCESS);
+            CHECK(called.wait_for(std::chrono::milliseconds(10)) ==
+                  std::future_status::timeout);
+
+            clSetUserEventStatus(event, CL_COMPLETE);
+
+            const auto [calledEvent, status] = called.get();
+            CHECK(calledEvent == event);
+            CHECK(status == CL_COMPLETE);
+        }
+
+        SUBCASE("should call callback of reached status immediately") {
+            const auto event = createUserEvent();
+            CallbackRecord record;
+            auto called = record.called.get_future();
+
+            clSetEventCallback(event, CL_SUBMITTED, recordCallback, &record);
+
+            CHECK(called.get().second == CL_SUBMITTED);
+        }
+
+        SUBCASE("should pass error status to completion callback") {
+            const auto event = createUserEvent();
+            CallbackRecord record;
+            auto called = record.called.get_future();
+
+            clSetEventCallback(event, CL_COMPLETE, recordCallback, &record);
+            clSetUserEventStatus(event, -3);
+
+            CHECK(called.get().second == -3);
+        }
+
+        SUBCASE("should not be called on the setting thread") {
+            const auto event = createUserEvent();
+            std::promise<std::thread::id> calledOn;
+            auto callbackThread = calledOn.get_future();
+
+            clSetEventCallback(
+                event, CL_COMPLETE,
+                [](cl_event, cl_int, void* data) {
+                    static_cast<std::promise<std::thread::id>*>(data)
+                        ->set_value(std::this_thread::get_id());
+                },
+                &calledOn);
+            clSetUserEventStatus(event, CL_COMPLETE);
+
+            CHECK(callbackThread.get() != std::this_thread::get_id());
+        }
+
+        SUBCASE("should fail with invalid callback type") {
+            CHECK(clSetEventCallback(createUserEvent(), CL_QUEUED,
+                                     recordCallback,
+                                     nullptr) == CL_INVALID_VALUE);
+        }
+
+        SUBCASE("should fail with null callback") {
+            CHECK(clSetEventCallback(createUserEvent(), CL_COMPLETE, nullptr,
+                                     nullptr) == CL_INVALID_VALUE);
+        }
+    }
+
+    TEST_CASE("Enqueue with events") {
+        SUBCASE("should return completed event of command") {
+            const auto queue = test::getCommandQueue();
+            const auto buffer = test::createBuffer();
+            std::byte data[4]{};
+
+            cl_event event;
+            CHECK(clEnqueueWriteBuffer(queue, buffer, true, 0, sizeof(data),
+                                       data, 0, nullptr,
+                                       &event) == CL_SUCCESS);
+            CHECK(event->commandType == CL_COMMAND_WRITE_BUFFER);
+            CHECK(event->getStatus() == CL_COMPLETE);
+            clReleaseEvent(event);
+        }
+
+        SUBCASE("should wait for user event") {
+            const auto queue = test::getCommandQueue();
+            const auto buffer = test::createBuffer();
+            const auto userEvent = createUserEvent();
+            std::byte data[4]{};
+
+            cl_event event;
+            CHECK(clEnqueueReadBuffer(queue, buffer, false, 0, sizeof(data),
+                                      data, 1, &userEvent,
+                                      &event) == CL_INVALID_CONTEXT);
+
+            cl_int error;
+            const auto context = queue->context;
+            const auto contextUserEvent = clCreateUserEvent(context, &error);
+            CHECK(clEnqueueReadBuffer(queue, buffer, false, 0, sizeof(data),
+                                      data, 1, &contextUserEvent,
+                                      &event) == CL_SUCCESS);
+            clFlush(queue);
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            CHECK(event->getStatus() == CL_SUBMITTED);
+
+            clSetUserEventStatus(contextUserEvent, CL_COMPLETE);
+            CHECK(clWaitForEvents(1, &event) == CL_SUCCESS);
+        }
+
+        SUBCASE("should fail command if its dependency failed") {
+            const auto queue = test::getCommandQueue();
+            const auto userEvent = clCreateUserEvent(queue->context, nullptr);
+
+            cl_event event;
+            clEnqueueMarkerWithWaitList(queue, 1, &userEvent, &event);
+            clSetUserEventStatus(userEvent, -1);
+
+            CHECK(clWaitForEvents(1, &event) ==
+                  CL_EXEC_STATUS_ERROR_FOR_EVENTS_IN_WAIT_LIST);
+            CHECK(event->getStatus() ==
+                  CL_EXEC_STATUS_ERROR_FOR_EVENTS_IN_WAIT_LIST);
+        }
+    }
+
+    TEST_CASE("clGetEventProfilingInfo") {
+        SUBCASE("should return ordered timestamps of command") {
+            const auto context = test::getContext();
+            const auto queue = clCreateCommandQueue(
+                context, context->device, CL_QUEUE_PROFILING_ENABLE, nullptr);
+            const auto buffer = test::createBuffer();
+            std::byte data[4]{};
+
+            cl_event event;
+            clEnqueueWriteBuffer(queue, buffer, true, 0, sizeof(data), data, 0,
+                                 nullptr, &event);
+
+            const cl_profiling_info params[] = {
+                CL_PROFILING_COMMAND_QUEUED, CL_PROFILING_COMMAND_SUBMIT,
+                CL_PROFILING_COMMAND_START, CL_PROFILING_COMMAND_END};
+            std::vector<cl_ulong> times;
+            for (auto param : params) {
+                cl_ulong time;
+                CHECK(clGetEventProfilingInfo(event, param, sizeof(cl_ulong),
+                                              &time, nullptr) == CL_SUCCESS);
+                times.push_back(time);
+            }
+
+            CHECK(times[0] > 0);
+            CHECK(std::is_sorted(times.begin(), times.end()));
+            clReleaseEvent(event);
+        }
+
+        SUBCASE("should not be available without profiling") {
+            const auto queue = test::getCommandQueue();
+            cl_event event;
+            clEnqueueMarker(queue, &event);
+            clFinish(queue);
+
+            cl_ulong time;
+            CHECK(clGetEventProfilingInfo(event, CL_PROFILING_COMMAND_END,
+                                          sizeof(cl_ulong), &time, nullptr) ==
+                  CL_PROFILING_INFO_NOT_AVAILABLE);
+        }
+
+        SUBCASE("should not be available for user event") {
+            const auto event = createUserEvent();
+            clSetUserEventStatus(event, CL_COMPLETE);
+
+            cl_ulong time;
+            CHECK(clGetEventProfilingInfo(event, CL_PROFILING_COMMAND_END,
+                                          sizeof(cl_ulong), &time, nullptr) ==
+                  CL_PROFILING_INFO_NOT_AVAILABLE);
+        }
+
+        SUBCASE("should fail with unknown parameter") {
+            const auto context = test::getContext();
+            const auto queue = clCreateCommandQueue(
+                context, context->device, CL_QUEUE_PROFILING_ENABLE, nullptr);
+            cl_event event;
+            clEnqueueMarker(queue, &event);
+            clFinish(queue);
+
+            cl_ulong time;
+            CHECK(clGetEventProfilingInfo(event, CL_EVENT_CONTEXT,
+                                          sizeof(cl_ulong), &time,
+                                          nullptr) == CL_INVALID_VALUE);
+        }
+    }
+}
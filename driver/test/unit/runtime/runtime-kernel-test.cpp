@@ -2,6 +2,7 @@
 
 #include <runtime/runtime-commons.h>
 #include <common/utils/vector-utils.hpp>
+#include <cstring>
 #include <vector>
 
 #include "runtime/icd/CLProgram.hpp"
@@ -16,7 +17,7 @@ TEST_SUITE("Kernel API") {
     TEST_CASE("clCreateKernel") {
         SUBCASE("can get kernel by name") {
             auto program = test::getProgram(binaryPath);
-            const auto programInitRefCount = program->referenceCount;
+            const auto programInitRefCount = program->referenceCount.load();
 
             cl_int error;
             const auto kernel = clCreateKernel(program, kernelName, &error);
@@ -25,6 +26,52 @@ TEST_SUITE("Kernel API") {
             CHECK(kernel->referenceCount == 1);
             CHECK(program->referenceCount == programInitRefCount + 1);
         }
+
+        SUBCASE("fails if there is no kernel with the name") {
+            auto program = test::getProgram(binaryPath);
+
+            cl_int error;
+            const auto kernel = clCreateKernel(program, "a_minus_b", &error);
+
+            CHECK(error == CL_INVALID_KERNEL_NAME);
+            CHECK(kernel == nullptr);
+        }
+
+        SUBCASE("parses kernel on first use") {
+            auto program = test::getProgram(binaryPath);
+            const auto& lazyKernel = program->disassembledBinary->kernels[0];
+            CHECK(!lazyKernel->isParsed());
+
+            cl_int error;
+            const auto kernel = clCreateKernel(program, kernelName, &error);
+
+            CHECK(error == CL_SUCCESS);
+            CHECK(lazyKernel->isParsed());
+            CHECK(kernel->definition == lazyKernel->get());
+        }
+
+        SUBCASE("creates a separate kernel on every call") {
+            auto program = test::getProgram(binaryPath);
+
+            cl_int error;
+            const auto first = clCreateKernel(program, kernelName, &error);
+            const auto second = clCreateKernel(program, kernelName, &error);
+
+            CHECK(error == CL_SUCCESS);
+            CHECK(first != second);
+            CHECK(first->definition == second->definition);
+
+            clSetKernelArg(first, 0, 0, nullptr);
+            CHECK(first->getArgument(0).isSet);
+            CHECK(!second->getArgument(0).isSet);
+
+            clReleaseKernel(first);
+            const auto third = clCreateKernel(program, kernelName, &error);
+
+            CHECK(error == CL_SUCCESS);
+            CHECK(third->referenceCount == 1);
+            CHECK(!third->getArgument(0).isSet);
+        }
     }
 
     TEST_CASE("clCreateKernelsInProgram") {
@@ -116,7 +163,7 @@ TEST_SUITE("Kernel API") {
 
             auto program = test::getProgram(
                 "test/resources/kernels/addition/addition.bin");
-            const auto programInitRefCount = program->referenceCount;
+            const auto programInitRefCount = program->referenceCount.load();
 
             cl_uint kernelNum;
             error = clCreateKernelsInProgram(program, 0, nullptr, &kernelNum);
@@ -157,7 +204,8 @@ TEST_SUITE("Kernel API") {
             const auto buffer =
                 test::createBuffer(CL_MEM_USE_HOST_PTR, sizeBytes, &vector);
 
-            const auto error = clSetKernelArg(kernel, 0, sizeBytes, &buffer);
+            const auto error =
+                clSetKernelArg(kernel, 0, sizeof(cl_mem), &buffer);
 
             CHECK(error == CL_SUCCESS);
         }
@@ -168,7 +216,54 @@ TEST_SUITE("Kernel API") {
             const auto error = clSetKernelArg(kernel, 0, 0, nullptr);
 
             CHECK(error == CL_SUCCESS);
-            CHECK(kernel->getArgument(0).value.has_value());
+            CHECK(kernel->getArgument(0).isSet);
+        }
+
+        SUBCASE("writes arguments to their kernarg slots") {
+            const auto kernel = test::getKernel(
+                "test/resources/kernels/addition/addition.bin", "add_x_x");
+            const auto buffer =
+                test::createBuffer(CL_MEM_READ_WRITE, sizeof(cl_int));
+            const cl_int x = 7;
+
+            CHECK(clSetKernelArg(kernel, 0, sizeof(cl_mem), &buffer) ==
+                  CL_SUCCESS);
+            CHECK(clSetKernelArg(kernel, 1, sizeof(x), &x) == CL_SUCCESS);
+
+            // after six 64-bit hidden arguments
+            CHECK(kernel->getArgument(0).offset == 0x30);
+            CHECK(kernel->getArgument(0).memory == buffer);
+            CHECK(kernel->getArgument(1).offset == 0x38);
+
+            const auto& block = kernel->getKernargBlock();
+            void* address;
+            cl_int value;
+            memcpy(&address, block.data() + 0x30, sizeof(address));
+            memcpy(&value, block.data() + 0x38, sizeof(value));
+            CHECK(address == buffer->address);
+            CHECK(value == x);
+        }
+
+        SUBCASE("fails if size of value argument does not match") {
+            const auto kernel = test::getKernel(
+                "test/resources/kernels/addition/addition.bin", "add_x_x");
+            const cl_long x = 7;
+
+            const auto error = clSetKernelArg(kernel, 1, sizeof(x), &x);
+
+            CHECK(error == CL_INVALID_ARG_SIZE);
+            CHECK(!kernel->getArgument(1).isSet);
+        }
+
+        SUBCASE("fails if size of mem object argument does not match") {
+            const auto kernel = test::getKernel(binaryPath, kernelName);
+            const auto buffer = test::createBuffer(0, sizeof(cl_uint));
+
+            const auto error =
+                clSetKernelArg(kernel, 0, sizeof(cl_uint), &buffer);
+
+            CHECK(error == CL_INVALID_ARG_SIZE);
+            CHECK(!kernel->getArgument(0).isSet);
         }
 
         SUBCASE("fails if index is out of bounds") {
@@ -184,7 +279,7 @@ TEST_SUITE("Kernel API") {
     TEST_CASE("clRetainKernel") {
         SUBCASE("increments kernel ref count") {
             const auto kernel = test::getKernel(binaryPath, kernelName);
-            const auto initRefCount = kernel->referenceCount;
+            const auto initRefCount = kernel->referenceCount.load();
 
             const auto error = clRetainKernel(kernel);
             CHECK(error == CL_SUCCESS);
@@ -197,7 +292,7 @@ TEST_SUITE("Kernel API") {
             const auto kernel = test::getKernel(binaryPath, kernelName);
 
             clRetainKernel(kernel);
-            const auto initRefCount = kernel->referenceCount;
+            const auto initRefCount = kernel->referenceCount.load();
 
             const auto error = clReleaseKernel(kernel);
 
@@ -263,6 +358,79 @@ TEST_SUITE("Kernel API") {
                       return std::to_string(value);
                   }) == "0 0 0");
         }
+
+        SUBCASE("keeps arguments set when it was enqueued") {
+            const auto queue = test::getCommandQueue();
+            const auto kernel = test::getKernel(binaryPath, kernelName);
+            cl_uint data[1] = {2};
+            const auto input = test::createBuffer(
+                CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, sizeof(data), data);
+            const auto enqueued = test::createBuffer(
+                CL_MEM_WRITE_ONLY | CL_MEM_COPY_HOST_PTR, sizeof(data), data);
+            const auto later = test::createBuffer(
+                CL_MEM_WRITE_ONLY | CL_MEM_COPY_HOST_PTR, sizeof(data), data);
+
+            clSetKernelArg(kernel, 0, sizeof(cl_mem), &input);
+            clSetKernelArg(kernel, 1, sizeof(cl_mem), &input);
+            clSetKernelArg(kernel, 2, sizeof(cl_mem), &enqueued);
+
+            cl_int error;
+            const auto gate = clCreateUserEvent(queue->context, &error);
+            {
+                // the caller's sizes are gone before the launch runs
+                const size_t globalWorkSize[1] = {1};
+                error = clEnqueueNDRangeKernel(queue, kernel, 1, nullptr,
+                                               globalWorkSize, nullptr, 1,
+                                               &gate, nullptr);
+                CHECK(error == CL_SUCCESS);
+            }
+
+            clSetKernelArg(kernel, 2, sizeof(cl_mem), &later);
+            clSetUserEventStatus(gate, CL_COMPLETE);
+            clFinish(queue);
+
+            cl_uint enqueuedData;
+            cl_uint laterData;
+            clEnqueueReadBuffer(queue, enqueued, true, 0, sizeof(cl_uint),
+                                &enqueuedData, 0, nullptr, nullptr);
+            clEnqueueReadBuffer(queue, later, true, 0, sizeof(cl_uint),
+                                &laterData, 0, nullptr, nullptr);
+            CHECK(enqueuedData == 0);
+            CHECK(laterData == 2);
+            CHECK(kernel->getArgument(2).memory == later);
+            clReleaseEvent(gate);
+        }
+
+        SUBCASE("can be relaunched while earlier launches run") {
+            const auto queue = test::getCommandQueue();
+            const auto kernel = test::getKernel(binaryPath, kernelName);
+            cl_uint data[1] = {2};
+            const auto input = test::createBuffer(
+                CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, sizeof(data), data);
+            const auto outputs = std::vector<cl_mem>{
+                test::createBuffer(CL_MEM_WRITE_ONLY, sizeof(data)),
+                test::createBuffer(CL_MEM_WRITE_ONLY, sizeof(data))};
+
+            clSetKernelArg(kernel, 0, sizeof(cl_mem), &input);
+            clSetKernelArg(kernel, 1, sizeof(cl_mem), &input);
+
+            const size_t globalWorkSize[1] = {1};
+            for (int i = 0; i < 2000; ++i) {
+                clSetKernelArg(kernel, 2, sizeof(cl_mem), &outputs[i % 2]);
+                clEnqueueNDRangeKernel(queue, kernel, 1, nullptr,
+                                       globalWorkSize, nullptr, 0, nullptr,
+                                       nullptr);
+                if (i % 100 == 0) {
+                    clFlush(queue);
+                }
+            }
+            clFinish(queue);
+
+            CHECK(kernel->referenceCount == 1);
+            CHECK(input->referenceCount == 1);
+            CHECK(outputs[0]->referenceCount == 1);
+            CHECK(outputs[1]->referenceCount == 1);
+        }
     }
 
     TEST_CASE("clEnqueueTask") {
@@ -37,7 +37,7 @@ TEST_SUITE("Memory buffer API") {
 
         SUBCASE("retains context") {
             auto context = test::getContext();
-            const auto initialRefCount = context->referenceCount;
+            const auto initialRefCount = context->referenceCount.load();
 
             cl_int error;
             cl_mem buffer = clCreateBuffer(context, 0, 16, nullptr, &error);
@@ -49,7 +49,7 @@ TEST_SUITE("Memory buffer API") {
         SUBCASE("increments device memory size") {
             auto context = test::getContext();
             const auto initialUsedGlobalMemorySize =
-                context->device->usedGlobalMemory;
+                context->device->usedGlobalMemory.load();
             const auto bufferSize = 16;
 
             cl_int error;
@@ -273,6 +273,164 @@ TEST_SUITE("Memory buffer API") {
                 CHECK(data[0] == 20);
             }
         }
+
+        SUBCASE("large buffer is zeroed and aligned") {
+            const size_t size = 3 * 1024 * 1024 + 5;
+            const auto buffer = test::createBuffer(CL_MEM_ALLOC_HOST_PTR, size);
+
+            CHECK(reinterpret_cast<uintptr_t>(buffer->address) % 65536 == 0);
+            CHECK(std::all_of(
+                buffer->address, buffer->address + size,
+                [](std::byte value) { return value == std::byte{0}; }));
+
+            clReleaseMemObject(buffer);
+        }
+
+        SUBCASE("releasing CL_MEM_USE_HOST_PTR buffer keeps host memory") {
+            std::vector<cl_uint> data{1, 2, 3};
+            const auto buffer =
+                test::createBuffer(CL_MEM_USE_HOST_PTR,
+                                   data.size() * sizeof(cl_uint), data.data());
+
+            clReleaseMemObject(buffer);
+
+            CHECK(data[2] == 3);
+        }
+    }
+
+    TEST_CASE("clCreateSubBuffer") {
+        const auto alignment = test::getDevice()->memoryBaseAddressAlignment;
+
+        SUBCASE("should be a view into the buffer") {
+            const auto queue = test::getCommandQueue();
+            const auto buffer = test::createBuffer(0, alignment * 4);
+            const cl_buffer_region region{alignment, alignment};
+
+            cl_int error;
+            const auto subBuffer =
+                clCreateSubBuffer(buffer, 0, CL_BUFFER_CREATE_TYPE_REGION,
+                                  &region, &error);
+            REQUIRE(error == CL_SUCCESS);
+            CHECK(subBuffer->address == buffer->address + alignment);
+
+            const cl_uint value = 42;
+            clEnqueueWriteBuffer(queue, subBuffer, true, 0, sizeof(cl_uint),
+                                 &value, 0, nullptr, nullptr);
+            cl_uint out = 0;
+            clEnqueueReadBuffer(queue, buffer, true, alignment,
+                                sizeof(cl_uint), &out, 0, nullptr, nullptr);
+            CHECK(out == value);
+
+            cl_mem associated;
+            clGetMemObjectInfo(subBuffer, CL_MEM_ASSOCIATED_MEMOBJECT,
+                               sizeof(cl_mem), &associated, nullptr);
+            CHECK(associated == buffer);
+            size_t offset;
+            clGetMemObjectInfo(subBuffer, CL_MEM_OFFSET, sizeof(size_t),
+                               &offset, nullptr);
+            CHECK(offset == alignment);
+        }
+
+        SUBCASE("should keep the buffer alive") {
+            const auto buffer = test::createBuffer(0, alignment * 2);
+            const auto device = buffer->context->device;
+            const auto usedMemory = device->usedGlobalMemory.load();
+            const cl_buffer_region region{0, alignment};
+
+            const auto subBuffer = clCreateSubBuffer(
+                buffer, 0, CL_BUFFER_CREATE_TYPE_REGION, &region, nullptr);
+            CHECK(buffer->referenceCount == 2);
+            CHECK(device->usedGlobalMemory == usedMemory);
+
+            clReleaseMemObject(buffer);
+            CHECK(buffer->referenceCount == 1);
+
+            clReleaseMemObject(subBuffer);
+            CHECK(device->usedGlobalMemory == usedMemory - alignment * 2);
+        }
+
+        SUBCASE("should track overlapping sub-buffers") {
+            const auto buffer = test::createBuffer(0, alignment * 4);
+            const cl_buffer_region firstRegion{0, alignment * 2};
+            const cl_buffer_region secondRegion{alignment, alignment * 2};
+            const cl_buffer_region thirdRegion{alignment * 3, alignment};
+
+            const auto first = clCreateSubBuffer(
+                buffer, 0, CL_BUFFER_CREATE_TYPE_REGION, &firstRegion, nullptr);
+            const auto second =
+                clCreateSubBuffer(buffer, 0, CL_BUFFER_CREATE_TYPE_REGION,
+                                  &secondRegion, nullptr);
+            const auto third = clCreateSubBuffer(
+                buffer, 0, CL_BUFFER_CREATE_TYPE_REGION, &thirdRegion, nullptr);
+
+            CHECK(first->overlaps(second));
+            CHECK(first->overlaps(buffer));
+            CHECK_FALSE(first->overlaps(third));
+            CHECK_FALSE(second->overlaps(third));
+
+            CHECK(buffer->getSubBuffersOverlapping(alignment * 3, 1) ==
+                  std::vector<cl_mem>{third});
+            CHECK(buffer->getSubBuffersOverlapping(alignment, alignment) ==
+                  std::vector<cl_mem>{first, second});
+
+            clReleaseMemObject(second);
+            CHECK(buffer->getSubBuffersOverlapping(0, alignment * 4) ==
+                  std::vector<cl_mem>{first, third});
+        }
+
+        SUBCASE("should inherit access flags") {
+            const auto buffer =
+                test::createBuffer(CL_MEM_READ_ONLY | CL_MEM_HOST_READ_ONLY,
+                                   alignment * 2);
+            const cl_buffer_region region{0, alignment};
+
+            const auto subBuffer = clCreateSubBuffer(
+                buffer, 0, CL_BUFFER_CREATE_TYPE_REGION, &region, nullptr);
+            CHECK(subBuffer->kernelCanRead);
+            CHECK_FALSE(subBuffer->kernelCanWrite);
+            CHECK(subBuffer->hostCanRead);
+            CHECK_FALSE(subBuffer->hostCanWrite);
+
+            cl_int error;
+            clCreateSubBuffer(buffer, CL_MEM_WRITE_ONLY,
+                              CL_BUFFER_CREATE_TYPE_REGION, &region, &error);
+            CHECK(error == CL_INVALID_VALUE);
+            clCreateSubBuffer(buffer, CL_MEM_HOST_WRITE_ONLY,
+                              CL_BUFFER_CREATE_TYPE_REGION, &region, &error);
+            CHECK(error == CL_INVALID_VALUE);
+        }
+
+        SUBCASE("should fail with misaligned origin") {
+            const auto buffer = test::createBuffer(0, alignment * 2);
+            const cl_buffer_region region{1, alignment};
+
+            cl_int error;
+            clCreateSubBuffer(buffer, 0, CL_BUFFER_CREATE_TYPE_REGION, &region,
+                              &error);
+            CHECK(error == CL_MISALIGNED_SUB_BUFFER_OFFSET);
+        }
+
+        SUBCASE("should fail if region is out of bounds") {
+            const auto buffer = test::createBuffer(0, alignment);
+            const cl_buffer_region region{0, alignment + 1};
+
+            cl_int error;
+            clCreateSubBuffer(buffer, 0, CL_BUFFER_CREATE_TYPE_REGION, &region,
+                              &error);
+            CHECK(error == CL_INVALID_VALUE);
+        }
+
+        SUBCASE("should fail for sub-buffer of sub-buffer") {
+            const auto buffer = test::createBuffer(0, alignment * 2);
+            const cl_buffer_region region{0, alignment};
+            const auto subBuffer = clCreateSubBuffer(
+                buffer, 0, CL_BUFFER_CREATE_TYPE_REGION, &region, nullptr);
+
+            cl_int error;
+            clCreateSubBuffer(subBuffer, 0, CL_BUFFER_CREATE_TYPE_REGION,
+                              &region, &error);
+            CHECK(error == CL_INVALID_MEM_OBJECT);
+        }
     }
 
     TEST_CASE("clEnqueueReadBuffer") {
@@ -497,5 +655,492 @@ TEST_SUITE("Memory buffer API") {
                 CHECK(error == CL_SUCCESS);
             }
         }
+
+        SUBCASE("non-blocking transfer should complete its event") {
+            const auto queue = test::getCommandQueue();
+            const auto buffer = test::createBuffer(0, sizeof(cl_uint));
+            const cl_uint value = 42;
+
+            cl_event event;
+            CHECK(clEnqueueWriteBuffer(queue, buffer, false, 0,
+                                       sizeof(cl_uint), &value, 0, nullptr,
+                                       &event) == CL_SUCCESS);
+            CHECK(clWaitForEvents(1, &event) == CL_SUCCESS);
+
+            cl_uint out = 0;
+            CHECK(clEnqueueReadBuffer(queue, buffer, true, 0, sizeof(cl_uint),
+                                      &out, 0, nullptr,
+                                      nullptr) == CL_SUCCESS);
+            CHECK(out == value);
+            clReleaseEvent(event);
+        }
+
+        SUBCASE("blocking read should only wait for its dependencies") {
+            const auto context = test::getContext();
+            const auto queue = clCreateCommandQueue(
+                context, context->device,
+                CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE, nullptr);
+            cl_int error;
+            const auto buffer =
+                clCreateBuffer(context, 0, sizeof(cl_uint), nullptr, &error);
+            const auto unrelated = clCreateUserEvent(context, nullptr);
+
+            clEnqueueMarkerWithWaitList(queue, 1, &unrelated, nullptr);
+
+            cl_uint out = 1;
+            CHECK(clEnqueueReadBuffer(queue, buffer, true, 0, sizeof(cl_uint),
+                                      &out, 0, nullptr,
+                                      nullptr) == CL_SUCCESS);
+            CHECK(out == 0);
+            CHECK(queue->size() == 1);
+
+            clSetUserEventStatus(unrelated, CL_COMPLETE);
+            clFinish(queue);
+        }
+
+        SUBCASE("blocking read should fail if its dependency failed") {
+            const auto queue = test::getCommandQueue();
+            const auto buffer = test::createBuffer(0, sizeof(cl_uint));
+            const auto dependency =
+                clCreateUserEvent(queue->context, nullptr);
+            clSetUserEventStatus(dependency, -1);
+
+            cl_uint out;
+            CHECK(clEnqueueReadBuffer(queue, buffer, true, 0, sizeof(cl_uint),
+                                      &out, 1, &dependency, nullptr) ==
+                  CL_EXEC_STATUS_ERROR_FOR_EVENTS_IN_WAIT_LIST);
+        }
+
+        SUBCASE("large transfers should keep data intact") {
+            const auto queue = test::getCommandQueue();
+            const size_t size = 9 * 1024 * 1024 + 3;
+            const auto buffer = test::createBuffer(0, size);
+
+            std::vector<unsigned char> data(size);
+            for (size_t i = 0; i < size; ++i) {
+                data[i] = static_cast<unsigned char>(i * 7);
+            }
+            std::vector<unsigned char> out(size);
+
+            CHECK(clEnqueueWriteBuffer(queue, buffer, false, 0, size,
+                                       data.data(), 0, nullptr,
+                                       nullptr) == CL_SUCCESS);
+            CHECK(clEnqueueReadBuffer(queue, buffer, true, 0, size,
+                                      out.data(), 0, nullptr,
+                                      nullptr) == CL_SUCCESS);
+            CHECK(out == data);
+        }
+    }
+
+    TEST_CASE("clEnqueue{Read/Write/Copy}BufferRect") {
+        // 3 slices of 5 rows of 16 bytes
+        const size_t rowPitch = 16;
+        const size_t slicePitch = rowPitch * 5;
+        const size_t bufferSize = slicePitch * 3;
+
+        std::vector<unsigned char> data(bufferSize);
+        for (size_t i = 0; i < bufferSize; ++i) {
+            data[i] = static_cast<unsigned char>(i);
+        }
+        const auto at = [&](size_t x, size_t y, size_t z) {
+            return data[z * slicePitch + y * rowPitch + x];
+        };
+
+        SUBCASE("should read region into packed host memory") {
+            const auto queue = test::getCommandQueue();
+            const auto buffer =
+                test::createBuffer(CL_MEM_COPY_HOST_PTR, bufferSize,
+                                   data.data());
+            const size_t bufferOrigin[3] = {2, 1, 1};
+            const size_t hostOrigin[3] = {0, 0, 0};
+            const size_t region[3] = {4, 3, 2};
+
+            std::vector<unsigned char> out(4 * 3 * 2);
+            CHECK(clEnqueueReadBufferRect(queue, buffer, true, bufferOrigin,
+                                          hostOrigin, region, rowPitch,
+                                          slicePitch, 0, 0, out.data(), 0,
+                                          nullptr, nullptr) == CL_SUCCESS);
+
+            bool matches = true;
+            for (size_t z = 0; z < 2; ++z) {
+                for (size_t y = 0; y < 3; ++y) {
+                    for (size_t x = 0; x < 4; ++x) {
+                        matches = matches && out[z * 12 + y * 4 + x] ==
+                                                 at(x + 2, y + 1, z + 1);
+                    }
+                }
+            }
+            CHECK(matches);
+        }
+
+        SUBCASE("should write region from padded host memory") {
+            const auto queue = test::getCommandQueue();
+            const auto buffer = test::createBuffer(0, bufferSize);
+            const size_t bufferOrigin[3] = {0, 2, 0};
+            const size_t hostOrigin[3] = {1, 1, 0};
+            const size_t region[3] = {rowPitch - 1, 2, 3};
+
+            CHECK(clEnqueueWriteBufferRect(
+                      queue, buffer, false, bufferOrigin, hostOrigin, region,
+                      rowPitch, slicePitch, rowPitch, slicePitch, data.data(),
+                      0, nullptr, nullptr) == CL_SUCCESS);
+
+            std::vector<unsigned char> out(bufferSize);
+            clEnqueueReadBuffer(queue, buffer, true, 0, bufferSize,
+                                out.data(), 0, nullptr, nullptr);
+            CHECK(out[slicePitch + 2 * rowPitch] == at(1, 1, 1));
+            CHECK(out[2 * slicePitch + 3 * rowPitch + 14] == at(15, 2, 2));
+            CHECK(out[2 * slicePitch + 3 * rowPitch + 15] == 0);
+            CHECK(out[rowPitch] == 0);
+        }
+
+        SUBCASE("should copy side by side tiles of one buffer") {
+            const auto queue = test::getCommandQueue();
+            const auto buffer =
+                test::createBuffer(CL_MEM_COPY_HOST_PTR, bufferSize,
+                                   data.data());
+            const size_t sourceOrigin[3] = {0, 0, 0};
+            const size_t destinationOrigin[3] = {8, 0, 0};
+            const size_t region[3] = {8, 5, 3};
+
+            CHECK(clEnqueueCopyBufferRect(
+                      queue, buffer, buffer, sourceOrigin, destinationOrigin,
+                      region, rowPitch, slicePitch, rowPitch, slicePitch, 0,
+                      nullptr, nullptr) == CL_SUCCESS);
+
+            std::vector<unsigned char> out(bufferSize);
+            clEnqueueReadBuffer(queue, buffer, true, 0, bufferSize,
+                                out.data(), 0, nullptr, nullptr);
+            CHECK(out[slicePitch * 2 + rowPitch * 4 + 9] == at(1, 4, 2));
+            CHECK(out[slicePitch * 2 + rowPitch * 4 + 1] == at(1, 4, 2));
+        }
+
+        SUBCASE("should fail if regions overlap") {
+            const auto queue = test::getCommandQueue();
+            const auto buffer = test::createBuffer(0, bufferSize);
+            const size_t sourceOrigin[3] = {0, 0, 0};
+            const size_t destinationOrigin[3] = {4, 1, 0};
+            const size_t region[3] = {8, 2, 1};
+
+            CHECK(clEnqueueCopyBufferRect(
+                      queue, buffer, buffer, sourceOrigin, destinationOrigin,
+                      region, rowPitch, slicePitch, rowPitch, slicePitch, 0,
+                      nullptr, nullptr) == CL_MEM_COPY_OVERLAP);
+        }
+
+        SUBCASE("should validate pitches and bounds") {
+            const auto queue = test::getCommandQueue();
+            const auto buffer = test::createBuffer(0, bufferSize);
+            const size_t origin[3] = {0, 0, 0};
+            const size_t region[3] = {8, 5, 3};
+            std::vector<unsigned char> out(bufferSize);
+
+            CHECK(clEnqueueReadBufferRect(queue, buffer, true, origin, origin,
+                                          region, 4, 0, 0, 0, out.data(), 0,
+                                          nullptr,
+                                          nullptr) == CL_INVALID_VALUE);
+            CHECK(clEnqueueReadBufferRect(queue, buffer, true, origin, origin,
+                                          region, rowPitch, slicePitch + 1, 0,
+                                          0, out.data(), 0, nullptr,
+                                          nullptr) == CL_INVALID_VALUE);
+
+            const size_t shifted[3] = {9, 0, 0};
+            CHECK(clEnqueueReadBufferRect(queue, buffer, true, shifted, origin,
+                                          region, rowPitch, slicePitch, 0, 0,
+                                          out.data(), 0, nullptr,
+                                          nullptr) == CL_INVALID_VALUE);
+        }
+
+        SUBCASE("large region should keep data intact") {
+            const auto queue = test::getCommandQueue();
+            const size_t width = 3000;
+            const size_t height = 2000;
+            const size_t pitch = 3072;
+            std::vector<unsigned char> image(pitch * height);
+            for (size_t i = 0; i < image.size(); ++i) {
+                image[i] = static_cast<unsigned char>(i * 7);
+            }
+            const auto buffer = test::createBuffer(
+                CL_MEM_COPY_HOST_PTR, image.size(), image.data());
+            const size_t origin[3] = {0, 0, 0};
+            const size_t region[3] = {width, height, 1};
+
+            std::vector<unsigned char> out(width * height);
+            clEnqueueReadBufferRect(queue, buffer, true, origin, origin,
+                                    region, pitch, 0, 0, 0, out.data(), 0,
+                                    nullptr, nullptr);
+
+            bool matches = true;
+            for (size_t y = 0; y < height; ++y) {
+                matches = matches && std::equal(out.begin() + y * width,
+                                                out.begin() + (y + 1) * width,
+                                                image.begin() + y * pitch);
+            }
+            CHECK(matches);
+        }
+    }
+
+    TEST_CASE("clEnqueueFillBuffer") {
+        SUBCASE("should repeat pattern of every supported size") {
+            const auto queue = test::getCommandQueue();
+            const size_t size = 1024;
+            const auto buffer = test::createBuffer(0, size);
+
+            std::vector<unsigned char> pattern(128);
+            for (size_t i = 0; i < pattern.size(); ++i) {
+                pattern[i] = static_cast<unsigned char>(i + 1);
+            }
+
+            for (size_t patternSize = 1; patternSize <= 128; patternSize *= 2) {
+                const size_t offset = patternSize * 3;
+                const size_t fillSize = size - offset - patternSize;
+                CHECK(clEnqueueFillBuffer(queue, buffer, pattern.data(),
+                                          patternSize, offset, fillSize, 0,
+                                          nullptr, nullptr) == CL_SUCCESS);
+
+                std::vector<unsigned char> out(size);
+                clEnqueueReadBuffer(queue, buffer, true, 0, size, out.data(),
+                                    0, nullptr, nullptr);
+                for (size_t i = offset; i < offset + fillSize; ++i) {
+                    if (out[i] != pattern[(i - offset) % patternSize]) {
+                        FAIL("pattern of size " << patternSize
+                                                << " is broken at " << i);
+                    }
+                }
+            }
+        }
+
+        SUBCASE("large fill should keep pattern intact") {
+            const auto queue = test::getCommandQueue();
+            const size_t size = 9 * 1024 * 1024 + 48;
+            const auto buffer = test::createBuffer(0, size + 16);
+            const cl_uint pattern[4] = {1, 2, 3, 4};
+
+            clEnqueueFillBuffer(queue, buffer, pattern, sizeof(pattern), 16,
+                                size, 0, nullptr, nullptr);
+
+            std::vector<cl_uint> out((size + 16) / sizeof(cl_uint));
+            clEnqueueReadBuffer(queue, buffer, true, 0, size + 16, out.data(),
+                                0, nullptr, nullptr);
+            CHECK(out[0] == 0);
+            bool intact = true;
+            for (size_t i = 4; i < out.size(); ++i) {
+                intact = intact && out[i] == pattern[i % 4];
+            }
+            CHECK(intact);
+        }
+
+        SUBCASE("should fail with invalid pattern") {
+            const auto queue = test::getCommandQueue();
+            const auto buffer = test::createBuffer(0, 64);
+            const unsigned char pattern[3] = {};
+
+            CHECK(clEnqueueFillBuffer(queue, buffer, pattern, 3, 0, 63, 0,
+                                      nullptr, nullptr) == CL_INVALID_VALUE);
+            CHECK(clEnqueueFillBuffer(queue, buffer, pattern, 2, 1, 2, 0,
+                                      nullptr, nullptr) == CL_INVALID_VALUE);
+            CHECK(clEnqueueFillBuffer(queue, buffer, pattern, 2, 0, 66, 0,
+                                      nullptr, nullptr) == CL_INVALID_VALUE);
+        }
+    }
+
+    TEST_CASE("clEnqueueCopyBuffer") {
+        SUBCASE("should copy between buffers") {
+            const auto queue = test::getCommandQueue();
+            const size_t size = 5 * 1024 * 1024;
+            std::vector<unsigned char> data(size);
+            for (size_t i = 0; i < size; ++i) {
+                data[i] = static_cast<unsigned char>(i * 13);
+            }
+            const auto source =
+                test::createBuffer(CL_MEM_COPY_HOST_PTR, size, data.data());
+            const auto destination = test::createBuffer(0, size + 8);
+
+            CHECK(clEnqueueCopyBuffer(queue, source, destination, 0, 8, size,
+                                      0, nullptr, nullptr) == CL_SUCCESS);
+
+            std::vector<unsigned char> out(size);
+            clEnqueueReadBuffer(queue, destination, true, 8, size, out.data(),
+                                0, nullptr, nullptr);
+            CHECK(out == data);
+        }
+
+        SUBCASE("should copy between sub-buffers of one buffer") {
+            const auto queue = test::getCommandQueue();
+            const auto alignment =
+                test::getDevice()->memoryBaseAddressAlignment;
+            const auto buffer = test::createBuffer(0, alignment * 2);
+            const cl_buffer_region firstRegion{0, alignment};
+            const cl_buffer_region secondRegion{alignment, alignment};
+            const auto first = clCreateSubBuffer(
+                buffer, 0, CL_BUFFER_CREATE_TYPE_REGION, &firstRegion, nullptr);
+            const auto second =
+                clCreateSubBuffer(buffer, 0, CL_BUFFER_CREATE_TYPE_REGION,
+                                  &secondRegion, nullptr);
+            const cl_uint value = 42;
+            clEnqueueWriteBuffer(queue, first, false, 0, sizeof(cl_uint),
+                                 &value, 0, nullptr, nullptr);
+
+            CHECK(clEnqueueCopyBuffer(queue, first, second, 0, 4,
+                                      sizeof(cl_uint), 0, nullptr,
+                                      nullptr) == CL_SUCCESS);
+
+            cl_uint out = 0;
+            clEnqueueReadBuffer(queue, buffer, true, alignment + 4,
+                                sizeof(cl_uint), &out, 0, nullptr, nullptr);
+            CHECK(out == value);
+        }
+
+        SUBCASE("should fail if regions overlap") {
+            const auto queue = test::getCommandQueue();
+            const auto alignment =
+                test::getDevice()->memoryBaseAddressAlignment;
+            const auto buffer = test::createBuffer(0, alignment * 2);
+            const cl_buffer_region region{alignment, alignment};
+            const auto subBuffer = clCreateSubBuffer(
+                buffer, 0, CL_BUFFER_CREATE_TYPE_REGION, &region, nullptr);
+
+            CHECK(clEnqueueCopyBuffer(queue, buffer, buffer, 0, 4, 8, 0,
+                                      nullptr,
+                                      nullptr) == CL_MEM_COPY_OVERLAP);
+            CHECK(clEnqueueCopyBuffer(queue, buffer, subBuffer, alignment, 0,
+                                      4, 0, nullptr,
+                                      nullptr) == CL_MEM_COPY_OVERLAP);
+            CHECK(clEnqueueCopyBuffer(queue, buffer, buffer, 0, 8, 8, 0,
+                                      nullptr, nullptr) == CL_SUCCESS);
+            clFinish(queue);
+        }
+    }
+
+    TEST_CASE("clEnqueueMapBuffer") {
+        SUBCASE("should map straight into the buffer") {
+            const auto queue = test::getCommandQueue();
+            const auto buffer = test::createBuffer(0, 16);
+
+            cl_int error;
+            const auto mapped = static_cast<std::byte*>(
+                clEnqueueMapBuffer(queue, buffer, true, CL_MAP_WRITE, 4, 8, 0,
+                                   nullptr, nullptr, &error));
+            REQUIRE(error == CL_SUCCESS);
+            CHECK(mapped == buffer->address + 4);
+
+            *mapped = std::byte{42};
+            CHECK(clEnqueueUnmapMemObject(queue, buffer, mapped, 0, nullptr,
+                                          nullptr) == CL_SUCCESS);
+
+            unsigned char out = 0;
+            clEnqueueReadBuffer(queue, buffer, true, 4, 1, &out, 0, nullptr,
+                                nullptr);
+            CHECK(out == 42);
+        }
+
+        SUBCASE("should track map count") {
+            const auto queue = test::getCommandQueue();
+            const auto buffer = test::createBuffer(0, 16);
+
+            const auto first =
+                clEnqueueMapBuffer(queue, buffer, true, CL_MAP_READ, 0, 16, 0,
+                                   nullptr, nullptr, nullptr);
+            const auto second =
+                clEnqueueMapBuffer(queue, buffer, true, CL_MAP_READ, 0, 16, 0,
+                                   nullptr, nullptr, nullptr);
+
+            cl_uint mapCount;
+            clGetMemObjectInfo(buffer, CL_MEM_MAP_COUNT, sizeof(cl_uint),
+                               &mapCount, nullptr);
+            CHECK(mapCount == 2);
+
+            clEnqueueUnmapMemObject(queue, buffer, first, 0, nullptr, nullptr);
+            clEnqueueUnmapMemObject(queue, buffer, second, 0, nullptr,
+                                    nullptr);
+            clGetMemObjectInfo(buffer, CL_MEM_MAP_COUNT, sizeof(cl_uint),
+                               &mapCount, nullptr);
+            CHECK(mapCount == 0);
+        }
+
+        SUBCASE("should complete event when queue is idle") {
+            const auto queue = test::getCommandQueue();
+            const auto buffer = test::createBuffer(0, 16);
+
+            cl_event event;
+            const auto mapped =
+                clEnqueueMapBuffer(queue, buffer, false, CL_MAP_READ, 0, 16, 0,
+                                   nullptr, &event, nullptr);
+            CHECK(event->getStatus() == CL_COMPLETE);
+
+            cl_command_type type;
+            clGetEventInfo(event, CL_EVENT_COMMAND_TYPE,
+                           sizeof(cl_command_type), &type, nullptr);
+            CHECK(type == CL_COMMAND_MAP_BUFFER);
+
+            clEnqueueUnmapMemObject(queue, buffer, mapped, 0, nullptr, nullptr);
+            clReleaseEvent(event);
+        }
+
+        SUBCASE("blocking map should wait for its dependencies") {
+            const auto queue = test::getCommandQueue();
+            const auto buffer = test::createBuffer(0, sizeof(cl_uint));
+            const cl_uint value = 42;
+
+            clEnqueueWriteBuffer(queue, buffer, false, 0, sizeof(cl_uint),
+                                 &value, 0, nullptr, nullptr);
+            const auto mapped = static_cast<cl_uint*>(clEnqueueMapBuffer(
+                queue, buffer, true, CL_MAP_READ, 0, sizeof(cl_uint), 0,
+                nullptr, nullptr, nullptr));
+            CHECK(*mapped == value);
+
+            clEnqueueUnmapMemObject(queue, buffer, mapped, 0, nullptr, nullptr);
+        }
+
+        SUBCASE("should fail with invalid flags") {
+            const auto queue = test::getCommandQueue();
+            const auto buffer = test::createBuffer(0, 16);
+
+            cl_int error;
+            clEnqueueMapBuffer(queue, buffer, true,
+                               CL_MAP_READ | CL_MAP_WRITE_INVALIDATE_REGION, 0,
+                               16, 0, nullptr, nullptr, &error);
+            CHECK(error == CL_INVALID_VALUE);
+
+            const auto readOnly = test::createBuffer(CL_MEM_HOST_READ_ONLY, 16);
+            clEnqueueMapBuffer(queue, readOnly, true, CL_MAP_WRITE, 0, 16, 0,
+                               nullptr, nullptr, &error);
+            CHECK(error == CL_INVALID_OPERATION);
+        }
+
+        SUBCASE("should fail if region is out of bounds") {
+            const auto queue = test::getCommandQueue();
+            const auto buffer = test::createBuffer(0, 16);
+
+            cl_int error;
+            clEnqueueMapBuffer(queue, buffer, true, CL_MAP_READ, 8, 16, 0,
+                               nullptr, nullptr, &error);
+            CHECK(error == CL_INVALID_VALUE);
+        }
+    }
+
+    TEST_CASE("clEnqueueUnmapMemObject") {
+        SUBCASE("should fail if pointer is not mapped") {
+            const auto queue = test::getCommandQueue();
+            const auto buffer = test::createBuffer(0, 16);
+
+            CHECK(clEnqueueUnmapMemObject(queue, buffer, buffer->address, 0,
+                                          nullptr,
+                                          nullptr) == CL_INVALID_VALUE);
+        }
+
+        SUBCASE("should release the buffer") {
+            const auto queue = test::getCommandQueue();
+            const auto buffer = test::createBuffer(0, 16);
+
+            const auto mapped =
+                clEnqueueMapBuffer(queue, buffer, true, CL_MAP_READ, 0, 16, 0,
+                                   nullptr, nullptr, nullptr);
+            CHECK(buffer->referenceCount == 2);
+
+            clEnqueueUnmapMemObject(queue, buffer, mapped, 0, nullptr, nullptr);
+            clFinish(queue);
+            CHECK(buffer->referenceCount == 1);
+        }
     }
 }
@@ -0,0 +1,421 @@
+#include <common/test/doctest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "runtime/icd/icd.h"
+#include "unit-test-common/test-commons.h"
+
+namespace {
+const cl_image_format kRGBA8{CL_RGBA, CL_UNORM_INT8};
+const cl_image_format kR32F{CL_R, CL_FLOAT};
+
+cl_image_desc imageDesc(cl_mem_object_type type,
+                        size_t width,
+                        size_t height = 0,
+                        size_t depth = 0,
+                        size_t arraySize = 0) {
+    cl_image_desc desc{};
+    desc.image_type = type;
+    desc.image_width = width;
+    desc.image_height = height;
+    desc.image_depth = depth;
+    desc.image_array_size = arraySize;
+    return desc;
+}
+
+cl_mem createImage(const cl_image_format& format,
+                   const cl_image_desc& desc,
+                   cl_mem_flags flags = 0,
+                   void* hostPtr = nullptr) {
+    cl_int error;
+    const auto image = clCreateImage(test::getContext(), flags, &format,
+                                     &desc, hostPtr, &error);
+    REQUIRE(error == CL_SUCCESS);
+    return image;
+}
+
+std::vector<uint32_t> sequence(size_t size) {
+    std::vector<uint32_t> values(size);
+    for (size_t i = 0; i < size; ++i) {
+        values[i] = static_cast<uint32_t>(i * 2654435761u);
+    }
+    return values;
+}
+}  // namespace
+
+TEST_SUITE("Memory image API") {
+    TEST_CASE("clCreateImage") {
+        SUBCASE("should create 2D image") {
+            const auto desc = imageDesc(CL_MEM_OBJECT_IMAGE2D, 20, 13);
+            const auto image = createImage(kRGBA8, desc);
+
+            cl_mem_object_type type;
+            clGetMemObjectInfo(image, CL_MEM_TYPE, sizeof(type), &type,
+                               nullptr);
+            CHECK(type == CL_MEM_OBJECT_IMAGE2D);
+            clReleaseMemObject(image);
+        }
+
+        SUBCASE("should copy host data with pitches") {
+            const size_t width = 10;
+            const size_t height = 9;
+            const size_t rowPitch = 12 * sizeof(uint32_t);
+            const auto data = sequence(12 * height);
+
+            auto desc = imageDesc(CL_MEM_OBJECT_IMAGE2D, width, height);
+            desc.image_row_pitch = rowPitch;
+            const auto image =
+                createImage(kRGBA8, desc, CL_MEM_COPY_HOST_PTR,
+                            const_cast<uint32_t*>(data.data()));
+
+            std::vector<uint32_t> out(width * height);
+            const size_t origin[3] = {0, 0, 0};
+            const size_t region[3] = {width, height, 1};
+            CHECK(clEnqueueReadImage(test::getCommandQueue(), image, true,
+                                     origin, region, 0, 0, out.data(), 0,
+                                     nullptr, nullptr) == CL_SUCCESS);
+
+            bool matches = true;
+            for (size_t y = 0; y < height; ++y) {
+                for (size_t x = 0; x < width; ++x) {
+                    matches =
+                        matches && out[y * width + x] == data[y * 12 + x];
+                }
+            }
+            CHECK(matches);
+            clReleaseMemObject(image);
+        }
+
+        SUBCASE("fail if format is not supported") {
+            const cl_image_format format{CL_BGRA, CL_FLOAT};
+            const auto desc = imageDesc(CL_MEM_OBJECT_IMAGE2D, 4, 4);
+
+            cl_int error;
+            clCreateImage(test::getContext(), 0, &format, &desc, nullptr,
+                          &error);
+            CHECK(error == CL_IMAGE_FORMAT_NOT_SUPPORTED);
+        }
+
+        SUBCASE("fail if size is 0 or too large") {
+            const auto empty = imageDesc(CL_MEM_OBJECT_IMAGE2D, 0, 4);
+            const auto large = imageDesc(CL_MEM_OBJECT_IMAGE3D, 4, 4, 1 << 20);
+
+            cl_int error;
+            clCreateImage(test::getContext(), 0, &kRGBA8, &empty, nullptr,
+                          &error);
+            CHECK(error == CL_INVALID_IMAGE_SIZE);
+            clCreateImage(test::getContext(), 0, &kRGBA8, &large, nullptr,
+                          &error);
+            CHECK(error == CL_INVALID_IMAGE_SIZE);
+        }
+
+        SUBCASE("fail if host memory is used") {
+            const auto desc = imageDesc(CL_MEM_OBJECT_IMAGE2D, 4, 4);
+            uint32_t data[16];
+
+            cl_int error;
+            clCreateImage(test::getContext(), CL_MEM_USE_HOST_PTR, &kRGBA8,
+                          &desc, data, &error);
+            CHECK(error == CL_INVALID_VALUE);
+        }
+    }
+
+    TEST_CASE("clEnqueueReadImage and clEnqueueWriteImage") {
+        SUBCASE("2D region should survive round trip") {
+            const size_t width = 37;
+            const size_t height = 21;
+            const auto image = createImage(
+                kRGBA8, imageDesc(CL_MEM_OBJECT_IMAGE2D, width, height));
+            const auto queue = test::getCommandQueue();
+
+            const auto data = sequence(width * height);
+            const size_t origin[3] = {0, 0, 0};
+            const size_t region[3] = {width, height, 1};
+            CHECK(clEnqueueWriteImage(queue, image, false, origin, region, 0,
+                                      0, data.data(), 0, nullptr,
+                                      nullptr) == CL_SUCCESS);
+
+            // region crossing tile boundaries
+            const size_t partOrigin[3] = {5, 3, 0};
+            const size_t partRegion[3] = {19, 11, 1};
+            std::vector<uint32_t> out(19 * 11);
+            CHECK(clEnqueueReadImage(queue, image, true, partOrigin,
+                                     partRegion, 0, 0, out.data(), 0,
+                                     nullptr, nullptr) == CL_SUCCESS);
+
+            bool matches = true;
+            for (size_t y = 0; y < 11; ++y) {
+                for (size_t x = 0; x < 19; ++x) {
+                    matches = matches && out[y * 19 + x] ==
+                                             data[(y + 3) * width + x + 5];
+                }
+            }
+            CHECK(matches);
+            clReleaseMemObject(image);
+        }
+
+        SUBCASE("3D region should survive round trip") {
+            const size_t width = 9;
+            const size_t height = 10;
+            const size_t depth = 3;
+            const auto image = createImage(
+                kR32F, imageDesc(CL_MEM_OBJECT_IMAGE3D, width, height, depth));
+            const auto queue = test::getCommandQueue();
+
+            const auto data = sequence(width * height * depth);
+            const size_t origin[3] = {0, 0, 0};
+            const size_t region[3] = {width, height, depth};
+            clEnqueueWriteImage(queue, image, false, origin, region, 0, 0,
+                                data.data(), 0, nullptr, nullptr);
+
+            std::vector<uint32_t> out(data.size());
+            clEnqueueReadImage(queue, image, true, origin, region, 0, 0,
+                               out.data(), 0, nullptr, nullptr);
+            CHECK(out == data);
+            clReleaseMemObject(image);
+        }
+
+        SUBCASE("1D array layers should be slice pitch apart") {
+            const size_t width = 70;
+            const size_t layers = 3;
+            const size_t slicePitch = 80 * sizeof(uint32_t);
+            const auto image = createImage(
+                kRGBA8,
+                imageDesc(CL_MEM_OBJECT_IMAGE1D_ARRAY, width, 0, 0, layers));
+            const auto queue = test::getCommandQueue();
+
+            const auto data = sequence(80 * layers);
+            const size_t origin[3] = {0, 0, 0};
+            const size_t region[3] = {width, layers, 1};
+            CHECK(clEnqueueWriteImage(queue, image, false, origin, region, 0,
+                                      slicePitch, data.data(), 0, nullptr,
+                                      nullptr) == CL_SUCCESS);
+
+            std::vector<uint32_t> out(width * layers);
+            clEnqueueReadImage(queue, image, true, origin, region, 0, 0,
+                               out.data(), 0, nullptr, nullptr);
+            CHECK(out[0] == data[0]);
+            CHECK(out[width + 69] == data[80 + 69]);
+            CHECK(out[2 * width + 1] == data[160 + 1]);
+            clReleaseMemObject(image);
+        }
+
+        SUBCASE("fail if region is out of bounds") {
+            const auto image =
+                createImage(kRGBA8, imageDesc(CL_MEM_OBJECT_IMAGE2D, 8, 8));
+            uint32_t out[64];
+
+            const size_t origin[3] = {4, 0, 0};
+            const size_t region[3] = {8, 1, 1};
+            CHECK(clEnqueueReadImage(test::getCommandQueue(), image, true,
+                                     origin, region, 0, 0, out, 0, nullptr,
+                                     nullptr) == CL_INVALID_VALUE);
+
+            const size_t slices[3] = {1, 1, 2};
+            CHECK(clEnqueueReadImage(test::getCommandQueue(), image, true,
+                                     origin, slices, 0, 0, out, 0, nullptr,
+                                     nullptr) == CL_INVALID_VALUE);
+            clReleaseMemObject(image);
+        }
+    }
+
+    TEST_CASE("clEnqueueFillImage") {
+        SUBCASE("should fill region with converted color") {
+            const auto image =
+                createImage(kRGBA8, imageDesc(CL_MEM_OBJECT_IMAGE2D, 16, 16));
+            const auto queue = test::getCommandQueue();
+
+            const float color[4] = {1.0f, 0.0f, 0.5f, 2.0f};
+            const size_t origin[3] = {3, 2, 0};
+            const size_t region[3] = {10, 12, 1};
+            CHECK(clEnqueueFillImage(queue, image, color, origin, region, 0,
+                                     nullptr, nullptr) == CL_SUCCESS);
+
+            std::vector<uint8_t> out(16 * 16 * 4);
+            const size_t all[3] = {16, 16, 1};
+            const size_t zero[3] = {0, 0, 0};
+            clEnqueueReadImage(queue, image, true, zero, all, 0, 0,
+                               out.data(), 0, nullptr, nullptr);
+
+            const auto texel = &out[(2 * 16 + 3) * 4];
+            CHECK(texel[0] == 255);
+            CHECK(texel[1] == 0);
+            CHECK(texel[2] == 128);
+            CHECK(texel[3] == 255);
+            CHECK(out[(13 * 16 + 12) * 4] == 255);
+            CHECK(out[(13 * 16 + 13) * 4] == 0);
+            CHECK(out[(14 * 16 + 12) * 4] == 0);
+            clReleaseMemObject(image);
+        }
+    }
+
+    TEST_CASE("clEnqueueCopyImage") {
+        SUBCASE("should copy between 2D and 3D images") {
+            const auto source =
+                createImage(kR32F, imageDesc(CL_MEM_OBJECT_IMAGE2D, 12, 12));
+            const auto destination = createImage(
+                kR32F, imageDesc(CL_MEM_OBJECT_IMAGE3D, 12, 12, 2));
+            const auto queue = test::getCommandQueue();
+
+            const auto data = sequence(12 * 12);
+            const size_t zero[3] = {0, 0, 0};
+            const size_t all[3] = {12, 12, 1};
+            clEnqueueWriteImage(queue, source, false, zero, all, 0, 0,
+                                data.data(), 0, nullptr, nullptr);
+
+            const size_t sourceOrigin[3] = {2, 1, 0};
+            const size_t destinationOrigin[3] = {7, 9, 1};
+            const size_t region[3] = {5, 3, 1};
+            CHECK(clEnqueueCopyImage(queue, source, destination, sourceOrigin,
+                                     destinationOrigin, region, 0, nullptr,
+                                     nullptr) == CL_SUCCESS);
+
+            std::vector<uint32_t> out(5 * 3);
+            clEnqueueReadImage(queue, destination, true, destinationOrigin,
+                               region, 0, 0, out.data(), 0, nullptr, nullptr);
+            CHECK(out[0] == data[1 * 12 + 2]);
+            CHECK(out[14] == data[3 * 12 + 6]);
+            clReleaseMemObject(source);
+            clReleaseMemObject(destination);
+        }
+
+        SUBCASE("fail if formats differ or regions overlap") {
+            const auto first =
+                createImage(kR32F, imageDesc(CL_MEM_OBJECT_IMAGE2D, 8, 8));
+            const auto second =
+                createImage(kRGBA8, imageDesc(CL_MEM_OBJECT_IMAGE2D, 8, 8));
+            const auto queue = test::getCommandQueue();
+
+            const size_t zero[3] = {0, 0, 0};
+            const size_t shifted[3] = {2, 2, 0};
+            const size_t region[3] = {4, 4, 1};
+            CHECK(clEnqueueCopyImage(queue, first, second, zero, zero, region,
+                                     0, nullptr,
+                                     nullptr) == CL_IMAGE_FORMAT_MISMATCH);
+            CHECK(clEnqueueCopyImage(queue, first, first, zero, shifted,
+                                     region, 0, nullptr,
+                                     nullptr) == CL_MEM_COPY_OVERLAP);
+            clReleaseMemObject(first);
+            clReleaseMemObject(second);
+        }
+    }
+
+    TEST_CASE("clEnqueueCopyImageToBuffer and clEnqueueCopyBufferToImage") {
+        SUBCASE("should copy packed region through buffer") {
+            const auto source =
+                createImage(kRGBA8, imageDesc(CL_MEM_OBJECT_IMAGE2D, 16, 16));
+            const auto destination =
+                createImage(kRGBA8, imageDesc(CL_MEM_OBJECT_IMAGE2D, 16, 16));
+            const auto buffer = test::createBuffer(0, 1024);
+            const auto queue = test::getCommandQueue();
+
+            const auto data = sequence(16 * 16);
+            const size_t zero[3] = {0, 0, 0};
+            const size_t all[3] = {16, 16, 1};
+            clEnqueueWriteImage(queue, source, false, zero, all, 0, 0,
+                                data.data(), 0, nullptr, nullptr);
+
+            const size_t origin[3] = {6, 4, 0};
+            const size_t region[3] = {9, 10, 1};
+            CHECK(clEnqueueCopyImageToBuffer(queue, source, buffer, origin,
+                                             region, 16, 0, nullptr,
+                                             nullptr) == CL_SUCCESS);
+            CHECK(clEnqueueCopyBufferToImage(queue, buffer, destination, 16,
+                                             origin, region, 0, nullptr,
+                                             nullptr) == CL_SUCCESS);
+
+            uint32_t texel;
+            clEnqueueReadBuffer(queue, buffer, true, 16 + 4 * 10,
+                                sizeof(texel), &texel, 0, nullptr, nullptr);
+            CHECK(texel == data[5 * 16 + 7]);
+
+            std::vector<uint32_t> out(16 * 16);
+            clEnqueueReadImage(queue, destination, true, zero, all, 0, 0,
+                               out.data(), 0, nullptr, nullptr);
+            CHECK(out[4 * 16 + 6] == data[4 * 16 + 6]);
+            CHECK(out[13 * 16 + 14] == data[13 * 16 + 14]);
+            CHECK(out[13 * 16 + 15] == 0);
+            clReleaseMemObject(source);
+            clReleaseMemObject(destination);
+        }
+
+        SUBCASE("fail if buffer is too small") {
+            const auto image =
+                createImage(kRGBA8, imageDesc(CL_MEM_OBJECT_IMAGE2D, 16, 16));
+            const auto buffer = test::createBuffer(0, 64);
+
+            const size_t origin[3] = {0, 0, 0};
+            const size_t region[3] = {4, 4, 1};
+            CHECK(clEnqueueCopyImageToBuffer(test::getCommandQueue(), image,
+                                             buffer, origin, region, 4, 0,
+                                             nullptr,
+                                             nullptr) == CL_INVALID_VALUE);
+            clReleaseMemObject(image);
+        }
+    }
+
+    TEST_CASE("clGetSupportedImageFormats") {
+        SUBCASE("should report common formats") {
+            cl_uint count;
+            CHECK(clGetSupportedImageFormats(test::getContext(), 0,
+                                             CL_MEM_OBJECT_IMAGE2D, 0, nullptr,
+                                             &count) == CL_SUCCESS);
+
+            std::vector<cl_image_format> formats(count);
+            clGetSupportedImageFormats(test::getContext(), 0,
+                                       CL_MEM_OBJECT_IMAGE2D, count,
+                                       formats.data(), nullptr);
+
+            const auto supports = [&](const cl_image_format& format) {
+                for (const auto& supported : formats) {
+                    if (supported.image_channel_order ==
+                            format.image_channel_order &&
+                        supported.image_channel_data_type ==
+                            format.image_channel_data_type) {
+                        return true;
+                    }
+                }
+                return false;
+            };
+            CHECK(supports(kRGBA8));
+            CHECK(supports(kR32F));
+            CHECK(supports({CL_RGBA, CL_FLOAT}));
+            CHECK(!supports({CL_BGRA, CL_FLOAT}));
+        }
+    }
+
+    TEST_CASE("clGetImageInfo") {
+        SUBCASE("should report format and sizes") {
+            const auto image = createImage(
+                kR32F, imageDesc(CL_MEM_OBJECT_IMAGE2D_ARRAY, 5, 6, 0, 7));
+
+            cl_image_format format;
+            clGetImageInfo(image, CL_IMAGE_FORMAT, sizeof(format), &format,
+                           nullptr);
+            CHECK(format.image_channel_order == CL_R);
+            CHECK(format.image_channel_data_type == CL_FLOAT);
+
+            const auto info = [&](cl_image_info parameter) {
+                size_t value;
+                clGetImageInfo(image, parameter, sizeof(value), &value,
+                               nullptr);
+                return value;
+            };
+            CHECK(info(CL_IMAGE_ELEMENT_SIZE) == 4);
+            CHECK(info(CL_IMAGE_ROW_PITCH) == 20);
+            CHECK(info(CL_IMAGE_SLICE_PITCH) == 120);
+            CHECK(info(CL_IMAGE_HEIGHT) == 6);
+            CHECK(info(CL_IMAGE_DEPTH) == 0);
+            CHECK(info(CL_IMAGE_ARRAY_SIZE) == 7);
+            clReleaseMemObject(image);
+        }
+
+        SUBCASE("fail if memory object is a buffer") {
+            size_t value;
+            CHECK(clGetImageInfo(test::createBuffer(), CL_IMAGE_WIDTH,
+                                 sizeof(value), &value,
+                                 nullptr) == CL_INVALID_MEM_OBJECT);
+        }
+    }
+}
@@ -1,6 +1,7 @@
 #include <common/test/doctest.h>
 
 #include <runtime/runtime-commons.h>
+#include <algorithm>
 #include <common/utils/vector-utils.hpp>
 #include <cstring>
 #include <vector>
@@ -12,7 +13,7 @@ TEST_SUITE("Memory API") {
     TEST_CASE("clRetainMemObject") {
         SUBCASE("increments mem object reference count") {
             const auto buffer = test::createBuffer();
-            const auto initRefCount = buffer->referenceCount;
+            const auto initRefCount = buffer->referenceCount.load();
             clRetainMemObject(buffer);
             CHECK(buffer->referenceCount == initRefCount + 1);
         }
@@ -26,7 +27,7 @@ TEST_SUITE("Memory API") {
         SUBCASE("decrements mem object reference count") {
             const auto buffer = test::createBuffer();
             clRetainMemObject(buffer);
-            const auto initRefCount = buffer->referenceCount;
+            const auto initRefCount = buffer->referenceCount.load();
 
             clReleaseMemObject(buffer);
 
@@ -36,7 +37,7 @@ TEST_SUITE("Memory API") {
         SUBCASE("should release context when ref count reaches zero") {
             const auto buffer = test::createBuffer();
             const auto context = buffer->context;
-            const auto initRefCount = context->referenceCount;
+            const auto initRefCount = context->referenceCount.load();
 
             clReleaseMemObject(buffer);
 
@@ -47,13 +48,33 @@ TEST_SUITE("Memory API") {
             const auto bufferSize = 16;
             const auto buffer = test::createBuffer(0, bufferSize);
             const auto device = buffer->context->device;
-            const auto initUsedMemory = device->usedGlobalMemory;
+            const auto initUsedMemory = device->usedGlobalMemory.load();
 
             clReleaseMemObject(buffer);
 
             CHECK(device->usedGlobalMemory == initUsedMemory - bufferSize);
         }
 
+        SUBCASE("should reuse released memory zeroed") {
+            const auto bufferSize = 100;
+            const auto buffer = test::createBuffer(0, bufferSize);
+            const auto device = buffer->context->device;
+            const auto initUsedMemory = device->usedGlobalMemory.load();
+            const auto address = buffer->address;
+            memset(address, 0xFF, bufferSize);
+
+            clReleaseMemObject(buffer);
+            const auto reused = test::createBuffer(0, bufferSize - 1);
+
+            CHECK(reused->address == address);
+            CHECK(device->usedGlobalMemory == initUsedMemory - 1);
+            CHECK(std::all_of(
+                reused->address, reused->address + bufferSize - 1,
+                [](std::byte value) { return value == std::byte{0}; }));
+
+            clReleaseMemObject(reused);
+        }
+
         SUBCASE("fail if mem object is null") {
             CHECK(clReleaseMemObject(nullptr) == CL_INVALID_MEM_OBJECT);
         }
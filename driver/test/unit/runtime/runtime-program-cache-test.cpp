@@ -0,0 +1,101 @@
+#include <common/test/doctest.h>
+
+#include <runtime/program/BinaryAsmParser.h>
+#include <runtime/program/ProgramCache.h>
+#include <common/utils/common.hpp>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "unit-test-common/test-commons.h"
+
+namespace {
+std::unique_ptr<BinaryDisassemblingResult> parseTestAsm() {
+    std::ifstream file("test/resources/kernels/a_plus_b.asm");
+    REQUIRE(file.is_open());
+    auto input = std::make_shared<std::string>(
+        std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return BinaryAsmParser(input).parseAsm();
+}
+
+// stands in for a program binary, entries only compare it
+std::vector<std::byte> testBinary(char filler) {
+    return std::vector<std::byte>(64, static_cast<std::byte>(filler));
+}
+
+// unique per process, so concurrent runs do not remove each other's entries
+std::string cacheDirectory() {
+    const auto directory =
+        std::filesystem::temp_directory_path() /
+        ("red-o-lator-cache-test-" + std::to_string(getpid()));
+    std::filesystem::remove_all(directory);
+    return directory.string();
+}
+}  // namespace
+
+TEST_SUITE("Program cache") {
+    TEST_CASE("ProgramCache") {
+        const auto directory = cacheDirectory();
+        const auto cache = ProgramCache(directory);
+        const auto parsed = parseTestAsm();
+        const auto binary = testBinary('a');
+
+        SUBCASE("should load what was stored") {
+            cache.store(42, binary.size(), binary.data(), *parsed);
+            const auto loaded = cache.load(42, binary.size(), binary.data());
+
+            REQUIRE(loaded != nullptr);
+            CHECK(loaded->gpuName == parsed->gpuName);
+            CHECK(loaded->compileOptions == parsed->compileOptions);
+            CHECK(loaded->parameters == parsed->parameters);
+            REQUIRE(loaded->kernels.size() == parsed->kernels.size());
+
+            const auto kernel = loaded->kernels[0]->get();
+            const auto expected = parsed->kernels[0]->get();
+            CHECK(kernel->name == expected->name);
+            CHECK(kernel->config == expected->config);
+            CHECK(kernel->instructions == expected->instructions);
+            CHECK(kernel->arguments.size() == expected->arguments.size());
+        }
+
+        SUBCASE("should miss unknown keys") {
+            cache.store(42, binary.size(), binary.data(), *parsed);
+            CHECK(cache.load(43, binary.size(), binary.data()) == nullptr);
+        }
+
+        SUBCASE("should miss entries of another binary with the same key") {
+            cache.store(42, binary.size(), binary.data(), *parsed);
+            const auto other = testBinary('b');
+            const auto shorter = std::vector<std::byte>(binary.begin() + 1,
+                                                        binary.end());
+
+            CHECK(cache.load(42, other.size(), other.data()) == nullptr);
+            CHECK(cache.load(42, shorter.size(), shorter.data()) == nullptr);
+        }
+
+        SUBCASE("should reject corrupted entries") {
+            cache.store(42, binary.size(), binary.data(), *parsed);
+            const auto entry =
+                std::filesystem::directory_iterator(directory)->path();
+            {
+                std::fstream file(entry, std::ios::binary | std::ios::in |
+                                             std::ios::out);
+                file.seekp(-1, std::ios::end);
+                file.put('#');
+            }
+            CHECK(cache.load(42, binary.size(), binary.data()) == nullptr);
+        }
+
+        SUBCASE("should do nothing when disabled") {
+            const auto disabled = ProgramCache("");
+            disabled.store(42, binary.size(), binary.data(), *parsed);
+            CHECK(!disabled.isEnabled());
+            CHECK(disabled.load(42, binary.size(), binary.data()) == nullptr);
+        }
+
+        std::filesystem::remove_all(directory);
+    }
+}
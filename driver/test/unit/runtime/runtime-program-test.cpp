@@ -14,7 +14,7 @@ TEST_SUITE("Program API") {
     TEST_CASE("clCreateProgramWithBinary") {
         SUBCASE("program can be created with valid binary") {
             const auto context = test::getContext();
-            const auto contextInitRefCount = context->referenceCount;
+            const auto contextInitRefCount = context->referenceCount.load();
             const cl_device_id device[1] = {context->device};
 
             const auto binary = utils::readBinaryFile(binaryPath);
@@ -95,7 +95,7 @@ TEST_SUITE("Program API") {
     TEST_CASE("clRetainProgram") {
         SUBCASE("increments program ref counter") {
             const auto program = test::getProgram(binaryPath);
-            const auto initialRefCount = program->referenceCount;
+            const auto initialRefCount = program->referenceCount.load();
 
             const auto error = clRetainProgram(program);
 
@@ -110,7 +110,7 @@ TEST_SUITE("Program API") {
 
             clRetainProgram(program);
 
-            const auto initialRefCount = program->referenceCount;
+            const auto initialRefCount = program->referenceCount.load();
 
             const auto error = clReleaseProgram(program);
 
@@ -131,6 +131,22 @@ TEST_SUITE("Program API") {
             CHECK(error == CL_SUCCESS);
             CHECK(out == program->referenceCount);
         }
+
+        SUBCASE("get kernel count and names") {
+            const auto program = test::getProgram(binaryPath);
+
+            size_t count;
+            auto error = clGetProgramInfo(program, CL_PROGRAM_NUM_KERNELS,
+                                          sizeof(size_t), &count, nullptr);
+            CHECK(error == CL_SUCCESS);
+            CHECK(count == 1);
+
+            char names[64];
+            error = clGetProgramInfo(program, CL_PROGRAM_KERNEL_NAMES,
+                                     sizeof(names), names, nullptr);
+            CHECK(error == CL_SUCCESS);
+            CHECK(std::string(names) == "a_plus_b");
+        }
     }
 
     TEST_CASE("clGetProgramBuildInfo") {
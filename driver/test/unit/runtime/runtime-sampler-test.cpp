@@ -0,0 +1,203 @@
+#include <common/test/doctest.h>
+
+#include <runtime/memory/ImageSampler.h>
+#include <cstring>
+#include <vector>
+
+#include "runtime/icd/icd.h"
+#include "unit-test-common/test-commons.h"
+
+namespace {
+cl_sampler createSampler(cl_bool normalizedCoords,
+                         cl_addressing_mode addressingMode,
+                         cl_filter_mode filterMode) {
+    cl_int error;
+    const auto sampler = clCreateSampler(test::getContext(), normalizedCoords,
+                                         addressingMode, filterMode, &error);
+    REQUIRE(error == CL_SUCCESS);
+    return sampler;
+}
+
+/**
+ * 4x4 R32F image with texel (x, y) equal to 10 * y + x.
+ */
+cl_mem createGradientImage() {
+    std::vector<float> data(16);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<float>(i / 4 * 10 + i % 4);
+    }
+
+    const cl_image_format format{CL_R, CL_FLOAT};
+    cl_image_desc desc{};
+    desc.image_type = CL_MEM_OBJECT_IMAGE2D;
+    desc.image_width = 4;
+    desc.image_height = 4;
+
+    cl_int error;
+    const auto image =
+        clCreateImage(test::getContext(), CL_MEM_COPY_HOST_PTR, &format,
+                      &desc, data.data(), &error);
+    REQUIRE(error == CL_SUCCESS);
+    return image;
+}
+
+float channelAt(const ImageSampler::Result& result,
+                size_t channel,
+                size_t lane) {
+    float value;
+    memcpy(&value, &result[channel][lane], sizeof(value));
+    return value;
+}
+}  // namespace
+
+TEST_SUITE("Sampler API") {
+    TEST_CASE("clCreateSampler") {
+        SUBCASE("should create sampler and report its state") {
+            const auto sampler =
+                createSampler(true, CL_ADDRESS_REPEAT, CL_FILTER_LINEAR);
+
+            cl_bool normalized;
+            cl_addressing_mode addressing;
+            cl_filter_mode filter;
+            cl_uint referenceCount;
+            clGetSamplerInfo(sampler, CL_SAMPLER_NORMALIZED_COORDS,
+                             sizeof(normalized), &normalized, nullptr);
+            clGetSamplerInfo(sampler, CL_SAMPLER_ADDRESSING_MODE,
+                             sizeof(addressing), &addressing, nullptr);
+            clGetSamplerInfo(sampler, CL_SAMPLER_FILTER_MODE, sizeof(filter),
+                             &filter, nullptr);
+            clGetSamplerInfo(sampler, CL_SAMPLER_REFERENCE_COUNT,
+                             sizeof(referenceCount), &referenceCount,
+                             nullptr);
+
+            CHECK(normalized == CL_TRUE);
+            CHECK(addressing == CL_ADDRESS_REPEAT);
+            CHECK(filter == CL_FILTER_LINEAR);
+            CHECK(referenceCount == 1);
+            clReleaseSampler(sampler);
+        }
+
+        SUBCASE("retains context until released") {
+            const auto context = test::getContext();
+            const auto initialRefCount = context->referenceCount.load();
+
+            cl_int error;
+            const auto sampler = clCreateSampler(
+                context, false, CL_ADDRESS_CLAMP, CL_FILTER_NEAREST, &error);
+            CHECK(error == CL_SUCCESS);
+            CHECK(context->referenceCount == initialRefCount + 1);
+
+            clRetainSampler(sampler);
+            clReleaseSampler(sampler);
+            CHECK(context->referenceCount == initialRefCount + 1);
+
+            clReleaseSampler(sampler);
+            CHECK(context->referenceCount == initialRefCount);
+        }
+
+        SUBCASE("fail if repeat is used with unnormalized coordinates") {
+            cl_int error;
+            clCreateSampler(test::getContext(), false, CL_ADDRESS_REPEAT,
+                            CL_FILTER_NEAREST, &error);
+            CHECK(error == CL_INVALID_VALUE);
+        }
+
+        SUBCASE("fail if modes are unknown") {
+            cl_int error;
+            clCreateSampler(test::getContext(), true, 0, CL_FILTER_NEAREST,
+                            &error);
+            CHECK(error == CL_INVALID_VALUE);
+            clCreateSampler(test::getContext(), true, CL_ADDRESS_CLAMP, 0,
+                            &error);
+            CHECK(error == CL_INVALID_VALUE);
+        }
+    }
+
+    TEST_CASE("ImageSampler") {
+        const auto image = createGradientImage();
+        ImageSampler::Coordinates coordinates{};
+        ImageSampler::Result result{};
+
+        SUBCASE("nearest filter should read texels under coordinates") {
+            const auto sampler =
+                createSampler(false, CL_ADDRESS_CLAMP_TO_EDGE,
+                              CL_FILTER_NEAREST);
+            for (size_t lane = 0; lane < ImageSampler::kLanes; ++lane) {
+                coordinates[0][lane] = static_cast<float>(lane % 4) + 0.7f;
+                coordinates[1][lane] = static_cast<float>(lane / 4 % 4);
+            }
+
+            ImageSampler(*image, *sampler).sample(coordinates, ~0ull, result);
+
+            bool matches = true;
+            for (size_t lane = 0; lane < ImageSampler::kLanes; ++lane) {
+                matches = matches && channelAt(result, 0, lane) ==
+                                         lane / 4 % 4 * 10 + lane % 4;
+            }
+            CHECK(matches);
+            CHECK(channelAt(result, 1, 0) == 0.0f);
+            CHECK(channelAt(result, 3, 0) == 1.0f);
+            clReleaseSampler(sampler);
+        }
+
+        SUBCASE("linear filter should blend neighbours") {
+            const auto sampler =
+                createSampler(true, CL_ADDRESS_CLAMP_TO_EDGE, CL_FILTER_LINEAR);
+            // between texels (1, 1), (2, 1), (1, 2) and (2, 2)
+            coordinates[0][0] = 0.5f;
+            coordinates[1][0] = 0.5f;
+            // a quarter of the way from (0, 0) to (1, 0)
+            coordinates[0][1] = 0.1875f;
+            coordinates[1][1] = 0.125f;
+            // clamped to the corner texel
+            coordinates[0][2] = -1.0f;
+            coordinates[1][2] = 2.0f;
+
+            ImageSampler(*image, *sampler).sample(coordinates, 0b111, result);
+
+            CHECK(channelAt(result, 0, 0) == doctest::Approx(16.5f));
+            CHECK(channelAt(result, 0, 1) == doctest::Approx(0.25f));
+            CHECK(channelAt(result, 0, 2) == doctest::Approx(30.0f));
+            CHECK(channelAt(result, 3, 0) == doctest::Approx(1.0f));
+            CHECK(result[0][3] == 0);
+            clReleaseSampler(sampler);
+        }
+
+        SUBCASE("clamp should blend with border color") {
+            const auto sampler =
+                createSampler(false, CL_ADDRESS_CLAMP, CL_FILTER_LINEAR);
+            // half of texel (3, 0) and half of the border
+            coordinates[0][0] = 4.0f;
+            coordinates[1][0] = 0.5f;
+            coordinates[0][1] = 10.0f;
+            coordinates[1][1] = 10.0f;
+
+            ImageSampler(*image, *sampler).sample(coordinates, 0b11, result);
+
+            CHECK(channelAt(result, 0, 0) == doctest::Approx(1.5f));
+            CHECK(channelAt(result, 0, 1) == 0.0f);
+            // no alpha channel, so the border is opaque
+            CHECK(channelAt(result, 3, 1) == 1.0f);
+            clReleaseSampler(sampler);
+        }
+
+        SUBCASE("repeat and mirrored repeat should wrap coordinates") {
+            const auto repeat =
+                createSampler(true, CL_ADDRESS_REPEAT, CL_FILTER_NEAREST);
+            const auto mirrored = createSampler(
+                true, CL_ADDRESS_MIRRORED_REPEAT, CL_FILTER_NEAREST);
+            coordinates[0][0] = 1.375f;
+            coordinates[1][0] = -0.125f;
+
+            ImageSampler(*image, *repeat).sample(coordinates, 1, result);
+            CHECK(channelAt(result, 0, 0) == 31.0f);
+
+            ImageSampler(*image, *mirrored).sample(coordinates, 1, result);
+            CHECK(channelAt(result, 0, 0) == 2.0f);
+            clReleaseSampler(repeat);
+            clReleaseSampler(mirrored);
+        }
+
+        clReleaseMemObject(image);
+    }
+}
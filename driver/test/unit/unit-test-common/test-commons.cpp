@@ -51,7 +51,7 @@ std::pair<cl_mem, cl_int> createBufferSafe(cl_mem_flags flags,
                                            size_t size,
                                            void* hostPtr) {
     auto context = test::getContext();
-    const auto initRefCount = context->referenceCount;
+    const auto initRefCount = context->referenceCount.load();
     cl_int errorCode;
     cl_mem buffer = clCreateBuffer(context, flags, size, hostPtr, &errorCode);
 
@@ -0,0 +1,61 @@
+//
+// Created by Diana Kudaiberdieva
+//
+
+#ifndef RED_O_LATOR_ACCESS_RING_H
+#define RED_O_LATOR_ACCESS_RING_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+/**
+ * Bounded single-producer single-consumer ring buffer. One instance is owned
+ * by every emulator thread, so push() never contends with another producer.
+ */
+template <typename T, size_t Capacity>
+class AccessRing {
+    static_assert((Capacity & (Capacity - 1)) == 0,
+                  "Ring capacity must be a power of two");
+
+   public:
+    /**
+     * @return false if the ring is full
+     */
+    bool push(const T& value) {
+        const size_t tail = this->tail.load(std::memory_order_relaxed);
+        if (tail - head.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        items[tail & (Capacity - 1)] = value;
+        this->tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Hands every available item to consume and releases their slots.
+     * @return number of consumed items
+     */
+    template <typename Consumer>
+    size_t drain(Consumer&& consume) {
+        const size_t head = this->head.load(std::memory_order_relaxed);
+        const size_t tail = this->tail.load(std::memory_order_acquire);
+        for (size_t i = head; i != tail; ++i) {
+            consume(items[i & (Capacity - 1)]);
+        }
+        this->head.store(tail, std::memory_order_release);
+        return tail - head;
+    }
+
+    bool empty() const {
+        return head.load(std::memory_order_acquire) ==
+               tail.load(std::memory_order_acquire);
+    }
+
+   private:
+    std::array<T, Capacity> items;
+    alignas(64) std::atomic<size_t> head{0};
+    alignas(64) std::atomic<size_t> tail{0};
+};
+
+#endif  // RED_O_LATOR_ACCESS_RING_H
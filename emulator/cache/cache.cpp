@@ -0,0 +1,78 @@
+//
+// Created by Diana Kudaiberdieva
+//
+
+#include <stdexcept>
+
+#include "cache.h"
+
+Cache::Cache(const CacheConfig& config) : config(config), line_shift(0) {
+    if (config.line_size == 0 ||
+        (config.line_size & (config.line_size - 1)) != 0) {
+        throw std::invalid_argument("Cache line size must be a power of two");
+    }
+    if (config.ways == 0 || config.size == 0 ||
+        config.size % (config.ways * config.line_size) != 0) {
+        throw std::invalid_argument(
+            "Cache size must be a multiple of ways * line size");
+    }
+
+    while ((1u << line_shift) < config.line_size) {
+        line_shift++;
+    }
+    lines.resize(static_cast<size_t>(config.sets()) * config.ways);
+}
+
+bool Cache::access(uint64_t address, bool write) {
+    const uint64_t line_address = address >> line_shift;
+    const size_t set_begin = (line_address % config.sets()) * config.ways;
+    const uint64_t tag = line_address / config.sets();
+    clock++;
+
+    for (size_t i = set_begin; i < set_begin + config.ways; ++i) {
+        auto& line = lines[i];
+        if (line.valid && line.tag == tag) {
+            if (config.replacement == LRU_REPLACEMENT) {
+                line.stamp = clock;
+            }
+            stats.record(true);
+            return true;
+        }
+    }
+
+    stats.record(false);
+    if (write && !config.write_allocate) {
+        return false;
+    }
+
+    auto& victim = lines[choose_victim(set_begin)];
+    victim.tag = tag;
+    victim.stamp = clock;
+    victim.valid = true;
+    return false;
+}
+
+size_t Cache::choose_victim(size_t set_begin) {
+    for (size_t i = set_begin; i < set_begin + config.ways; ++i) {
+        if (!lines[i].valid) {
+            return i;
+        }
+    }
+
+    if (config.replacement == RANDOM_REPLACEMENT) {
+        // xorshift64, deterministic between runs
+        random_state ^= random_state << 13;
+        random_state ^= random_state >> 7;
+        random_state ^= random_state << 17;
+        return set_begin + random_state % config.ways;
+    }
+
+    // LRU and FIFO differ only in when the stamp is refreshed
+    size_t victim = set_begin;
+    for (size_t i = set_begin + 1; i < set_begin + config.ways; ++i) {
+        if (lines[i].stamp < lines[victim].stamp) {
+            victim = i;
+        }
+    }
+    return victim;
+}
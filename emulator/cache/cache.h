@@ -0,0 +1,85 @@
+//
+// Created by Diana Kudaiberdieva
+//
+
+#ifndef RED_O_LATOR_CACHE_H
+#define RED_O_LATOR_CACHE_H
+
+#include <cstdint>
+#include <vector>
+
+enum ReplacementPolicy { LRU_REPLACEMENT, FIFO_REPLACEMENT, RANDOM_REPLACEMENT };
+
+struct CacheConfig {
+    uint32_t size;
+    uint32_t ways;
+    uint32_t line_size;
+    ReplacementPolicy replacement = LRU_REPLACEMENT;
+    // write-through caches (vector L1) don't allocate a line on write miss
+    bool write_allocate = true;
+
+    uint32_t sets() const {
+        return size / (ways * line_size);
+    }
+};
+
+struct CacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+
+    uint64_t accesses() const {
+        return hits + misses;
+    }
+
+    double hit_rate() const {
+        return accesses() == 0 ? 0 : static_cast<double>(hits) / accesses();
+    }
+
+    void record(bool hit) {
+        hit ? hits++ : misses++;
+    }
+};
+
+/**
+ * Set-associative cache which tracks tags only, no data.
+ */
+class Cache {
+   public:
+    /**
+     * @throws std::invalid_argument if size is not a multiple of
+     * ways * line_size or line_size is not a power of two
+     */
+    explicit Cache(const CacheConfig& config);
+
+    /**
+     * Looks up the line containing address and updates replacement state.
+     * @return true on hit
+     */
+    bool access(uint64_t address, bool write = false);
+
+    const CacheConfig& get_config() const {
+        return config;
+    }
+
+    const CacheStats& get_stats() const {
+        return stats;
+    }
+
+   private:
+    struct Line {
+        uint64_t tag;
+        uint64_t stamp;
+        bool valid = false;
+    };
+
+    CacheConfig config;
+    uint32_t line_shift;
+    std::vector<Line> lines;
+    uint64_t clock = 0;
+    uint64_t random_state = 0x9E3779B97F4A7C15ull;
+    CacheStats stats;
+
+    size_t choose_victim(size_t set_begin);
+};
+
+#endif  // RED_O_LATOR_CACHE_H
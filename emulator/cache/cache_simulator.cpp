@@ -0,0 +1,213 @@
+//
+// Created by Diana Kudaiberdieva
+//
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+
+#include "cache_simulator.h"
+
+char const* get_cache_level_str(CacheLevel level) noexcept {
+    switch (level) {
+        case L1I_CACHE: return "L1I";
+        case SCALAR_L1_CACHE: return "scalar L1";
+        case VECTOR_L1_CACHE: return "vector L1";
+        case L2_CACHE: return "L2";
+        default: return "UNKNOWN";
+    }
+}
+
+CacheHierarchyConfig CacheHierarchyConfig::from_device_config(
+    const DeviceConfig& device) {
+    CacheHierarchyConfig config;
+    config.compute_units = device.get_uint("CL_DEVICE_MAX_COMPUTE_UNITS",
+                                           config.compute_units);
+    config.vector_l1.size = device.get_uint("CL_DEVICE_GLOBAL_MEM_CACHE_SIZE",
+                                            config.vector_l1.size);
+
+    const uint32_t line_size = device.get_uint(
+        "CL_DEVICE_GLOBAL_MEM_CACHELINE_SIZE", config.vector_l1.line_size);
+    config.l1i.line_size = line_size;
+    config.scalar_l1.line_size = line_size;
+    config.vector_l1.line_size = line_size;
+    config.l2.line_size = line_size;
+    return config;
+}
+
+CacheHierarchy::CacheHierarchy(const CacheHierarchyConfig& config)
+    : config(config), l2(config.l2) {
+    const uint32_t compute_units = std::max(config.compute_units, 1u);
+    const uint32_t clusters =
+        (compute_units + config.cu_per_cluster - 1) / config.cu_per_cluster;
+
+    l1i.assign(clusters, Cache(config.l1i));
+    scalar_l1.assign(clusters, Cache(config.scalar_l1));
+    vector_l1.assign(compute_units, Cache(config.vector_l1));
+}
+
+Cache& CacheHierarchy::first_level(const CacheAccess& access,
+                                   CacheLevel& level) {
+    const size_t cu = access.compute_unit % vector_l1.size();
+    const size_t cluster = cu / config.cu_per_cluster;
+
+    switch (access.type) {
+        case INSTR_FETCH: level = L1I_CACHE; return l1i[cluster];
+        case SCALAR_LOAD: level = SCALAR_L1_CACHE; return scalar_l1[cluster];
+        default: level = VECTOR_L1_CACHE; return vector_l1[cu];
+    }
+}
+
+void CacheHierarchy::access(const CacheAccess& access,
+                            KernelCacheStats& stats) {
+    CacheLevel level;
+    Cache& l1 = first_level(access, level);
+    const bool write = access.type == VECTOR_STORE;
+
+    const uint64_t line_size = l1.get_config().line_size;
+    const uint64_t first_line = access.address / line_size;
+    const uint64_t last_line =
+        (access.address + std::max<uint16_t>(access.size, 1) - 1) / line_size;
+
+    bool all_hit = true;
+    for (uint64_t line = first_line; line <= last_line; ++line) {
+        const bool hit = l1.access(line * line_size, write);
+        stats.levels[level].record(hit);
+
+        // vector L1 is write-through, stores always reach L2
+        if (!hit || write) {
+            stats.levels[L2_CACHE].record(l2.access(line * line_size, write));
+        }
+        all_hit = all_hit && hit;
+    }
+    stats.pcs[access.pc].record(all_hit);
+}
+
+static std::atomic<uint64_t> kNextSimulatorId{0};
+
+CacheSimulator::CacheSimulator(const CacheHierarchyConfig& config)
+    : id(kNextSimulatorId++), hierarchy(config) {
+    consumer = std::thread(&CacheSimulator::consume, this);
+}
+
+CacheSimulator::~CacheSimulator() {
+    running = false;
+    consumer.join();
+}
+
+uint32_t CacheSimulator::register_kernel(const std::string& name) {
+    std::lock_guard<std::mutex> lock(stats_mutex);
+    kernel_names.push_back(name);
+    kernel_stats.emplace_back();
+    return kernel_names.size() - 1;
+}
+
+CacheSimulator::Ring& CacheSimulator::local_ring() {
+    thread_local std::unordered_map<uint64_t, Ring*> thread_rings;
+
+    auto it = thread_rings.find(id);
+    if (it != thread_rings.end()) {
+        return *it->second;
+    }
+
+    std::lock_guard<std::mutex> lock(rings_mutex);
+    rings.push_back(std::make_unique<Ring>());
+    thread_rings[id] = rings.back().get();
+    return *rings.back();
+}
+
+void CacheSimulator::record(const CacheAccess& access) {
+    Ring& ring = local_ring();
+    while (!ring.push(access)) {
+        std::this_thread::yield();
+    }
+}
+
+size_t CacheSimulator::drain() {
+    std::vector<Ring*> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(rings_mutex);
+        for (const auto& ring : rings) {
+            snapshot.push_back(ring.get());
+        }
+    }
+
+    size_t consumed = 0;
+    std::lock_guard<std::mutex> lock(stats_mutex);
+    for (auto ring : snapshot) {
+        consumed += ring->drain([this](const CacheAccess& access) {
+            if (access.kernel < kernel_stats.size()) {
+                hierarchy.access(access, kernel_stats[access.kernel]);
+            }
+        });
+    }
+    return consumed;
+}
+
+void CacheSimulator::consume() {
+    while (running) {
+        if (drain() == 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+    drain();
+}
+
+void CacheSimulator::flush() {
+    std::vector<Ring*> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(rings_mutex);
+        for (const auto& ring : rings) {
+            snapshot.push_back(ring.get());
+        }
+    }
+
+    for (auto ring : snapshot) {
+        while (!ring->empty()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+KernelCacheStats CacheSimulator::get_kernel_stats(uint32_t kernel) {
+    flush();
+    std::lock_guard<std::mutex> lock(stats_mutex);
+    return kernel < kernel_stats.size() ? kernel_stats[kernel]
+                                        : KernelCacheStats();
+}
+
+std::string CacheSimulator::report(size_t pcs_per_kernel) {
+    flush();
+    std::lock_guard<std::mutex> lock(stats_mutex);
+
+    std::stringstream out;
+    for (size_t kernel = 0; kernel < kernel_stats.size(); ++kernel) {
+        const auto& stats = kernel_stats[kernel];
+        out << "Kernel " << kernel_names[kernel] << "\n";
+
+        for (int level = 0; level < CACHE_LEVEL_COUNT; ++level) {
+            const auto& level_stats = stats.levels[level];
+            if (level_stats.accesses() == 0) {
+                continue;
+            }
+            out << "  " << get_cache_level_str(static_cast<CacheLevel>(level))
+                << ": " << level_stats.hit_rate() * 100 << "% hits ("
+                << level_stats.hits << "/" << level_stats.accesses() << ")\n";
+        }
+
+        std::vector<std::pair<uint64_t, CacheStats>> pcs(stats.pcs.begin(),
+                                                         stats.pcs.end());
+        std::sort(pcs.begin(), pcs.end(), [](const auto& a, const auto& b) {
+            return a.second.misses > b.second.misses ||
+                   (a.second.misses == b.second.misses && a.first < b.first);
+        });
+        pcs.resize(std::min(pcs.size(), pcs_per_kernel));
+
+        for (const auto& [pc, pc_stats] : pcs) {
+            out << "  pc 0x" << std::hex << pc << std::dec << ": "
+                << pc_stats.hit_rate() * 100 << "% hits (" << pc_stats.misses
+                << " misses)\n";
+        }
+    }
+    return out.str();
+}
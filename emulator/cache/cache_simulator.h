@@ -0,0 +1,148 @@
+//
+// Created by Diana Kudaiberdieva
+//
+
+#ifndef RED_O_LATOR_CACHE_SIMULATOR_H
+#define RED_O_LATOR_CACHE_SIMULATOR_H
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "access_ring.h"
+#include "cache.h"
+#include "util/device_config.h"
+
+enum CacheAccessType { INSTR_FETCH, SCALAR_LOAD, VECTOR_LOAD, VECTOR_STORE };
+
+enum CacheLevel {
+    L1I_CACHE,
+    SCALAR_L1_CACHE,
+    VECTOR_L1_CACHE,
+    L2_CACHE,
+    CACHE_LEVEL_COUNT
+};
+
+char const* get_cache_level_str(CacheLevel) noexcept;
+
+struct CacheAccess {
+    uint64_t address;
+    uint64_t pc;
+    uint32_t kernel;
+    uint16_t compute_unit;
+    uint16_t size;
+    CacheAccessType type;
+};
+
+/**
+ * GCN cache hierarchy, see note.txt: L1I and scalar L1 are shared by a
+ * cluster of compute units, vector L1 is per compute unit, L2 is global.
+ */
+struct CacheHierarchyConfig {
+    uint32_t compute_units = 32;
+    uint32_t cu_per_cluster = 4;
+    CacheConfig l1i = {32 * 1024, 4, 64};
+    CacheConfig scalar_l1 = {16 * 1024, 4, 64};
+    CacheConfig vector_l1 = {16 * 1024, 4, 64, LRU_REPLACEMENT, false};
+    CacheConfig l2 = {2 * 1024 * 1024, 16, 64};
+
+    /**
+     * Reads CL_DEVICE_MAX_COMPUTE_UNITS and the vector L1 geometry from
+     * CL_DEVICE_GLOBAL_MEM_CACHE_SIZE / CL_DEVICE_GLOBAL_MEM_CACHELINE_SIZE.
+     * Line size of the other levels follows the vector L1 one.
+     */
+    static CacheHierarchyConfig from_device_config(const DeviceConfig& config);
+};
+
+struct KernelCacheStats {
+    std::array<CacheStats, CACHE_LEVEL_COUNT> levels;
+    // first-level hit rate of every instruction that touched memory
+    std::unordered_map<uint64_t, CacheStats> pcs;
+};
+
+/**
+ * Not thread-safe, owned by the CacheSimulator consumer thread.
+ */
+class CacheHierarchy {
+   public:
+    explicit CacheHierarchy(const CacheHierarchyConfig& config);
+
+    void access(const CacheAccess& access, KernelCacheStats& stats);
+
+   private:
+    CacheHierarchyConfig config;
+    std::vector<Cache> l1i;
+    std::vector<Cache> scalar_l1;
+    std::vector<Cache> vector_l1;
+    Cache l2;
+
+    Cache& first_level(const CacheAccess& access, CacheLevel& level);
+};
+
+/**
+ * Collects address streams from producer threads. Every producer thread
+ * writes into its own lock-free ring, a background thread drains the rings
+ * into the CacheHierarchy so the functional run is not slowed down by the
+ * simulation.
+ *
+ * Nothing feeds it yet: the emulator has no execution loop, which is meant
+ * to register a producer per thread and record every fetch, load and store.
+ */
+class CacheSimulator {
+   public:
+    explicit CacheSimulator(
+        const CacheHierarchyConfig& config = CacheHierarchyConfig());
+    ~CacheSimulator();
+
+    CacheSimulator(const CacheSimulator&) = delete;
+    CacheSimulator& operator=(const CacheSimulator&) = delete;
+
+    /**
+     * @return id to put into CacheAccess::kernel
+     */
+    uint32_t register_kernel(const std::string& name);
+
+    /**
+     * Can be called from any thread. Blocks only if the thread's ring is
+     * full and the consumer is behind.
+     */
+    void record(const CacheAccess& access);
+
+    /**
+     * Waits until every access recorded so far is simulated.
+     */
+    void flush();
+
+    KernelCacheStats get_kernel_stats(uint32_t kernel);
+
+    /**
+     * @return hit rates per kernel and cache level, and the pcs with
+     * the most first-level misses
+     */
+    std::string report(size_t pcs_per_kernel = 10);
+
+   private:
+    using Ring = AccessRing<CacheAccess, 4096>;
+
+    const uint64_t id;
+    std::mutex rings_mutex;
+    std::vector<std::unique_ptr<Ring>> rings;
+
+    std::mutex stats_mutex;
+    CacheHierarchy hierarchy;
+    std::vector<std::string> kernel_names;
+    std::vector<KernelCacheStats> kernel_stats;
+
+    std::atomic<bool> running{true};
+    std::thread consumer;
+
+    Ring& local_ring();
+    size_t drain();
+    void consume();
+};
+
+#endif  // RED_O_LATOR_CACHE_SIMULATOR_H
@@ -0,0 +1,51 @@
+//
+// Created by Diana Kudaiberdieva
+//
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "checkpoint.h"
+
+CheckpointHistory::CheckpointHistory(size_t max_checkpoints)
+    : max_checkpoints(std::max<size_t>(max_checkpoints, 1)) {}
+
+void CheckpointHistory::save(uint64_t step, DispatchState& state) {
+    DispatchState checkpoint;
+    checkpoint.wavefronts = state.wavefronts;
+    checkpoint.lds = state.lds.snapshot();
+    checkpoint.buffers.reserve(state.buffers.size());
+    for (auto& buffer : state.buffers) {
+        checkpoint.buffers.push_back(buffer.snapshot());
+    }
+
+    checkpoints.insert_or_assign(step, std::move(checkpoint));
+
+    // Thin out old history instead of dropping it, so that far jumps back
+    // are still possible: remove every second checkpoint of the older half
+    if (checkpoints.size() > max_checkpoints) {
+        const size_t older = checkpoints.size() / 2;
+        auto it = checkpoints.begin();
+        for (size_t i = 0; i < older; ++i) {
+            it = i % 2 == 1 ? checkpoints.erase(it) : std::next(it);
+        }
+    }
+}
+
+uint64_t CheckpointHistory::restore(uint64_t step, DispatchState& state) const {
+    auto it = checkpoints.upper_bound(step);
+    if (it == checkpoints.begin()) {
+        throw std::out_of_range("No checkpoint at or before step " +
+                                std::to_string(step));
+    }
+    --it;
+
+    // restoring is a copy too, the checkpoint stays usable
+    state = it->second;
+    return it->first;
+}
+
+void CheckpointHistory::discard_after(uint64_t step) {
+    checkpoints.erase(checkpoints.upper_bound(step), checkpoints.end());
+}
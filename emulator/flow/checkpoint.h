@@ -0,0 +1,58 @@
+//
+// Created by Diana Kudaiberdieva
+//
+
+#ifndef RED_O_LATOR_CHECKPOINT_H
+#define RED_O_LATOR_CHECKPOINT_H
+
+#include <cstdint>
+#include <map>
+#include <vector>
+#include "flow/wavefront.h"
+#include "mem/paged_memory.h"
+
+/**
+ * Everything needed to continue a dispatch from an arbitrary instruction.
+ */
+struct DispatchState {
+    std::vector<Wavefront> wavefronts;
+    PagedMemory lds;
+    std::vector<PagedMemory> buffers;
+};
+
+/**
+ * Keeps checkpoints of a dispatch keyed by the number of executed
+ * instructions. Memory is snapshotted copy-on-write, so taking a checkpoint
+ * doesn't copy buffer contents. A checkpoint taken before the target step
+ * is restored as is, executing the remaining instructions up to the target
+ * is left to the caller.
+ */
+class CheckpointHistory {
+   public:
+    explicit CheckpointHistory(size_t max_checkpoints = 64);
+
+    void save(uint64_t step, DispatchState& state);
+
+    /**
+     * Replaces state with the latest checkpoint taken at or before step.
+     * @return step of the restored checkpoint
+     * @throws std::out_of_range if there is no such checkpoint
+     */
+    uint64_t restore(uint64_t step, DispatchState& state) const;
+
+    /**
+     * Drops checkpoints taken after step, e.g. when the user changes memory
+     * in the debugger and the recorded future becomes invalid.
+     */
+    void discard_after(uint64_t step);
+
+    size_t size() const {
+        return checkpoints.size();
+    }
+
+   private:
+    size_t max_checkpoints;
+    std::map<uint64_t, DispatchState> checkpoints;
+};
+
+#endif  // RED_O_LATOR_CHECKPOINT_H
@@ -0,0 +1,200 @@
+//
+// Created by Diana Kudaiberdieva
+//
+
+#include <condition_variable>
+#include <limits>
+
+#include "scheduler.h"
+
+static constexpr uint64_t kFinishedClock = std::numeric_limits<uint64_t>::max();
+
+static uint64_t split_mix(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+/**
+ * Reusable barrier for the batch boundaries of the deterministic mode,
+ * on_complete is run by the last arriving thread before the others leave.
+ */
+class BatchBarrier {
+   public:
+    explicit BatchBarrier(size_t count) : count(count), waiting(0) {}
+
+    template <typename F>
+    void arrive_and_wait(F&& on_complete) {
+        std::unique_lock<std::mutex> lock(mutex);
+        const size_t current_generation = generation;
+        if (++waiting == count) {
+            on_complete();
+            waiting = 0;
+            generation++;
+            condition.notify_all();
+            return;
+        }
+        condition.wait(lock,
+                       [&]() { return generation != current_generation; });
+    }
+
+   private:
+    std::mutex mutex;
+    std::condition_variable condition;
+    const size_t count;
+    size_t waiting;
+    size_t generation = 0;
+};
+
+void WorkGroupContext::acquire_turn() {
+    if (!scheduler->config.deterministic) {
+        scheduler->atomic_mutex.lock();
+        return;
+    }
+
+    // Kendo-style ordering: a work-group may commit only while it has the
+    // smallest (logical clock, slot) pair among the running ones
+    for (size_t other = 0; other < scheduler->config.threads; ++other) {
+        if (other == slot) {
+            continue;
+        }
+        const auto& other_clock = scheduler->clocks[other].value;
+        uint64_t value;
+        while ((value = other_clock.load(std::memory_order_acquire)) < clock ||
+               (value == clock && other < slot)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void WorkGroupContext::release_turn() {
+    if (!scheduler->config.deterministic) {
+        scheduler->atomic_mutex.unlock();
+        return;
+    }
+    scheduler->tick(*this);
+}
+
+Scheduler::Scheduler(const SchedulerConfig& config)
+    : config(config),
+      clocks(std::make_unique<LogicalClock[]>(
+          std::max<size_t>(config.threads, 1))) {
+    this->config.threads = std::max<size_t>(config.threads, 1);
+    this->config.max_quantum = std::max(config.max_quantum, 1u);
+}
+
+void Scheduler::tick(WorkGroupContext& context) {
+    context.clock++;
+    clocks[context.slot].value.store(context.clock, std::memory_order_release);
+}
+
+void Scheduler::run(size_t work_groups,
+                    size_t wavefronts_per_group,
+                    const WavefrontStep& step) {
+    const size_t threads = std::min(config.threads, work_groups);
+    if (threads == 0) {
+        return;
+    }
+
+    BatchBarrier barrier(threads);
+    std::vector<std::thread> pool;
+
+    if (!config.deterministic) {
+        std::atomic<size_t> next_work_group{0};
+        for (size_t slot = 0; slot < threads; ++slot) {
+            pool.emplace_back([&, slot]() {
+                size_t id;
+                while ((id = next_work_group++) < work_groups) {
+                    WorkGroupContext context(this, id, slot);
+                    run_work_group(context, wavefronts_per_group, step);
+                }
+            });
+        }
+    } else {
+        // Work-groups are dealt out in fixed batches, one per slot, so the
+        // set of concurrently running work-groups doesn't depend on timing.
+        // Slots above `threads` never run and must not block the others.
+        for (size_t slot = 0; slot < config.threads; ++slot) {
+            clocks[slot].value = slot < threads ? 0 : kFinishedClock;
+        }
+
+        for (size_t slot = 0; slot < threads; ++slot) {
+            pool.emplace_back([&, slot]() {
+                for (size_t batch = 0; batch * threads < work_groups;
+                     ++batch) {
+                    const size_t id = batch * threads + slot;
+                    if (id < work_groups) {
+                        WorkGroupContext context(this, id, slot);
+                        run_work_group(context, wavefronts_per_group, step);
+                    }
+                    clocks[slot].value.store(kFinishedClock,
+                                             std::memory_order_release);
+
+                    barrier.arrive_and_wait([&]() {
+                        for (size_t i = 0; i < threads; ++i) {
+                            clocks[i].value = 0;
+                        }
+                    });
+                }
+            });
+        }
+    }
+
+    for (auto& thread : pool) {
+        thread.join();
+    }
+}
+
+void Scheduler::run_work_group(WorkGroupContext& context,
+                               size_t wavefronts,
+                               const WavefrontStep& step) {
+    std::vector<WavefrontStatus> status(wavefronts, WF_RUNNING);
+    std::vector<size_t> runnable;
+    uint64_t random_state =
+        config.seed ^ (context.get_work_group_id() * 0xD1B54A32D192ED03ull);
+    size_t next = 0;
+
+    while (true) {
+        runnable.clear();
+        size_t at_barrier = 0;
+        for (size_t wf = 0; wf < wavefronts; ++wf) {
+            if (status[wf] == WF_RUNNING) {
+                runnable.push_back(wf);
+            } else if (status[wf] == WF_BARRIER) {
+                at_barrier++;
+            }
+        }
+
+        if (runnable.empty()) {
+            if (at_barrier == 0) {
+                break;
+            }
+            // every unfinished wavefront reached the barrier
+            for (auto& wf_status : status) {
+                if (wf_status == WF_BARRIER) {
+                    wf_status = WF_RUNNING;
+                }
+            }
+            continue;
+        }
+
+        size_t wf;
+        uint32_t quantum;
+        if (config.deterministic) {
+            const uint64_t random = split_mix(random_state);
+            wf = runnable[random % runnable.size()];
+            quantum = 1 + (random >> 32) % config.max_quantum;
+        } else {
+            wf = runnable[next++ % runnable.size()];
+            quantum = config.max_quantum;
+        }
+
+        for (uint32_t i = 0; i < quantum && status[wf] == WF_RUNNING; ++i) {
+            status[wf] = step(context, wf);
+            if (config.deterministic) {
+                tick(context);
+            }
+        }
+    }
+}
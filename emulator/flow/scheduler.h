@@ -5,4 +5,109 @@
 #ifndef RED_O_LATOR_SCHEDULER_H
 #define RED_O_LATOR_SCHEDULER_H
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+enum WavefrontStatus { WF_RUNNING, WF_BARRIER, WF_FINISHED };
+
+struct SchedulerConfig {
+    size_t threads = std::max(std::thread::hardware_concurrency(), 1u);
+    /**
+     * Deterministic mode: the interleaving of wavefronts inside a work-group
+     * is derived from the seed and cross-work-group atomics are committed in
+     * logical-time order, so a run is reproducible for the same seed and
+     * thread count.
+     */
+    bool deterministic = false;
+    uint64_t seed = 0;
+    // max instructions a wavefront runs before the scheduler switches away
+    uint32_t max_quantum = 16;
+};
+
+class Scheduler;
+
+class WorkGroupContext {
+   public:
+    size_t get_work_group_id() const {
+        return work_group_id;
+    }
+
+    /**
+     * Runs op as an atomic visible to other work-groups. Ops of all
+     * work-groups are serialized; in deterministic mode their order depends
+     * only on the seed and the kernel, not on thread timing.
+     */
+    template <typename F>
+    auto atomic(F&& op) {
+        struct Turn {
+            WorkGroupContext* context;
+            explicit Turn(WorkGroupContext* context) : context(context) {
+                context->acquire_turn();
+            }
+            ~Turn() {
+                context->release_turn();
+            }
+        } turn(this);
+        return op();
+    }
+
+   private:
+    friend class Scheduler;
+
+    Scheduler* scheduler;
+    size_t work_group_id;
+    size_t slot;
+    uint64_t clock = 0;
+
+    WorkGroupContext(Scheduler* scheduler, size_t work_group_id, size_t slot)
+        : scheduler(scheduler), work_group_id(work_group_id), slot(slot) {}
+
+    void acquire_turn();
+    void release_turn();
+};
+
+/**
+ * Executes a single instruction of the wavefront with the given index
+ * inside its work-group.
+ */
+using WavefrontStep =
+    std::function<WavefrontStatus(WorkGroupContext&, size_t wavefront)>;
+
+/**
+ * Runs work-groups in parallel on a pool of host threads. Wavefronts of one
+ * work-group always run on the same thread, interleaved by the scheduler.
+ */
+class Scheduler {
+   public:
+    explicit Scheduler(const SchedulerConfig& config = SchedulerConfig());
+
+    void run(size_t work_groups,
+             size_t wavefronts_per_group,
+             const WavefrontStep& step);
+
+   private:
+    friend class WorkGroupContext;
+
+    struct alignas(64) LogicalClock {
+        std::atomic<uint64_t> value{0};
+    };
+
+    SchedulerConfig config;
+    std::mutex atomic_mutex;
+    // logical clock of the work-group running in every thread slot,
+    // only used in deterministic mode
+    std::unique_ptr<LogicalClock[]> clocks;
+
+    void run_work_group(WorkGroupContext& context,
+                        size_t wavefronts,
+                        const WavefrontStep& step);
+    void tick(WorkGroupContext& context);
+};
+
 #endif  // RED_O_LATOR_SCHEDULER_H
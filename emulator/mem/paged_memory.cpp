@@ -0,0 +1,82 @@
+//
+// Created by Diana Kudaiberdieva
+//
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include "paged_memory.h"
+
+PagedMemory::PagedMemory(size_t size)
+    : size(size),
+      chunks((size + PAGE_SIZE * PAGES_PER_CHUNK - 1) /
+             (PAGE_SIZE * PAGES_PER_CHUNK)) {}
+
+void PagedMemory::read(uint64_t address,
+                       void* destination,
+                       size_t count) const {
+    assert(address + count <= size && "Memory read out of bounds");
+
+    auto* out = static_cast<std::byte*>(destination);
+    while (count > 0) {
+        const size_t page = address / PAGE_SIZE;
+        const size_t offset = address % PAGE_SIZE;
+        const size_t n = std::min(count, PAGE_SIZE - offset);
+
+        const auto& chunk = chunks[page / PAGES_PER_CHUNK];
+        const Page* data =
+            chunk ? chunk->pages[page % PAGES_PER_CHUNK].get() : nullptr;
+        if (data) {
+            std::memcpy(out, data->data.data() + offset, n);
+        } else {
+            std::memset(out, 0, n);
+        }
+
+        out += n;
+        address += n;
+        count -= n;
+    }
+}
+
+void PagedMemory::write(uint64_t address, const void* source, size_t count) {
+    assert(address + count <= size && "Memory write out of bounds");
+
+    const auto* in = static_cast<const std::byte*>(source);
+    while (count > 0) {
+        const size_t page = address / PAGE_SIZE;
+        const size_t offset = address % PAGE_SIZE;
+        const size_t n = std::min(count, PAGE_SIZE - offset);
+
+        std::memcpy(writable_page(page).data.data() + offset, in, n);
+
+        in += n;
+        address += n;
+        count -= n;
+    }
+}
+
+PagedMemory::Page& PagedMemory::writable_page(size_t page) {
+    auto& chunk = chunks[page / PAGES_PER_CHUNK];
+    if (!chunk) {
+        chunk = std::make_shared<Chunk>();
+    } else if (chunk.use_count() > 1) {
+        chunk = std::make_shared<Chunk>(*chunk);
+    }
+
+    auto& data = chunk->pages[page % PAGES_PER_CHUNK];
+    if (!data) {
+        data = std::make_shared<Page>();
+    } else if (data.use_count() > 1) {
+        data = std::make_shared<Page>(*data);
+    }
+
+    dirty_pages.insert(page);
+    return *data;
+}
+
+PagedMemory PagedMemory::snapshot() {
+    dirty_pages.clear();
+    PagedMemory copy(*this);
+    return copy;
+}
@@ -0,0 +1,68 @@
+//
+// Created by Diana Kudaiberdieva
+//
+
+#ifndef RED_O_LATOR_PAGED_MEMORY_H
+#define RED_O_LATOR_PAGED_MEMORY_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * Byte-addressable memory (global buffer or LDS) stored as reference-counted
+ * pages. Copies share all pages and clone a page only when one of them
+ * writes to it, so a snapshot costs O(size / CHUNK_SIZE) and the memory it
+ * keeps alive is proportional to the pages dirtied afterwards.
+ * Untouched pages are not allocated and read as zeros.
+ *
+ * Not thread-safe: concurrent writes must go to different instances.
+ */
+class PagedMemory {
+   public:
+    static constexpr size_t PAGE_SIZE = 4096;
+    static constexpr size_t PAGES_PER_CHUNK = 512;
+
+    explicit PagedMemory(size_t size = 0);
+
+    size_t get_size() const {
+        return size;
+    }
+
+    void read(uint64_t address, void* destination, size_t count) const;
+
+    void write(uint64_t address, const void* source, size_t count);
+
+    /**
+     * @return copy sharing every page with this memory; resets the set of
+     * dirty pages
+     */
+    PagedMemory snapshot();
+
+    /**
+     * @return indices of pages written since the last snapshot
+     */
+    const std::unordered_set<size_t>& get_dirty_pages() const {
+        return dirty_pages;
+    }
+
+   private:
+    struct Page {
+        std::array<std::byte, PAGE_SIZE> data{};
+    };
+
+    struct Chunk {
+        std::array<std::shared_ptr<Page>, PAGES_PER_CHUNK> pages;
+    };
+
+    size_t size;
+    std::vector<std::shared_ptr<Chunk>> chunks;
+    std::unordered_set<size_t> dirty_pages;
+
+    Page& writable_page(size_t page);
+};
+
+#endif  // RED_O_LATOR_PAGED_MEMORY_H
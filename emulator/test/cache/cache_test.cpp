@@ -0,0 +1,117 @@
+//
+// Created by Diana Kudaiberdieva
+//
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <common/test/doctest.h>
+#include <thread>
+#include <vector>
+#include "cache/cache_simulator.h"
+
+TEST_CASE("Cache - set-associative lookup") {
+    SUBCASE("hits after the first access to a line") {
+        Cache cache({1024, 4, 64});
+        CHECK(cache.get_config().sets() == 4);
+        CHECK_FALSE(cache.access(0x100));
+        CHECK(cache.access(0x100));
+        CHECK(cache.access(0x13f));
+        CHECK_FALSE(cache.access(0x140));
+        CHECK(cache.get_stats().hits == 2);
+        CHECK(cache.get_stats().misses == 2);
+    }
+
+    SUBCASE("LRU evicts the least recently used line of a set") {
+        Cache cache({256, 2, 64});
+        // set stride is 2 lines
+        cache.access(0x000);
+        cache.access(0x080);
+        cache.access(0x000);
+        cache.access(0x100);
+        CHECK(cache.access(0x000));
+        CHECK_FALSE(cache.access(0x080));
+    }
+
+    SUBCASE("FIFO evicts the oldest line regardless of hits") {
+        Cache cache({256, 2, 64, FIFO_REPLACEMENT});
+        cache.access(0x000);
+        cache.access(0x080);
+        cache.access(0x000);
+        cache.access(0x100);
+        CHECK_FALSE(cache.access(0x000));
+    }
+
+    SUBCASE("write-through cache doesn't allocate on write miss") {
+        Cache cache({256, 2, 64, LRU_REPLACEMENT, false});
+        CHECK_FALSE(cache.access(0x000, true));
+        CHECK_FALSE(cache.access(0x000));
+        CHECK(cache.access(0x000, true));
+    }
+
+    SUBCASE("rejects invalid geometry") {
+        CHECK_THROWS_AS(Cache({1000, 4, 64}), std::invalid_argument);
+        CHECK_THROWS_AS(Cache({1024, 4, 48}), std::invalid_argument);
+    }
+}
+
+TEST_CASE("CacheHierarchyConfig - reads vector L1 from device config") {
+    DeviceConfig device;
+    device.parameters["CL_DEVICE_MAX_COMPUTE_UNITS"] = "8";
+    device.parameters["CL_DEVICE_GLOBAL_MEM_CACHE_SIZE"] = "32768";
+    device.parameters["CL_DEVICE_GLOBAL_MEM_CACHELINE_SIZE"] = "128";
+
+    const auto config = CacheHierarchyConfig::from_device_config(device);
+    CHECK(config.compute_units == 8);
+    CHECK(config.vector_l1.size == 32768);
+    CHECK(config.vector_l1.line_size == 128);
+    CHECK(config.l1i.line_size == 128);
+    CHECK(config.l1i.size == 32 * 1024);
+}
+
+TEST_CASE("CacheSimulator - collects hit rates per kernel and pc") {
+    CacheHierarchyConfig config;
+    config.compute_units = 4;
+    CacheSimulator simulator(config);
+
+    const auto fetch_kernel = simulator.register_kernel("fetch");
+    const auto load_kernel = simulator.register_kernel("load");
+
+    SUBCASE("instruction fetches from several threads") {
+        std::vector<std::thread> threads;
+        for (uint16_t cu = 0; cu < 4; ++cu) {
+            threads.emplace_back([&simulator, fetch_kernel, cu]() {
+                for (uint64_t pc = 0; pc < 1024; pc += 4) {
+                    simulator.record(
+                        {pc, pc, fetch_kernel, cu, 4, INSTR_FETCH});
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        const auto stats = simulator.get_kernel_stats(fetch_kernel);
+        // all 4 CUs share one L1I, 16 lines are missed once in total
+        CHECK(stats.levels[L1I_CACHE].accesses() == 4 * 256);
+        CHECK(stats.levels[L1I_CACHE].misses == 16);
+        CHECK(stats.levels[L2_CACHE].accesses() == 16);
+        CHECK(stats.pcs.size() == 256);
+    }
+
+    SUBCASE("vector loads spanning two lines") {
+        simulator.record({60, 0x10, load_kernel, 0, 8, VECTOR_LOAD});
+        simulator.record({60, 0x10, load_kernel, 0, 8, VECTOR_LOAD});
+        simulator.record({60, 0x20, load_kernel, 1, 8, VECTOR_STORE});
+
+        const auto stats = simulator.get_kernel_stats(load_kernel);
+        CHECK(stats.levels[VECTOR_L1_CACHE].accesses() == 6);
+        CHECK(stats.levels[VECTOR_L1_CACHE].misses == 4);
+        CHECK(stats.levels[L2_CACHE].misses == 2);
+        CHECK(stats.pcs.at(0x10).hits == 1);
+        CHECK(stats.pcs.at(0x20).misses == 1);
+
+        const auto report = simulator.report();
+        CHECK(report.find("Kernel load") != std::string::npos);
+        CHECK(report.find("pc 0x10") != std::string::npos);
+    }
+}
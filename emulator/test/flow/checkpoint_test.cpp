@@ -0,0 +1,99 @@
+//
+// Created by Diana Kudaiberdieva
+//
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <common/test/doctest.h>
+#include "flow/checkpoint.h"
+
+uint32_t read_u32(const PagedMemory& memory, uint64_t address) {
+    uint32_t value;
+    memory.read(address, &value, sizeof(value));
+    return value;
+}
+
+void write_u32(PagedMemory& memory, uint64_t address, uint32_t value) {
+    memory.write(address, &value, sizeof(value));
+}
+
+TEST_CASE("PagedMemory - copy-on-write pages") {
+    PagedMemory memory(1 << 20);
+
+    SUBCASE("untouched memory reads as zeros") {
+        CHECK(read_u32(memory, 0x1234) == 0);
+        CHECK(memory.get_dirty_pages().empty());
+    }
+
+    SUBCASE("writes crossing page boundary") {
+        uint64_t value = 0x1122334455667788;
+        memory.write(PagedMemory::PAGE_SIZE - 4, &value, sizeof(value));
+        uint64_t result;
+        memory.read(PagedMemory::PAGE_SIZE - 4, &result, sizeof(result));
+        CHECK(result == value);
+        CHECK(memory.get_dirty_pages().size() == 2);
+    }
+
+    SUBCASE("snapshot is not affected by later writes") {
+        write_u32(memory, 0x10, 1);
+        auto snapshot = memory.snapshot();
+        CHECK(memory.get_dirty_pages().empty());
+
+        write_u32(memory, 0x10, 2);
+        write_u32(memory, 0x80000, 3);
+        CHECK(read_u32(memory, 0x10) == 2);
+        CHECK(read_u32(snapshot, 0x10) == 1);
+        CHECK(read_u32(snapshot, 0x80000) == 0);
+        CHECK(memory.get_dirty_pages().size() == 2);
+
+        write_u32(snapshot, 0x20, 4);
+        CHECK(read_u32(memory, 0x20) == 0);
+    }
+}
+
+TEST_CASE("CheckpointHistory - restores dispatch state") {
+    DispatchState state;
+    state.wavefronts.emplace_back();
+    state.lds = PagedMemory(64 * 1024);
+    state.buffers.emplace_back(1 << 16);
+
+    CheckpointHistory history;
+    for (uint64_t step = 0; step < 10; ++step) {
+        if (step % 3 == 0) {
+            history.save(step, state);
+        }
+        state.wavefronts[0].PC = step * 4;
+        state.wavefronts[0].S_REG_FILE[0] = step;
+        write_u32(state.lds, 0, step);
+        write_u32(state.buffers[0], 0x100, step * 10);
+    }
+    CHECK(history.size() == 4);
+
+    SUBCASE("restores the closest earlier checkpoint") {
+        CHECK(history.restore(5, state) == 3);
+        CHECK(state.wavefronts[0].PC == 8);
+        CHECK(state.wavefronts[0].S_REG_FILE[0] == 2);
+        CHECK(read_u32(state.lds, 0) == 2);
+        CHECK(read_u32(state.buffers[0], 0x100) == 20);
+
+        write_u32(state.buffers[0], 0x100, 100);
+        CHECK(history.restore(3, state) == 3);
+        CHECK(read_u32(state.buffers[0], 0x100) == 20);
+    }
+
+    SUBCASE("discards recorded future") {
+        history.discard_after(4);
+        CHECK(history.size() == 2);
+        CHECK(history.restore(100, state) == 3);
+    }
+
+    SUBCASE("keeps sparse history when full") {
+        CheckpointHistory small(4);
+        for (uint64_t step = 0; step < 20; ++step) {
+            small.save(step, state);
+        }
+        CHECK(small.size() <= 4);
+        CHECK(small.restore(19, state) == 19);
+        CHECK(small.restore(0, state) == 0);
+    }
+}
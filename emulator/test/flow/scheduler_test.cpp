@@ -0,0 +1,91 @@
+//
+// Created by Diana Kudaiberdieva
+//
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <common/test/doctest.h>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include "flow/scheduler.h"
+
+// Every wavefront runs `length` instructions, every third one is an atomic
+// appending (work-group, wavefront) to the shared log.
+std::vector<uint64_t> run_logged(const SchedulerConfig& config,
+                                 size_t work_groups,
+                                 size_t wavefronts,
+                                 uint32_t length) {
+    std::vector<uint64_t> log;
+    std::vector<std::vector<uint32_t>> pc(work_groups,
+                                          std::vector<uint32_t>(wavefronts));
+
+    Scheduler scheduler(config);
+    scheduler.run(work_groups, wavefronts,
+                  [&](WorkGroupContext& context, size_t wf) {
+                      const auto wg = context.get_work_group_id();
+                      auto& wf_pc = pc[wg][wf];
+                      if (wf_pc % 3 == 0) {
+                          context.atomic(
+                              [&]() { log.push_back(wg << 32 | wf); });
+                      }
+                      return ++wf_pc == length ? WF_FINISHED : WF_RUNNING;
+                  });
+    return log;
+}
+
+TEST_CASE("Scheduler - runs every wavefront to completion") {
+    for (bool deterministic : {false, true}) {
+        SchedulerConfig config;
+        config.threads = 4;
+        config.deterministic = deterministic;
+
+        std::atomic<size_t> steps{0};
+        Scheduler scheduler(config);
+        scheduler.run(10, 4, [&](WorkGroupContext&, size_t) {
+            return ++steps % 5 == 0 ? WF_FINISHED : WF_RUNNING;
+        });
+        CHECK(steps >= 10 * 4);
+        CHECK(run_logged(config, 10, 4, 30).size() == 10 * 4 * 10);
+    }
+}
+
+TEST_CASE("Scheduler - wavefronts wait for each other on barrier") {
+    SchedulerConfig config;
+    config.threads = 2;
+    config.deterministic = true;
+
+    std::mutex mutex;
+    std::vector<std::vector<int>> phases(2);
+    bool ordered = true;
+
+    Scheduler scheduler(config);
+    scheduler.run(2, 4, [&](WorkGroupContext& context, size_t wf) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto& group_phases = phases[context.get_work_group_id()];
+        group_phases.resize(4);
+        const int phase = group_phases[wf]++;
+        for (auto other : group_phases) {
+            ordered = ordered && (phase == 0 || other >= phase);
+        }
+        return phase == 0 ? WF_BARRIER : WF_FINISHED;
+    });
+    CHECK(ordered);
+}
+
+TEST_CASE("Scheduler - deterministic mode is reproducible") {
+    SchedulerConfig config;
+    config.threads = 4;
+    config.deterministic = true;
+    config.seed = 42;
+
+    const auto expected = run_logged(config, 13, 4, 50);
+    for (int run = 0; run < 5; ++run) {
+        CHECK(run_logged(config, 13, 4, 50) == expected);
+    }
+
+    SUBCASE("another seed gives another interleaving") {
+        config.seed = 43;
+        CHECK(run_logged(config, 13, 4, 50) != expected);
+    }
+}
@@ -0,0 +1,105 @@
+//
+// Created by Diana Kudaiberdieva
+//
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <common/test/doctest.h>
+#include "timing/timing_model.h"
+
+TimingConfig single_simd_config() {
+    TimingConfig config;
+    config.compute_units = 1;
+    config.simd_per_cu = 1;
+    return config;
+}
+
+TEST_CASE("get_timing_unit - maps instruction formats to units") {
+    CHECK(get_timing_unit(S_ABS_I32) == SALU_UNIT);
+    CHECK(get_timing_unit(S_WAITCNT) == BRANCH_UNIT);
+    CHECK(get_timing_unit(S_LOAD_DWORD) == SMEM_UNIT);
+    CHECK(get_timing_unit(V_MOV_B32) == VALU_UNIT);
+    CHECK(get_timing_unit(FLAT_STORE_DWORD) == VMEM_UNIT);
+}
+
+TEST_CASE("TimingConfig - reads hardware parameters from device config") {
+    DeviceConfig device;
+    device.parameters["CL_DEVICE_MAX_CLOCK_FREQUENCY"] = "1000";
+    device.parameters["CL_DEVICE_MAX_COMPUTE_UNITS"] = "8";
+    device.parameters["CL_DEVICE_SIMD_WIDTH_AMD"] = "32";
+    device.parameters["CL_DEVICE_WAVEFRONT_WIDTH_AMD"] = "abc";
+
+    const auto config = TimingConfig::from_device_config(device);
+    CHECK(config.clock_mhz == 1000);
+    CHECK(config.compute_units == 8);
+    CHECK(config.simd_per_cu == 4);
+    CHECK(config.wavefront_width == 64);
+    CHECK(config.valu_cadence() == 2);
+    CHECK(config.units[VALU_UNIT].issue_cycles == 2);
+}
+
+TEST_CASE("TimingModel - predicts kernel duration") {
+    SUBCASE("VALU instructions follow the 4-cycle cadence") {
+        TimingModel model(single_simd_config());
+        auto wf = model.begin_wavefront();
+        for (int i = 0; i < 10; ++i) {
+            model.issue(wf, V_ADD_U32);
+        }
+        model.end_wavefront(wf);
+
+        const auto report = model.report();
+        CHECK(report.cycles == 40);
+        CHECK(report.instructions == 10);
+        CHECK(report.bottleneck == VALU_UNIT);
+        CHECK(report.predicted_time_us == doctest::Approx(40.0 / 1256));
+    }
+
+    SUBCASE("memory latency is exposed on s_waitcnt") {
+        TimingModel model(single_simd_config());
+        auto wf = model.begin_wavefront();
+        model.issue(wf, FLAT_STORE_DWORD);
+        model.issue(wf, V_ADD_U32);
+        model.issue(wf, S_WAITCNT);
+        model.end_wavefront(wf);
+
+        const auto report = model.report();
+        CHECK(report.cycles == 400 + 4);
+        CHECK(report.bottleneck == VMEM_UNIT);
+    }
+
+    SUBCASE("wavefronts on different SIMDs run in parallel") {
+        TimingConfig config;
+        config.compute_units = 1;
+        TimingModel model(config);
+        for (int i = 0; i < 4; ++i) {
+            auto wf = model.begin_wavefront();
+            model.issue(wf, V_MOV_B32);
+            model.end_wavefront(wf);
+        }
+        CHECK(model.report().cycles == 4);
+        CHECK(model.report().wavefronts == 4);
+    }
+
+    SUBCASE("wavefronts on the same SIMD share its VALU") {
+        TimingModel model(single_simd_config());
+        for (int i = 0; i < 4; ++i) {
+            auto wf = model.begin_wavefront();
+            model.issue(wf, V_MOV_B32);
+            model.end_wavefront(wf);
+        }
+        CHECK(model.report().cycles == 16);
+    }
+
+    SUBCASE("scalar unit is shared by the SIMDs of a compute unit") {
+        TimingConfig config;
+        config.compute_units = 1;
+        TimingModel model(config);
+        for (int i = 0; i < 4; ++i) {
+            auto wf = model.begin_wavefront();
+            model.issue(wf, S_ABS_I32);
+            model.end_wavefront(wf);
+        }
+        CHECK(model.report().cycles == 4);
+        CHECK(model.report().bottleneck == SALU_UNIT);
+    }
+}
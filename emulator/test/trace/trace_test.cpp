@@ -0,0 +1,110 @@
+//
+// Created by Diana Kudaiberdieva
+//
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <common/test/doctest.h>
+#include <cstdio>
+#include <fstream>
+#include "trace/trace_reader.h"
+#include "trace/trace_writer.h"
+
+static const std::string kTracePath = "red-o-lator-trace-test.bin";
+
+TEST_CASE("varint and zigzag encoding") {
+    for (int64_t value : {0ll, 1ll, -1ll, 63ll, -64ll, 1ll << 40, -(1ll << 62)}) {
+        CHECK(unzigzag(zigzag(value)) == value);
+    }
+    std::vector<uint8_t> out;
+    put_varint(out, 300);
+    CHECK(out == std::vector<uint8_t>{0xac, 0x02});
+}
+
+void check_round_trip(size_t block_size) {
+    {
+        TraceWriter writer(kTracePath, TRACE_NO_COMPRESSION, block_size);
+        writer.begin_wavefront(0);
+        writer.begin_wavefront(1);
+        for (uint64_t i = 0; i < 100; ++i) {
+            writer.instruction(i % 2, 0x100 + i * 4, i < 50 ? ~0ull : 0xff);
+            if (i % 10 == 0) {
+                std::vector<uint64_t> addresses;
+                for (uint64_t lane = 0; lane < 4; ++lane) {
+                    addresses.push_back(0x10000 + i * 64 + lane * 4);
+                }
+                writer.memory(i % 2, addresses.data(), addresses.size());
+            }
+        }
+        writer.end_wavefront(0);
+        writer.end_wavefront(1);
+    }
+
+    TraceReader reader(kTracePath);
+    TraceEvent event;
+    size_t instructions = 0, exec_changes = 0, memory_ops = 0;
+    bool consistent = true;
+
+    while (reader.next(event)) {
+        if (event.type == TRACE_INSTR) {
+            const uint64_t i = instructions++;
+            consistent = consistent && event.wavefront == i % 2 &&
+                         event.pc == 0x100 + i * 4 &&
+                         event.exec == (i < 50 ? ~0ull : 0xff);
+        } else if (event.type == TRACE_EXEC) {
+            exec_changes++;
+        } else if (event.type == TRACE_MEM) {
+            const uint64_t i = (instructions - 1);
+            consistent = consistent && event.addresses.size() == 4 &&
+                         event.addresses[0] == 0x10000 + i * 64 &&
+                         event.addresses[3] == 0x10000 + i * 64 + 12;
+            memory_ops++;
+        }
+    }
+
+    CHECK(consistent);
+    CHECK(instructions == 100);
+    CHECK(memory_ops == 10);
+    if (block_size > 1000) {
+        // EXEC is only stored when it changes
+        CHECK(exec_changes == 4);
+    }
+    std::remove(kTracePath.c_str());
+}
+
+TEST_CASE("TraceWriter and TraceReader - round trip") {
+    SUBCASE("single block") {
+        check_round_trip(1 << 20);
+    }
+    SUBCASE("many small blocks") {
+        check_round_trip(64);
+    }
+}
+
+TEST_CASE("TraceReader - rejects empty memory records") {
+    {
+        std::ofstream file(kTracePath, std::ios::binary);
+        file.write(kTraceMagic, sizeof(kTraceMagic));
+        const uint8_t data[] = {
+            kTraceVersion, 0, 0, 0,
+            // raw and stored size of the block
+            3, 0, 0, 0, 3, 0, 0, 0, TRACE_NO_COMPRESSION,
+            // memory record of wavefront 0 with no addresses
+            TRACE_MEM, 0, 0,
+        };
+        file.write(reinterpret_cast<const char*>(data), sizeof(data));
+    }
+    TraceReader reader(kTracePath);
+    TraceEvent event;
+    CHECK_THROWS_AS(reader.next(event), TraceFormatError);
+    std::remove(kTracePath.c_str());
+}
+
+TEST_CASE("TraceReader - rejects foreign files") {
+    {
+        std::ofstream file(kTracePath);
+        file << "not a trace";
+    }
+    CHECK_THROWS_AS(TraceReader reader(kTracePath), TraceFormatError);
+    std::remove(kTracePath.c_str());
+}
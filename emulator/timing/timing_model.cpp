@@ -0,0 +1,173 @@
+//
+// Created by Diana Kudaiberdieva
+//
+
+#include <algorithm>
+#include <sstream>
+
+#include "timing_model.h"
+
+char const* get_timing_unit_str(TimingUnit unit) noexcept {
+    switch (unit) {
+        case SALU_UNIT: return "SALU";
+        case VALU_UNIT: return "VALU";
+        case SMEM_UNIT: return "SMEM";
+        case VMEM_UNIT: return "VMEM";
+        case LDS_UNIT: return "LDS";
+        case BRANCH_UNIT: return "BRANCH";
+        default: return "UNKNOWN";
+    }
+}
+
+TimingUnit get_timing_unit(InstrKey instr) {
+    switch (get_instr_format(instr)) {
+        case SOP1_FORMAT:
+        case SOP2_FORMAT:
+        case SOPK_FORMAT:
+        case SOPC: return SALU_UNIT;
+        case SOPP: return BRANCH_UNIT;
+        case SMEM: return SMEM_UNIT;
+        case VOP1:
+        case VOP2:
+        case VOPC:
+        case VINTRP:
+        case VOP3A:
+        case VOP3B:
+        case VOP3P: return VALU_UNIT;
+        case FLAT: return VMEM_UNIT;
+    }
+    assert(false && "Unsupported instruction format");
+    return SALU_UNIT;
+}
+
+static bool is_memory_unit(TimingUnit unit) {
+    return unit == SMEM_UNIT || unit == VMEM_UNIT || unit == LDS_UNIT;
+}
+
+static bool is_cu_shared_unit(TimingUnit unit) {
+    return unit == SALU_UNIT || unit == SMEM_UNIT || unit == BRANCH_UNIT;
+}
+
+TimingConfig TimingConfig::from_device_config(const DeviceConfig& device) {
+    TimingConfig config;
+    config.clock_mhz = device.get_uint("CL_DEVICE_MAX_CLOCK_FREQUENCY",
+                                       config.clock_mhz);
+    config.compute_units = device.get_uint("CL_DEVICE_MAX_COMPUTE_UNITS",
+                                           config.compute_units);
+    config.simd_per_cu = device.get_uint("CL_DEVICE_SIMD_PER_COMPUTE_UNIT_AMD",
+                                         config.simd_per_cu);
+    config.simd_width =
+        device.get_uint("CL_DEVICE_SIMD_WIDTH_AMD", config.simd_width);
+    config.wavefront_width =
+        device.get_uint("CL_DEVICE_WAVEFRONT_WIDTH_AMD", config.wavefront_width);
+
+    config.units[VALU_UNIT].issue_cycles = config.valu_cadence();
+    config.units[VALU_UNIT].latency = config.valu_cadence();
+    config.units[VMEM_UNIT].issue_cycles = config.valu_cadence();
+    return config;
+}
+
+TimingModel::TimingModel(const TimingConfig& config)
+    : config(config),
+      simds(std::max(config.compute_units * config.simd_per_cu, 1u)),
+      cu_unit_free(std::max(config.compute_units, 1u)) {}
+
+size_t TimingModel::begin_wavefront() {
+    WavefrontClock wf;
+    wf.simd = wavefronts.size() % simds.size();
+    wavefronts.push_back(wf);
+    return wavefronts.size() - 1;
+}
+
+uint64_t& TimingModel::unit_free(const WavefrontClock& wf, TimingUnit unit) {
+    if (is_cu_shared_unit(unit)) {
+        return cu_unit_free[wf.simd / config.simd_per_cu][unit];
+    }
+    return simds[wf.simd].unit_free[unit];
+}
+
+void TimingModel::issue(size_t wavefront, InstrKey instr) {
+    if (instr == S_WAITCNT || instr == S_ENDPGM) {
+        wait(wavefront);
+    }
+    issue(wavefront, get_timing_unit(instr));
+}
+
+void TimingModel::issue(size_t wavefront, TimingUnit unit) {
+    assert(wavefront < wavefronts.size() && "Unknown wavefront");
+
+    auto& wf = wavefronts[wavefront];
+    auto& free = unit_free(wf, unit);
+    const auto& timing = config.units[unit];
+
+    const uint64_t start = std::max(wf.clock, free);
+    free = start + timing.issue_cycles;
+    unit_cycles[unit] += timing.issue_cycles;
+    instructions++;
+
+    if (is_memory_unit(unit)) {
+        // results arrive asynchronously, the wavefront keeps issuing
+        wf.clock = start + timing.issue_cycles;
+        const uint64_t ready = start + timing.latency;
+        if (ready > wf.mem_ready) {
+            wf.mem_ready = ready;
+            wf.mem_unit = unit;
+        }
+    } else {
+        // in-order issue: assume the next instruction depends on this one
+        wf.clock = start + std::max(timing.issue_cycles, timing.latency);
+    }
+}
+
+void TimingModel::wait(size_t wavefront) {
+    assert(wavefront < wavefronts.size() && "Unknown wavefront");
+
+    auto& wf = wavefronts[wavefront];
+    if (wf.mem_ready > wf.clock) {
+        unit_cycles[wf.mem_unit] += wf.mem_ready - wf.clock;
+        wf.clock = wf.mem_ready;
+    }
+}
+
+void TimingModel::end_wavefront(size_t wavefront) {
+    wait(wavefront);
+
+    const auto& wf = wavefronts[wavefront];
+    auto& simd = simds[wf.simd];
+    simd.clock = std::max(simd.clock, wf.clock);
+}
+
+TimingReport TimingModel::report() const {
+    TimingReport report;
+
+    for (const auto& simd : simds) {
+        report.cycles = std::max(report.cycles, simd.clock);
+    }
+    for (const auto& wf : wavefronts) {
+        report.cycles = std::max({report.cycles, wf.clock, wf.mem_ready});
+    }
+
+    report.predicted_time_us =
+        static_cast<double>(report.cycles) / config.clock_mhz;
+    report.instructions = instructions;
+    report.wavefronts = wavefronts.size();
+    report.unit_cycles = unit_cycles;
+    report.bottleneck = static_cast<TimingUnit>(
+        std::max_element(unit_cycles.begin(), unit_cycles.end()) -
+        unit_cycles.begin());
+
+    return report;
+}
+
+std::string TimingReport::to_string() const {
+    std::stringstream out;
+    out << "Predicted kernel time: " << predicted_time_us << " us (" << cycles
+        << " cycles, " << wavefronts << " wavefronts, " << instructions
+        << " instructions)\n";
+    out << "Bottleneck: " << get_timing_unit_str(bottleneck) << "\n";
+    for (int unit = 0; unit < TIMING_UNIT_COUNT; ++unit) {
+        out << "  " << get_timing_unit_str(static_cast<TimingUnit>(unit))
+            << ": " << unit_cycles[unit] << " cycles\n";
+    }
+    return out.str();
+}
@@ -0,0 +1,143 @@
+//
+// Created by Diana Kudaiberdieva
+//
+
+#ifndef RED_O_LATOR_TIMING_MODEL_H
+#define RED_O_LATOR_TIMING_MODEL_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "instr/instr_info.h"
+#include "util/device_config.h"
+
+/**
+ * Execution resources an instruction can occupy. SALU and SMEM are shared by
+ * all SIMDs of a compute unit, the rest belong to a single SIMD.
+ */
+enum TimingUnit {
+    SALU_UNIT,
+    VALU_UNIT,
+    SMEM_UNIT,
+    VMEM_UNIT,
+    LDS_UNIT,
+    BRANCH_UNIT,
+    TIMING_UNIT_COUNT
+};
+
+char const* get_timing_unit_str(TimingUnit) noexcept;
+
+/**
+ * @return unit the instruction is issued to, derived from its InstrFormat
+ */
+TimingUnit get_timing_unit(InstrKey);
+
+struct UnitTiming {
+    // cycles the unit stays busy before it can accept the next instruction
+    uint32_t issue_cycles;
+    // cycles until the result is visible to the issuing wavefront
+    uint32_t latency;
+};
+
+struct TimingConfig {
+    uint32_t clock_mhz = 1256;
+    uint32_t compute_units = 32;
+    uint32_t simd_per_cu = 4;
+    uint32_t simd_width = 16;
+    uint32_t wavefront_width = 64;
+
+    // valu issue_cycles is recomputed from the widths, see valu_cadence()
+    std::array<UnitTiming, TIMING_UNIT_COUNT> units = {{
+        {1, 1},    // SALU
+        {4, 4},    // VALU
+        {1, 40},   // SMEM
+        {4, 400},  // VMEM
+        {2, 64},   // LDS
+        {1, 4},    // BRANCH
+    }};
+
+    /**
+     * Reads CL_DEVICE_MAX_CLOCK_FREQUENCY, CL_DEVICE_MAX_COMPUTE_UNITS,
+     * CL_DEVICE_SIMD_PER_COMPUTE_UNIT_AMD, CL_DEVICE_SIMD_WIDTH_AMD and
+     * CL_DEVICE_WAVEFRONT_WIDTH_AMD, keeping defaults for missing ones.
+     */
+    static TimingConfig from_device_config(const DeviceConfig& config);
+
+    /**
+     * @return cycles a SIMD needs to push one wavefront through its lanes,
+     * 4 for a 64-wide wavefront on SIMD16
+     */
+    uint32_t valu_cadence() const {
+        return (wavefront_width + simd_width - 1) / simd_width;
+    }
+};
+
+struct TimingReport {
+    uint64_t cycles = 0;
+    double predicted_time_us = 0;
+    TimingUnit bottleneck = VALU_UNIT;
+    uint64_t instructions = 0;
+    uint64_t wavefronts = 0;
+    // issue cycles for pipelined units plus stall cycles spent waiting
+    // on memory units, summed over all SIMDs
+    std::array<uint64_t, TIMING_UNIT_COUNT> unit_cycles{};
+
+    std::string to_string() const;
+};
+
+/**
+ * Cycle-approximate timing model fed by the functional emulator. Each
+ * executed instruction advances the virtual clock of the wavefront that
+ * issued it and the busy time of the unit it occupies; memory results
+ * arrive asynchronously and are only waited for on S_WAITCNT / S_ENDPGM.
+ * Wavefronts are distributed round-robin over all SIMDs of the device.
+ */
+class TimingModel {
+   public:
+    explicit TimingModel(const TimingConfig& config = TimingConfig());
+
+    /**
+     * @return handle of the new wavefront to pass to issue()
+     */
+    size_t begin_wavefront();
+
+    void issue(size_t wavefront, InstrKey instr);
+
+    void issue(size_t wavefront, TimingUnit unit);
+
+    /**
+     * Stalls the wavefront until all of its outstanding memory operations
+     * are complete.
+     */
+    void wait(size_t wavefront);
+
+    void end_wavefront(size_t wavefront);
+
+    TimingReport report() const;
+
+   private:
+    struct WavefrontClock {
+        size_t simd;
+        uint64_t clock = 0;
+        uint64_t mem_ready = 0;
+        TimingUnit mem_unit = VMEM_UNIT;
+    };
+
+    struct SimdClock {
+        uint64_t clock = 0;
+        std::array<uint64_t, TIMING_UNIT_COUNT> unit_free{};
+    };
+
+    TimingConfig config;
+    std::vector<SimdClock> simds;
+    // shared scalar units, one entry per compute unit
+    std::vector<std::array<uint64_t, TIMING_UNIT_COUNT>> cu_unit_free;
+    std::vector<WavefrontClock> wavefronts;
+    std::array<uint64_t, TIMING_UNIT_COUNT> unit_cycles{};
+    uint64_t instructions = 0;
+
+    uint64_t& unit_free(const WavefrontClock& wf, TimingUnit unit);
+};
+
+#endif  // RED_O_LATOR_TIMING_MODEL_H
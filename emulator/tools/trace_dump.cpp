@@ -0,0 +1,48 @@
+//
+// Created by Diana Kudaiberdieva
+//
+
+#include <iomanip>
+#include <iostream>
+
+#include "trace/trace_reader.h"
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        std::cerr << "Usage: " << argv[0] << " <trace file>" << std::endl;
+        return 1;
+    }
+
+    try {
+        TraceReader reader(argv[1]);
+        TraceEvent event;
+
+        std::cout << std::hex << std::setfill('0');
+        while (reader.next(event)) {
+            std::cout << "wf " << std::dec << event.wavefront << std::hex
+                      << ": ";
+            switch (event.type) {
+                case TRACE_WAVE_BEGIN: std::cout << "begin"; break;
+                case TRACE_WAVE_END: std::cout << "end"; break;
+                case TRACE_EXEC:
+                    std::cout << "exec 0x" << std::setw(16) << event.exec;
+                    break;
+                case TRACE_INSTR:
+                    std::cout << "pc 0x" << std::setw(8) << event.pc;
+                    break;
+                case TRACE_MEM:
+                    std::cout << "mem";
+                    for (auto address : event.addresses) {
+                        std::cout << " 0x" << address;
+                    }
+                    break;
+            }
+            std::cout << "\n";
+        }
+    } catch (const TraceFormatError& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
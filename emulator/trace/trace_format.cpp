@@ -0,0 +1,102 @@
+//
+// Created by Diana Kudaiberdieva
+//
+
+#include "trace_format.h"
+
+#ifdef RED_O_LATOR_HAS_ZSTD
+#include <zstd.h>
+#endif
+#ifdef RED_O_LATOR_HAS_LZ4
+#include <lz4.h>
+#endif
+
+bool is_trace_compression_supported(TraceCompression compression) {
+    switch (compression) {
+        case TRACE_NO_COMPRESSION: return true;
+#ifdef RED_O_LATOR_HAS_ZSTD
+        case TRACE_ZSTD: return true;
+#endif
+#ifdef RED_O_LATOR_HAS_LZ4
+        case TRACE_LZ4: return true;
+#endif
+        default: return false;
+    }
+}
+
+std::vector<uint8_t> compress_trace_block(TraceCompression compression,
+                                          const std::vector<uint8_t>& raw) {
+    std::vector<uint8_t> out;
+
+    switch (compression) {
+#ifdef RED_O_LATOR_HAS_ZSTD
+        case TRACE_ZSTD: {
+            out.resize(ZSTD_compressBound(raw.size()));
+            // level 1: tracing must keep up with the emulator
+            const size_t size =
+                ZSTD_compress(out.data(), out.size(), raw.data(), raw.size(), 1);
+            out.resize(ZSTD_isError(size) ? 0 : size);
+            break;
+        }
+#endif
+#ifdef RED_O_LATOR_HAS_LZ4
+        case TRACE_LZ4: {
+            out.resize(LZ4_compressBound(raw.size()));
+            const int size = LZ4_compress_default(
+                reinterpret_cast<const char*>(raw.data()),
+                reinterpret_cast<char*>(out.data()), raw.size(), out.size());
+            out.resize(size > 0 ? size : 0);
+            break;
+        }
+#endif
+        default: break;
+    }
+
+    if (out.size() >= raw.size()) {
+        out.clear();
+    }
+    return out;
+}
+
+std::vector<uint8_t> decompress_trace_block(TraceCompression compression,
+                                            const uint8_t* data,
+                                            size_t size,
+                                            size_t raw_size) {
+    std::vector<uint8_t> out;
+
+    switch (compression) {
+        case TRACE_NO_COMPRESSION:
+            if (size != raw_size) {
+                throw TraceFormatError("Corrupted trace block");
+            }
+            out.assign(data, data + size);
+            return out;
+#ifdef RED_O_LATOR_HAS_ZSTD
+        case TRACE_ZSTD: {
+            out.resize(raw_size);
+            const size_t result =
+                ZSTD_decompress(out.data(), out.size(), data, size);
+            if (ZSTD_isError(result) || result != raw_size) {
+                throw TraceFormatError("Corrupted zstd trace block");
+            }
+            return out;
+        }
+#endif
+#ifdef RED_O_LATOR_HAS_LZ4
+        case TRACE_LZ4: {
+            out.resize(raw_size);
+            const int result = LZ4_decompress_safe(
+                reinterpret_cast<const char*>(data),
+                reinterpret_cast<char*>(out.data()), size, raw_size);
+            if (result < 0 || static_cast<size_t>(result) != raw_size) {
+                throw TraceFormatError("Corrupted lz4 trace block");
+            }
+            return out;
+        }
+#endif
+        default:
+            throw TraceFormatError(
+                "Trace compression " + std::to_string(compression) +
+                " is not supported by this build");
+    }
+}
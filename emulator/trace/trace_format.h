@@ -0,0 +1,103 @@
+//
+// Created by Diana Kudaiberdieva
+//
+
+#ifndef RED_O_LATOR_TRACE_FORMAT_H
+#define RED_O_LATOR_TRACE_FORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/*
+ * Binary execution trace.
+ *
+ * File:   "RLTRACE\0" | u32 version | block*
+ * Block:  u32 raw size | u32 stored size | u8 TraceCompression | payload
+ *
+ * Decompressed payload is a sequence of records, each starting with a
+ * TraceRecord tag byte and a varint wavefront id:
+ *   WAVE_BEGIN, WAVE_END  -
+ *   INSTR                 zigzag varint PC delta from the wavefront's last PC
+ *   EXEC                  u64 mask, written only when it changes
+ *   MEM                   varint count, zigzag varint delta of the first
+ *                         address from the first address of the wavefront's
+ *                         previous MEM record, then zigzag varint deltas
+ *                         between consecutive addresses
+ *
+ * Delta state is reset at every block, so blocks decode independently.
+ * All integers are little-endian.
+ *
+ * Only trace-dump and the tests use the format so far: the emulator has no
+ * execution loop yet to create a TraceWriter per thread.
+ */
+
+static constexpr char kTraceMagic[8] = {'R', 'L', 'T', 'R',
+                                        'A', 'C', 'E', '\0'};
+static constexpr uint32_t kTraceVersion = 1;
+
+enum TraceCompression : uint8_t {
+    TRACE_NO_COMPRESSION = 0,
+    TRACE_ZSTD = 1,
+    TRACE_LZ4 = 2,
+};
+
+enum TraceRecord : uint8_t {
+    TRACE_WAVE_BEGIN = 0,
+    TRACE_INSTR = 1,
+    TRACE_EXEC = 2,
+    TRACE_MEM = 3,
+    TRACE_WAVE_END = 4,
+};
+
+class TraceFormatError : public std::runtime_error {
+   public:
+    explicit TraceFormatError(const std::string& message)
+        : runtime_error(message) {}
+};
+
+/**
+ * @return true if the emulator was built with support for the compression
+ */
+bool is_trace_compression_supported(TraceCompression compression);
+
+/**
+ * @return compressed data, or empty vector if compression didn't help
+ */
+std::vector<uint8_t> compress_trace_block(TraceCompression compression,
+                                          const std::vector<uint8_t>& raw);
+
+/**
+ * @throws TraceFormatError on corrupted data or unsupported compression
+ */
+std::vector<uint8_t> decompress_trace_block(TraceCompression compression,
+                                            const uint8_t* data,
+                                            size_t size,
+                                            size_t raw_size);
+
+static inline void put_varint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value) | 0x80);
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+static inline uint64_t zigzag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^
+           static_cast<uint64_t>(value >> 63);
+}
+
+static inline int64_t unzigzag(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+static inline void put_u64(std::vector<uint8_t>& out, uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        out.push_back(static_cast<uint8_t>(value >> (i * 8)));
+    }
+}
+
+#endif  // RED_O_LATOR_TRACE_FORMAT_H
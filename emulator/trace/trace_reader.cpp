@@ -0,0 +1,139 @@
+//
+// Created by Diana Kudaiberdieva
+//
+
+#include <cstring>
+
+#include "trace_reader.h"
+
+static bool read_u32(std::ifstream& file, uint32_t& value) {
+    uint8_t bytes[4];
+    if (!file.read(reinterpret_cast<char*>(bytes), sizeof(bytes))) {
+        return false;
+    }
+    value = 0;
+    for (int i = 0; i < 4; ++i) {
+        value |= static_cast<uint32_t>(bytes[i]) << (i * 8);
+    }
+    return true;
+}
+
+TraceReader::TraceReader(const std::string& path)
+    : file(path, std::ios::binary) {
+    if (!file.is_open()) {
+        throw TraceFormatError("Failed to open " + path);
+    }
+
+    char magic[sizeof(kTraceMagic)];
+    uint32_t version;
+    if (!file.read(magic, sizeof(magic)) ||
+        std::memcmp(magic, kTraceMagic, sizeof(magic)) != 0 ||
+        !read_u32(file, version)) {
+        throw TraceFormatError(path + " is not a trace file");
+    }
+    if (version != kTraceVersion) {
+        throw TraceFormatError("Unsupported trace version " +
+                               std::to_string(version));
+    }
+}
+
+bool TraceReader::read_block() {
+    uint32_t raw_size, stored_size;
+    if (!read_u32(file, raw_size)) {
+        return false;
+    }
+
+    const int compression = read_u32(file, stored_size) ? file.get() : EOF;
+    if (compression == EOF) {
+        throw TraceFormatError("Truncated trace block header");
+    }
+
+    std::vector<uint8_t> stored(stored_size);
+    if (!file.read(reinterpret_cast<char*>(stored.data()), stored_size)) {
+        throw TraceFormatError("Truncated trace block");
+    }
+
+    block = decompress_trace_block(static_cast<TraceCompression>(compression),
+                                   stored.data(), stored.size(), raw_size);
+    position = 0;
+    // delta state doesn't cross block boundaries
+    wavefronts.clear();
+    return true;
+}
+
+uint8_t TraceReader::get_byte() {
+    if (position >= block.size()) {
+        throw TraceFormatError("Trace record crosses block boundary");
+    }
+    return block[position++];
+}
+
+uint64_t TraceReader::get_varint() {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        const uint8_t byte = get_byte();
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+    throw TraceFormatError("Malformed varint in trace");
+}
+
+uint64_t TraceReader::get_u64() {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; ++i) {
+        value |= static_cast<uint64_t>(get_byte()) << (i * 8);
+    }
+    return value;
+}
+
+bool TraceReader::next(TraceEvent& event) {
+    while (position >= block.size()) {
+        if (!read_block()) {
+            return false;
+        }
+    }
+
+    event.type = static_cast<TraceRecord>(get_byte());
+    event.wavefront = get_varint();
+    event.addresses.clear();
+    auto& state = wavefronts[event.wavefront];
+
+    switch (event.type) {
+        case TRACE_WAVE_BEGIN:
+            state = WavefrontState();
+            break;
+        case TRACE_WAVE_END:
+            wavefronts.erase(event.wavefront);
+            return true;
+        case TRACE_EXEC:
+            state.exec = get_u64();
+            break;
+        case TRACE_INSTR:
+            state.pc += unzigzag(get_varint());
+            break;
+        case TRACE_MEM: {
+            const uint64_t count = get_varint();
+            // the writer never stores empty records
+            if (count == 0 || count > block.size() - position) {
+                throw TraceFormatError("Malformed memory record in trace");
+            }
+            event.addresses.resize(count);
+            uint64_t previous = state.address;
+            for (auto& address : event.addresses) {
+                address = previous + unzigzag(get_varint());
+                previous = address;
+            }
+            state.address = event.addresses[0];
+            break;
+        }
+        default:
+            throw TraceFormatError("Unknown trace record " +
+                                   std::to_string(event.type));
+    }
+
+    event.pc = state.pc;
+    event.exec = state.exec;
+    return true;
+}
@@ -0,0 +1,61 @@
+//
+// Created by Diana Kudaiberdieva
+//
+
+#ifndef RED_O_LATOR_TRACE_READER_H
+#define RED_O_LATOR_TRACE_READER_H
+
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "trace_format.h"
+
+struct TraceEvent {
+    TraceRecord type;
+    uint32_t wavefront;
+    // for TRACE_INSTR, TRACE_EXEC
+    uint64_t pc = 0;
+    uint64_t exec = 0;
+    // for TRACE_MEM
+    std::vector<uint64_t> addresses;
+};
+
+/**
+ * Sequential reader of traces written by TraceWriter. EXEC records are
+ * reported as separate events; INSTR events also carry the current EXEC
+ * mask of their wavefront.
+ */
+class TraceReader {
+   public:
+    /**
+     * @throws TraceFormatError if the file could not be opened or is not
+     * a trace
+     */
+    explicit TraceReader(const std::string& path);
+
+    /**
+     * @return false at the end of the trace
+     * @throws TraceFormatError on corrupted data
+     */
+    bool next(TraceEvent& event);
+
+   private:
+    struct WavefrontState {
+        uint64_t pc = 0;
+        uint64_t exec = 0;
+        uint64_t address = 0;
+    };
+
+    std::ifstream file;
+    std::vector<uint8_t> block;
+    size_t position = 0;
+    std::unordered_map<uint32_t, WavefrontState> wavefronts;
+
+    bool read_block();
+    uint8_t get_byte();
+    uint64_t get_varint();
+    uint64_t get_u64();
+};
+
+#endif  // RED_O_LATOR_TRACE_READER_H
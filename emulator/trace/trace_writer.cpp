@@ -0,0 +1,166 @@
+//
+// Created by Diana Kudaiberdieva
+//
+
+#include "trace_writer.h"
+
+static void write_u32(std::ofstream& file, uint32_t value) {
+    uint8_t bytes[4];
+    for (int i = 0; i < 4; ++i) {
+        bytes[i] = static_cast<uint8_t>(value >> (i * 8));
+    }
+    file.write(reinterpret_cast<const char*>(bytes), sizeof(bytes));
+}
+
+TraceWriter::TraceWriter(const std::string& path,
+                         TraceCompression compression,
+                         size_t block_size)
+    : file(path, std::ios::binary),
+      compression(compression),
+      block_size(block_size) {
+    if (!file.is_open()) {
+        throw TraceFormatError("Failed to open " + path);
+    }
+    if (!is_trace_compression_supported(compression)) {
+        throw TraceFormatError("Trace compression " +
+                               std::to_string(compression) +
+                               " is not supported by this build");
+    }
+
+    file.write(kTraceMagic, sizeof(kTraceMagic));
+    write_u32(file, kTraceVersion);
+
+    // some slack so that a record never reallocates the block
+    block.reserve(block_size + 1024);
+    writer = std::thread(&TraceWriter::write_blocks, this);
+}
+
+TraceWriter::~TraceWriter() {
+    close();
+}
+
+void TraceWriter::put_header(TraceRecord record, uint32_t wavefront) {
+    block.push_back(record);
+    put_varint(block, wavefront);
+}
+
+void TraceWriter::begin_wavefront(uint32_t wavefront) {
+    wavefronts[wavefront] = WavefrontState();
+    put_header(TRACE_WAVE_BEGIN, wavefront);
+    end_block_if_full();
+}
+
+void TraceWriter::instruction(uint32_t wavefront, uint64_t pc, uint64_t exec) {
+    auto& state = wavefronts[wavefront];
+
+    if (!state.has_exec || state.exec != exec) {
+        put_header(TRACE_EXEC, wavefront);
+        put_u64(block, exec);
+        state.exec = exec;
+        state.has_exec = true;
+    }
+
+    put_header(TRACE_INSTR, wavefront);
+    put_varint(block, zigzag(static_cast<int64_t>(pc - state.pc)));
+    state.pc = pc;
+
+    end_block_if_full();
+}
+
+void TraceWriter::memory(uint32_t wavefront,
+                         const uint64_t* addresses,
+                         size_t count) {
+    if (count == 0) {
+        return;
+    }
+    auto& state = wavefronts[wavefront];
+
+    put_header(TRACE_MEM, wavefront);
+    put_varint(block, count);
+    uint64_t previous = state.address;
+    for (size_t i = 0; i < count; ++i) {
+        put_varint(block, zigzag(static_cast<int64_t>(addresses[i] - previous)));
+        previous = addresses[i];
+    }
+    state.address = addresses[0];
+
+    end_block_if_full();
+}
+
+void TraceWriter::end_wavefront(uint32_t wavefront) {
+    put_header(TRACE_WAVE_END, wavefront);
+    wavefronts.erase(wavefront);
+    end_block_if_full();
+}
+
+void TraceWriter::end_block_if_full() {
+    if (block.size() >= block_size) {
+        submit_block();
+    }
+}
+
+void TraceWriter::submit_block() {
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [this]() { return !has_pending; });
+        std::swap(block, pending);
+        has_pending = true;
+    }
+    condition.notify_all();
+
+    block.clear();
+    block.reserve(block_size + 1024);
+    // delta state doesn't cross block boundaries
+    for (auto& [id, state] : wavefronts) {
+        state = WavefrontState();
+    }
+}
+
+void TraceWriter::write_blocks() {
+    while (true) {
+        std::vector<uint8_t> raw;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this]() { return has_pending || closing; });
+            if (!has_pending) {
+                return;
+            }
+            raw.swap(pending);
+        }
+
+        const auto compressed = compress_trace_block(compression, raw);
+        const bool is_compressed = !compressed.empty();
+        const auto& stored = is_compressed ? compressed : raw;
+
+        write_u32(file, raw.size());
+        write_u32(file, stored.size());
+        file.put(is_compressed ? compression : TRACE_NO_COMPRESSION);
+        file.write(reinterpret_cast<const char*>(stored.data()), stored.size());
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            // hand the buffer back so the producer reuses its capacity
+            pending.swap(raw);
+            pending.clear();
+            has_pending = false;
+        }
+        condition.notify_all();
+    }
+}
+
+void TraceWriter::close() {
+    if (!writer.joinable()) {
+        return;
+    }
+
+    if (!block.empty()) {
+        submit_block();
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        closing = true;
+    }
+    condition.notify_all();
+    writer.join();
+    file.close();
+}
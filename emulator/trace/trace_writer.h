@@ -0,0 +1,79 @@
+//
+// Created by Diana Kudaiberdieva
+//
+
+#ifndef RED_O_LATOR_TRACE_WRITER_H
+#define RED_O_LATOR_TRACE_WRITER_H
+
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "trace_format.h"
+
+/**
+ * Encodes trace records into the current block while a background thread
+ * compresses and writes the previous one. The producer blocks only if it
+ * fills a block before the previous one is on disk.
+ *
+ * Not thread-safe: use one writer (and file) per emulator thread.
+ */
+class TraceWriter {
+   public:
+    /**
+     * @throws TraceFormatError if the file could not be opened or the
+     * compression is not supported by this build
+     */
+    explicit TraceWriter(const std::string& path,
+                         TraceCompression compression = TRACE_NO_COMPRESSION,
+                         size_t block_size = 1 << 20);
+    ~TraceWriter();
+
+    TraceWriter(const TraceWriter&) = delete;
+    TraceWriter& operator=(const TraceWriter&) = delete;
+
+    void begin_wavefront(uint32_t wavefront);
+
+    void instruction(uint32_t wavefront, uint64_t pc, uint64_t exec);
+
+    void memory(uint32_t wavefront, const uint64_t* addresses, size_t count);
+
+    void end_wavefront(uint32_t wavefront);
+
+    /**
+     * Writes the pending block and waits for the background thread.
+     */
+    void close();
+
+   private:
+    struct WavefrontState {
+        uint64_t pc = 0;
+        uint64_t exec = 0;
+        uint64_t address = 0;
+        bool has_exec = false;
+    };
+
+    std::ofstream file;
+    const TraceCompression compression;
+    const size_t block_size;
+
+    std::vector<uint8_t> block;
+    std::unordered_map<uint32_t, WavefrontState> wavefronts;
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::vector<uint8_t> pending;
+    bool has_pending = false;
+    bool closing = false;
+    std::thread writer;
+
+    void put_header(TraceRecord record, uint32_t wavefront);
+    void end_block_if_full();
+    void submit_block();
+    void write_blocks();
+};
+
+#endif  // RED_O_LATOR_TRACE_WRITER_H
@@ -0,0 +1,45 @@
+//
+// Created by Diana Kudaiberdieva
+//
+
+#include <common/utils/string-utils.hpp>
+#include <fstream>
+
+#include "device_config.h"
+
+DeviceConfig DeviceConfig::load(const std::string& path) {
+    std::ifstream file(path);
+
+    if (!file.is_open()) {
+        throw DeviceConfigLoadError("Failed to open " + path);
+    }
+
+    DeviceConfig config;
+    std::string line;
+
+    while (getline(file, line)) {
+        if (line.empty() || line[0] == '#' || line[0] == ';' ||
+            line.find('=') == std::string::npos) {
+            continue;
+        }
+
+        const auto [name, value] = utils::splitTwo(line, '=');
+        config.parameters[utils::trim(name)] = utils::trim(value);
+    }
+
+    return config;
+}
+
+uint64_t DeviceConfig::get_uint(const std::string& name,
+                                uint64_t default_value) const {
+    const auto it = parameters.find(name);
+    if (it == parameters.end()) {
+        return default_value;
+    }
+
+    try {
+        return std::stoull(it->second, nullptr, 0);
+    } catch (const std::logic_error&) {
+        return default_value;
+    }
+}
@@ -0,0 +1,39 @@
+//
+// Created by Diana Kudaiberdieva
+//
+
+#ifndef RED_O_LATOR_DEVICE_CONFIG_H
+#define RED_O_LATOR_DEVICE_CONFIG_H
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+/**
+ * Raw view of a device .ini file (driver/resources/rx-*.ini). The driver
+ * parses the same file into typed cl_device_info values; the emulator only
+ * needs a handful of numeric hardware parameters out of it.
+ */
+struct DeviceConfig {
+    std::unordered_map<std::string, std::string> parameters;
+
+    /**
+     * @throws DeviceConfigLoadError if the file could not be opened
+     */
+    static DeviceConfig load(const std::string& path);
+
+    /**
+     * @return numeric value of the parameter (decimal or 0x-prefixed hex)
+     * or default_value if the parameter is missing or not a number
+     */
+    uint64_t get_uint(const std::string& name, uint64_t default_value) const;
+};
+
+class DeviceConfigLoadError : public std::runtime_error {
+   public:
+    explicit DeviceConfigLoadError(const std::string& message)
+        : runtime_error(message) {}
+};
+
+#endif  // RED_O_LATOR_DEVICE_CONFIG_H